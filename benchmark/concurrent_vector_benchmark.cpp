@@ -0,0 +1,45 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <mutex>
+#include "vector.hpp"
+#include "concurrent_vector.hpp"
+
+namespace
+{
+    // the shared asd::vector behind a mutex that concurrent_vector replaces
+    struct locked_vector
+    {
+        std::mutex mutex;
+        asd::vector<std::uint64_t> items;
+
+        void push_back(std::uint64_t item)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            items.push_back(item);
+        }
+    };
+
+    template <typename Container>
+    void shared_push_back(benchmark::State &state)
+    {
+        static Container *shared = nullptr;
+        if (state.thread_index() == 0)
+        {
+            shared = new Container();
+        }
+        std::uint64_t item = static_cast<std::uint64_t>(state.thread_index());
+        for (auto _ : state)
+        {
+            shared->push_back(item);
+        }
+        state.SetItemsProcessed(state.iterations());
+        if (state.thread_index() == 0)
+        {
+            delete shared;
+            shared = nullptr;
+        }
+    }
+}
+
+BENCHMARK_TEMPLATE(shared_push_back, locked_vector)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK_TEMPLATE(shared_push_back, asd::concurrent_vector<std::uint64_t>)->ThreadRange(1, 8)->UseRealTime();
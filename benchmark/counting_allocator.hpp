@@ -0,0 +1,107 @@
+#ifndef ASD_COUNTING_ALLOCATOR_2023
+#define ASD_COUNTING_ALLOCATOR_2023
+#include <benchmark/benchmark.h>
+#include <memory>
+#include "vector.hpp"
+#include "mmap_allocator.hpp"
+#include "caching_allocator.hpp"
+#include "segmented_vector.hpp"
+
+namespace asd_benchmark
+{
+    /*
+    allocations done by the benchmarked containers on the current thread
+    */
+    struct allocation_counters
+    {
+        std::size_t allocations = 0; // allocate and reallocate calls
+        std::size_t bytes = 0; // bytes requested by these calls
+
+        static allocation_counters &current() noexcept
+        {
+            thread_local allocation_counters counters;
+            return counters;
+        }
+    };
+
+    /*
+    wraps Base allocator and counts its allocations,
+    the reallocate extension is forwarded only if Base provides it, so asd::vector keeps its realloc path
+    */
+    template <typename T, typename Base>
+    class counting_allocator : public Base
+    {
+    public:
+        using value_type = T;
+
+        template <typename U>
+        struct rebind
+        {
+            using other = counting_allocator<U, typename std::allocator_traits<Base>::template rebind_alloc<U>>;
+        };
+
+        counting_allocator() = default;
+
+        template <typename U, typename OtherBase>
+        counting_allocator(const counting_allocator<U, OtherBase> &other) noexcept
+            : Base(other)
+        {
+        }
+
+        T *allocate(std::size_t n)
+        {
+            allocation_counters &counters = allocation_counters::current();
+            ++counters.allocations;
+            counters.bytes += n * sizeof(T);
+            return std::allocator_traits<Base>::allocate(*this, n);
+        }
+
+        template <typename B = Base, typename = std::enable_if_t<asd::has_reallocate_v<B>>>
+        T *reallocate(T *ptr, std::size_t old_n, std::size_t n)
+        {
+            allocation_counters &counters = allocation_counters::current();
+            ++counters.allocations;
+            counters.bytes += n * sizeof(T);
+            return Base::reallocate(ptr, old_n, n);
+        }
+    };
+
+    /*
+    resets the counters before the benchmark loop, and reports them per iteration after it
+    */
+    class allocation_report
+    {
+        benchmark::State &m_state;
+
+    public:
+        explicit allocation_report(benchmark::State &state) noexcept
+            : m_state(state)
+        {
+            allocation_counters::current() = allocation_counters();
+        }
+
+        ~allocation_report()
+        {
+            const allocation_counters &counters = allocation_counters::current();
+            m_state.counters["allocs"] = benchmark::Counter(static_cast<double>(counters.allocations), benchmark::Counter::kAvgIterations);
+            m_state.counters["alloc_bytes"] = benchmark::Counter(static_cast<double>(counters.bytes), benchmark::Counter::kAvgIterations,
+                                                                 benchmark::Counter::OneK::kIs1024);
+        }
+    };
+
+    template <typename T>
+    using asd_vector = asd::vector<T, counting_allocator<T, asd::allocator<T>>>;
+
+    template <typename T>
+    using std_vector = std::vector<T, counting_allocator<T, std::allocator<T>>>;
+
+    template <typename T>
+    using asd_mmap_vector = asd::vector<T, counting_allocator<T, asd::mmap_allocator<T>>>;
+
+    template <typename T>
+    using asd_cached_vector = asd::vector<T, counting_allocator<T, asd::caching_allocator<T>>>;
+
+    template <typename T>
+    using asd_segmented_vector = asd::segmented_vector<T, asd::page_segment_size<T>(), counting_allocator<T, asd::allocator<T>>>;
+}
+#endif //ifndef ASD_COUNTING_ALLOCATOR_2023
@@ -0,0 +1,106 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+#include "flat_map.hpp"
+
+namespace
+{
+    template <typename Search>
+    using asd_flat_map = asd::flat_map<std::uint32_t, std::uint32_t, std::less<std::uint32_t>, Search>;
+
+    // n random keys with their positions as values
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> random_pairs(std::size_t n)
+    {
+        std::mt19937 random(3);
+        std::vector<std::pair<std::uint32_t, std::uint32_t>> pairs;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            pairs.emplace_back(static_cast<std::uint32_t>(random()), static_cast<std::uint32_t>(i));
+        }
+        return pairs;
+    }
+
+    // 4096 keys picked from the table, so every lookup hits
+    std::vector<std::uint32_t> lookup_keys(const std::vector<std::pair<std::uint32_t, std::uint32_t>> &pairs)
+    {
+        std::mt19937 random(5);
+        std::vector<std::uint32_t> keys;
+        for (std::size_t i = 0; i < 4096; ++i)
+        {
+            keys.push_back(pairs[random() % pairs.size()].first);
+        }
+        return keys;
+    }
+
+    void std_map_find(benchmark::State &state)
+    {
+        std::vector<std::pair<std::uint32_t, std::uint32_t>> pairs = random_pairs(static_cast<std::size_t>(state.range(0)));
+        std::map<std::uint32_t, std::uint32_t> map(pairs.begin(), pairs.end());
+        std::vector<std::uint32_t> keys = lookup_keys(pairs);
+        for (auto _ : state)
+        {
+            std::uint32_t sum = 0;
+            for (std::uint32_t key : keys)
+            {
+                sum += map.find(key)->second;
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(keys.size()));
+    }
+
+    template <typename Search>
+    void flat_map_find(benchmark::State &state)
+    {
+        std::vector<std::pair<std::uint32_t, std::uint32_t>> pairs = random_pairs(static_cast<std::size_t>(state.range(0)));
+        asd_flat_map<Search> map(pairs.begin(), pairs.end());
+        std::vector<std::uint32_t> keys = lookup_keys(pairs);
+        for (auto _ : state)
+        {
+            std::uint32_t sum = 0;
+            for (std::uint32_t key : keys)
+            {
+                sum += map.value(map.find(key));
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(keys.size()));
+    }
+
+    // a table built from unsorted pairs, one insert at a time against one bulk construction
+    void std_map_build(benchmark::State &state)
+    {
+        std::vector<std::pair<std::uint32_t, std::uint32_t>> pairs = random_pairs(static_cast<std::size_t>(state.range(0)));
+        for (auto _ : state)
+        {
+            std::map<std::uint32_t, std::uint32_t> map(pairs.begin(), pairs.end());
+            benchmark::DoNotOptimize(map.size());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void flat_map_build(benchmark::State &state)
+    {
+        std::vector<std::pair<std::uint32_t, std::uint32_t>> pairs = random_pairs(static_cast<std::size_t>(state.range(0)));
+        for (auto _ : state)
+        {
+            asd_flat_map<asd::lookup::branchless> map(pairs.begin(), pairs.end());
+            benchmark::DoNotOptimize(map.size());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+}
+
+// tables from 100 keys, which fit the L1 cache, to 10^6 keys
+#define ASD_TABLE_RANGE RangeMultiplier(10)->Range(100, 1000000)
+
+BENCHMARK(std_map_find)->ASD_TABLE_RANGE;
+BENCHMARK_TEMPLATE(flat_map_find, asd::lookup::binary)->ASD_TABLE_RANGE;
+BENCHMARK_TEMPLATE(flat_map_find, asd::lookup::branchless)->ASD_TABLE_RANGE;
+BENCHMARK_TEMPLATE(flat_map_find, asd::lookup::eytzinger)->ASD_TABLE_RANGE;
+BENCHMARK(std_map_build)->ASD_TABLE_RANGE;
+BENCHMARK(flat_map_build)->ASD_TABLE_RANGE;
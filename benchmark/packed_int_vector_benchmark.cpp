@@ -0,0 +1,133 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <numeric>
+#include <random>
+#include "vector.hpp"
+#include "packed_int_vector.hpp"
+
+namespace
+{
+    // n sorted ids with random gaps below max_gap, like a posting list
+    asd::vector<std::uint64_t> sorted_ids(std::size_t n, std::uint64_t max_gap, std::uint64_t seed)
+    {
+        std::mt19937_64 random(seed);
+        asd::vector<std::uint64_t> ids;
+        ids.resize_uninitialized(n);
+        std::uint64_t id = 0;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            id += 1 + random() % max_gap;
+            ids[i] = id;
+        }
+        return ids;
+    }
+
+    asd::packed_int_vector packed(const asd::vector<std::uint64_t> &ids)
+    {
+        asd::packed_int_vector items;
+        items.append(ids.begin(), ids.end());
+        return items;
+    }
+
+    void set_bytes(benchmark::State &state, std::size_t bytes)
+    {
+        state.counters["bytes"] = static_cast<double>(bytes);
+        state.counters["bits_per_id"] = 8.0 * static_cast<double>(bytes) / static_cast<double>(state.range(0));
+    }
+
+    // state.range(0) ids, state.range(1) the largest gap
+    void vector_scan(benchmark::State &state)
+    {
+        asd::vector<std::uint64_t> ids = sorted_ids(static_cast<std::size_t>(state.range(0)), static_cast<std::uint64_t>(state.range(1)), 1);
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(std::accumulate(ids.begin(), ids.end(), std::uint64_t(0)));
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+        set_bytes(state, ids.size() * sizeof(std::uint64_t));
+    }
+
+    void packed_scan(benchmark::State &state)
+    {
+        asd::packed_int_vector ids = packed(sorted_ids(static_cast<std::size_t>(state.range(0)), static_cast<std::uint64_t>(state.range(1)), 1));
+        asd::vector<std::uint64_t> block;
+        for (auto _ : state)
+        {
+            std::uint64_t sum = 0;
+            asd::packed_int_vector::reader reader(ids);
+            while (reader.next(block))
+            {
+                sum = std::accumulate(block.begin(), block.end(), sum);
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+        set_bytes(state, ids.encoded_bytes());
+    }
+
+    void vector_random_access(benchmark::State &state)
+    {
+        asd::vector<std::uint64_t> ids = sorted_ids(static_cast<std::size_t>(state.range(0)), static_cast<std::uint64_t>(state.range(1)), 1);
+        std::mt19937_64 random(2);
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(ids[random() % ids.size()]);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void packed_random_access(benchmark::State &state)
+    {
+        asd::packed_int_vector ids = packed(sorted_ids(static_cast<std::size_t>(state.range(0)), static_cast<std::uint64_t>(state.range(1)), 1));
+        std::mt19937_64 random(2);
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(ids[random() % ids.size()]);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    // a dense list against a list state.range(2) times sparser
+    void vector_intersect(benchmark::State &state)
+    {
+        std::size_t n = static_cast<std::size_t>(state.range(0));
+        std::uint64_t gap = static_cast<std::uint64_t>(state.range(1));
+        asd::vector<std::uint64_t> ids1 = sorted_ids(n, gap, 3);
+        asd::vector<std::uint64_t> ids2 = sorted_ids(n / static_cast<std::size_t>(state.range(2)), gap * static_cast<std::uint64_t>(state.range(2)), 4);
+        asd::vector<std::uint64_t> common;
+        for (auto _ : state)
+        {
+            common.erase(0, common.size());
+            std::set_intersection(ids1.begin(), ids1.end(), ids2.begin(), ids2.end(), std::back_inserter(common));
+            benchmark::DoNotOptimize(common.data());
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(ids1.size() + ids2.size()));
+    }
+
+    void packed_intersect(benchmark::State &state)
+    {
+        std::size_t n = static_cast<std::size_t>(state.range(0));
+        std::uint64_t gap = static_cast<std::uint64_t>(state.range(1));
+        asd::packed_int_vector ids1 = packed(sorted_ids(n, gap, 3));
+        asd::packed_int_vector ids2 = packed(sorted_ids(n / static_cast<std::size_t>(state.range(2)), gap * static_cast<std::uint64_t>(state.range(2)), 4));
+        asd::vector<std::uint64_t> common;
+        for (auto _ : state)
+        {
+            common.erase(0, common.size());
+            asd::intersect(ids1, ids2, common);
+            benchmark::DoNotOptimize(common.data());
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(ids1.size() + ids2.size()));
+    }
+}
+
+#define ASD_PACKED_ARGS ArgsProduct({{1 << 20}, {4, 64, 4096}})->ArgNames({"n", "gap"})
+
+BENCHMARK(vector_scan)->ASD_PACKED_ARGS;
+BENCHMARK(packed_scan)->ASD_PACKED_ARGS;
+BENCHMARK(vector_random_access)->ASD_PACKED_ARGS;
+BENCHMARK(packed_random_access)->ASD_PACKED_ARGS;
+BENCHMARK(vector_intersect)->ArgsProduct({{1 << 20}, {4}, {1, 64, 4096}})->ArgNames({"n", "gap", "ratio"});
+BENCHMARK(packed_intersect)->ArgsProduct({{1 << 20}, {4}, {1, 64, 4096}})->ArgNames({"n", "gap", "ratio"});
@@ -0,0 +1,101 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include "vector.hpp"
+#include "parallel.hpp"
+
+namespace
+{
+    asd::vector<std::uint32_t> random_items(std::size_t n)
+    {
+        std::mt19937 random(7);
+        asd::vector<std::uint32_t> items;
+        items.resize_uninitialized(n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            items[i] = static_cast<std::uint32_t>(random());
+        }
+        return items;
+    }
+
+    // state.range(0) items, state.range(1) threads, 0 threads is the serial std algorithm
+    void sort(benchmark::State &state)
+    {
+        std::size_t n = static_cast<std::size_t>(state.range(0));
+        asd::parallel::thread_pool pool(static_cast<std::size_t>(std::max<std::int64_t>(state.range(1), 1)));
+        asd::vector<std::uint32_t> source = random_items(n);
+        asd::vector<std::uint32_t> items;
+        items.resize_uninitialized(n);
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            std::copy(source.begin(), source.end(), items.begin());
+            state.ResumeTiming();
+            if (state.range(1) == 0)
+            {
+                std::sort(items.begin(), items.end());
+            }
+            else
+            {
+                asd::parallel::sort(pool, items);
+            }
+            benchmark::DoNotOptimize(items.data());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void reduce(benchmark::State &state)
+    {
+        std::size_t n = static_cast<std::size_t>(state.range(0));
+        asd::parallel::thread_pool pool(static_cast<std::size_t>(std::max<std::int64_t>(state.range(1), 1)));
+        asd::vector<std::uint32_t> items = random_items(n);
+        for (auto _ : state)
+        {
+            std::uint64_t sum;
+            if (state.range(1) == 0)
+            {
+                sum = std::accumulate(items.begin(), items.end(), std::uint64_t(0));
+            }
+            else
+            {
+                sum = asd::parallel::reduce(pool, items, std::uint64_t(0));
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<std::int64_t>(sizeof(std::uint32_t)));
+    }
+
+    // a transform heavy enough to be compute bound, so it scales with the threads instead of the memory bandwidth
+    void transform(benchmark::State &state)
+    {
+        std::size_t n = static_cast<std::size_t>(state.range(0));
+        asd::parallel::thread_pool pool(static_cast<std::size_t>(std::max<std::int64_t>(state.range(1), 1)));
+        asd::vector<std::uint32_t> items = random_items(n);
+        asd::vector<float> output;
+        output.resize_uninitialized(n);
+        auto fn = [](std::uint32_t item) { return std::sqrt(static_cast<float>(item)) * std::log1p(static_cast<float>(item)); };
+        for (auto _ : state)
+        {
+            if (state.range(1) == 0)
+            {
+                std::transform(items.begin(), items.end(), output.begin(), fn);
+            }
+            else
+            {
+                asd::parallel::transform(pool, items, output, fn);
+            }
+            benchmark::DoNotOptimize(output.data());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+}
+
+// the scaling curve of every algorithm: the serial std algorithm, then 1 to 64 threads
+#define ASD_PARALLEL_ARGS ArgsProduct({{1 << 24}, {0, 1, 2, 4, 8, 16, 32, 64}})->ArgNames({"n", "threads"})->UseRealTime()->Unit(benchmark::kMillisecond)
+
+BENCHMARK(sort)->ASD_PARALLEL_ARGS;
+BENCHMARK(reduce)->ASD_PARALLEL_ARGS;
+BENCHMARK(transform)->ASD_PARALLEL_ARGS;
@@ -0,0 +1,250 @@
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <numeric>
+#include "vector.hpp"
+#include "simd.hpp"
+#include "soa_vector.hpp"
+
+namespace
+{
+    const asd::simd::isa all_isas[] = {asd::simd::isa::scalar, asd::simd::isa::sse2, asd::simd::isa::avx2,
+                                       asd::simd::isa::avx512, asd::simd::isa::neon};
+
+    template <typename T>
+    asd::vector<T> make_items(std::size_t n)
+    {
+        asd::vector<T> items;
+        items.reserve(n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            items.push_back(static_cast<T>(i % 101));
+        }
+        return items;
+    }
+
+    /*
+    range(0) is the number of items, range(1) the index of the instruction set in all_isas
+    instruction sets the machine doesn't support are skipped
+    */
+    bool select_isa(benchmark::State &state)
+    {
+        asd::simd::isa set = all_isas[state.range(1)];
+        if (!asd::simd::is_supported(set))
+        {
+            state.SkipWithError("instruction set not supported");
+            return false;
+        }
+        asd::simd::use_isa(set);
+        state.SetLabel(asd::simd::isa_name(set));
+        return true;
+    }
+
+    void report_bytes(benchmark::State &state, std::size_t bytes_per_iteration)
+    {
+        state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * bytes_per_iteration));
+        asd::simd::use_isa(asd::simd::best_isa());
+    }
+
+    template <typename T>
+    void simd_sum(benchmark::State &state)
+    {
+        asd::vector<T> items = make_items<T>(static_cast<std::size_t>(state.range(0)));
+        if (!select_isa(state))
+        {
+            return;
+        }
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(asd::simd::sum(items));
+        }
+        report_bytes(state, items.size() * sizeof(T));
+    }
+
+    template <typename T>
+    void simd_min(benchmark::State &state)
+    {
+        asd::vector<T> items = make_items<T>(static_cast<std::size_t>(state.range(0)));
+        if (!select_isa(state))
+        {
+            return;
+        }
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(asd::simd::min(items));
+        }
+        report_bytes(state, items.size() * sizeof(T));
+    }
+
+    template <typename T>
+    void simd_dot(benchmark::State &state)
+    {
+        asd::vector<T> x = make_items<T>(static_cast<std::size_t>(state.range(0)));
+        asd::vector<T> y = make_items<T>(static_cast<std::size_t>(state.range(0)));
+        if (!select_isa(state))
+        {
+            return;
+        }
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(asd::simd::dot(x, y));
+        }
+        report_bytes(state, 2 * x.size() * sizeof(T));
+    }
+
+    template <typename T>
+    void simd_axpy(benchmark::State &state)
+    {
+        asd::vector<T> x = make_items<T>(static_cast<std::size_t>(state.range(0)));
+        asd::vector<T> y = make_items<T>(static_cast<std::size_t>(state.range(0)));
+        if (!select_isa(state))
+        {
+            return;
+        }
+        for (auto _ : state)
+        {
+            asd::simd::axpy(T(1), x, y);
+            benchmark::ClobberMemory();
+        }
+        report_bytes(state, 3 * x.size() * sizeof(T));
+    }
+
+    template <typename T>
+    void simd_count_if(benchmark::State &state)
+    {
+        asd::vector<T> items = make_items<T>(static_cast<std::size_t>(state.range(0)));
+        if (!select_isa(state))
+        {
+            return;
+        }
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(asd::simd::count_if(items, asd::simd::cmp::less, T(50)));
+        }
+        report_bytes(state, items.size() * sizeof(T));
+    }
+
+    // plain loop baselines over the same storage
+    template <typename T>
+    void loop_sum(benchmark::State &state)
+    {
+        asd::vector<T> items = make_items<T>(static_cast<std::size_t>(state.range(0)));
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(std::accumulate(items.begin(), items.end(), T(0)));
+        }
+        state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * items.size() * sizeof(T)));
+    }
+
+    template <typename T>
+    void loop_dot(benchmark::State &state)
+    {
+        asd::vector<T> x = make_items<T>(static_cast<std::size_t>(state.range(0)));
+        asd::vector<T> y = make_items<T>(static_cast<std::size_t>(state.range(0)));
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(std::inner_product(x.begin(), x.end(), y.begin(), T(0)));
+        }
+        state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * 2 * x.size() * sizeof(T)));
+    }
+
+    void simd_popcount(benchmark::State &state)
+    {
+        asd::vector<std::uint64_t> words = make_items<std::uint64_t>(static_cast<std::size_t>(state.range(0)));
+        if (!select_isa(state))
+        {
+            return;
+        }
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(asd::simd::popcount(words.data(), words.size()));
+        }
+        report_bytes(state, words.size() * sizeof(std::uint64_t));
+    }
+
+    // a sparse bit set, only the last word has a set bit, so every word is scanned
+    void simd_find_nonzero(benchmark::State &state)
+    {
+        asd::vector<std::uint64_t> words;
+        words.resize(static_cast<std::size_t>(state.range(0)));
+        words.back() = 1;
+        if (!select_isa(state))
+        {
+            return;
+        }
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(asd::simd::find_nonzero(words.data(), words.size()));
+        }
+        report_bytes(state, words.size() * sizeof(std::uint64_t));
+    }
+
+    // one field scan over an array of structures against the same field as a soa_vector column
+    struct particle
+    {
+        float x, y, z;
+        float mass;
+        std::int32_t id;
+    };
+
+    void aos_field_sum(benchmark::State &state)
+    {
+        asd::vector<particle> items;
+        for (std::int64_t i = 0; i < state.range(0); ++i)
+        {
+            items.push_back(particle{1.0f, 2.0f, 3.0f, static_cast<float>(i % 101), static_cast<std::int32_t>(i)});
+        }
+        for (auto _ : state)
+        {
+            float total = 0;
+            for (const particle &item : items)
+            {
+                total += item.mass;
+            }
+            benchmark::DoNotOptimize(total);
+        }
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * items.size()));
+    }
+
+    void soa_field_sum(benchmark::State &state)
+    {
+        asd::soa_vector<float, float, float, float, std::int32_t> items;
+        for (std::int64_t i = 0; i < state.range(0); ++i)
+        {
+            items.emplace_back(1.0f, 2.0f, 3.0f, static_cast<float>(i % 101), static_cast<std::int32_t>(i));
+        }
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(asd::simd::sum(items.column<3>()));
+        }
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * items.size()));
+    }
+}
+
+#define ASD_SIMD_ARGS ArgsProduct({{1 << 10, 1 << 16, 1 << 22}, {0, 1, 2, 3, 4}})
+#define ASD_LOOP_ARGS Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 22)
+
+BENCHMARK_TEMPLATE(simd_sum, float)->ASD_SIMD_ARGS;
+BENCHMARK_TEMPLATE(simd_sum, double)->ASD_SIMD_ARGS;
+BENCHMARK_TEMPLATE(simd_sum, std::int32_t)->ASD_SIMD_ARGS;
+BENCHMARK_TEMPLATE(loop_sum, float)->ASD_LOOP_ARGS;
+BENCHMARK_TEMPLATE(loop_sum, std::int32_t)->ASD_LOOP_ARGS;
+
+BENCHMARK_TEMPLATE(simd_min, float)->ASD_SIMD_ARGS;
+BENCHMARK_TEMPLATE(simd_min, std::int32_t)->ASD_SIMD_ARGS;
+
+BENCHMARK_TEMPLATE(simd_dot, float)->ASD_SIMD_ARGS;
+BENCHMARK_TEMPLATE(simd_dot, double)->ASD_SIMD_ARGS;
+BENCHMARK_TEMPLATE(loop_dot, float)->ASD_LOOP_ARGS;
+
+BENCHMARK_TEMPLATE(simd_axpy, float)->ASD_SIMD_ARGS;
+BENCHMARK_TEMPLATE(simd_axpy, std::int32_t)->ASD_SIMD_ARGS;
+
+BENCHMARK_TEMPLATE(simd_count_if, float)->ASD_SIMD_ARGS;
+BENCHMARK_TEMPLATE(simd_count_if, std::int32_t)->ASD_SIMD_ARGS;
+
+BENCHMARK(aos_field_sum)->ASD_LOOP_ARGS;
+BENCHMARK(soa_field_sum)->ASD_LOOP_ARGS;
+
+BENCHMARK(simd_popcount)->ASD_SIMD_ARGS;
+BENCHMARK(simd_find_nonzero)->ASD_SIMD_ARGS;
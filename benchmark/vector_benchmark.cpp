@@ -0,0 +1,201 @@
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "counting_allocator.hpp"
+
+using namespace asd_benchmark;
+
+namespace
+{
+    // 16 bytes record, the typical ingest item
+    struct record
+    {
+        std::uint64_t key;
+        double value;
+    };
+
+    // large trivially copyable item
+    struct large_pod
+    {
+        std::uint64_t words[32];
+    };
+
+    template <typename T>
+    T make_item(std::size_t i)
+    {
+        if constexpr (std::is_same_v<T, std::string>)
+        {
+            // long enough to defeat small string optimization
+            return "benchmark string item number " + std::to_string(i);
+        }
+        else if constexpr (std::is_same_v<T, record>)
+        {
+            return record{i, static_cast<double>(i)};
+        }
+        else if constexpr (std::is_same_v<T, large_pod>)
+        {
+            large_pod item{};
+            item.words[0] = i;
+            return item;
+        }
+        else
+        {
+            return static_cast<T>(i);
+        }
+    }
+
+    template <typename Vec>
+    Vec make_filled(std::size_t n)
+    {
+        Vec result;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            result.push_back(make_item<typename Vec::value_type>(i));
+        }
+        return result;
+    }
+
+    template <typename Vec>
+    void push_back_growth(benchmark::State &state)
+    {
+        using T = typename Vec::value_type;
+        std::size_t n = static_cast<std::size_t>(state.range(0));
+        T item = make_item<T>(1);
+        allocation_report report(state);
+        for (auto _ : state)
+        {
+            Vec vec;
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                vec.push_back(item);
+            }
+            benchmark::DoNotOptimize(&vec[0]);
+        }
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * n));
+    }
+
+    template <typename Vec>
+    void emplace_back_growth(benchmark::State &state)
+    {
+        using T = typename Vec::value_type;
+        std::size_t n = static_cast<std::size_t>(state.range(0));
+        allocation_report report(state);
+        for (auto _ : state)
+        {
+            Vec vec;
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                vec.emplace_back(make_item<T>(i));
+            }
+            benchmark::DoNotOptimize(&vec[0]);
+        }
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * n));
+    }
+
+    template <typename Vec>
+    void copy_construction(benchmark::State &state)
+    {
+        std::size_t n = static_cast<std::size_t>(state.range(0));
+        Vec source = make_filled<Vec>(n);
+        allocation_report report(state);
+        for (auto _ : state)
+        {
+            Vec copy(source);
+            benchmark::DoNotOptimize(&copy[0]);
+        }
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * n));
+    }
+
+    template <typename Vec>
+    void move_construction(benchmark::State &state)
+    {
+        std::size_t n = static_cast<std::size_t>(state.range(0));
+        Vec source = make_filled<Vec>(n);
+        allocation_report report(state);
+        for (auto _ : state)
+        {
+            Vec moved(std::move(source));
+            benchmark::DoNotOptimize(&moved[0]);
+            source = std::move(moved);
+        }
+    }
+
+    template <typename Vec>
+    void copy_assignment(benchmark::State &state)
+    {
+        std::size_t n = static_cast<std::size_t>(state.range(0));
+        Vec source = make_filled<Vec>(n);
+        Vec target;
+        allocation_report report(state);
+        for (auto _ : state)
+        {
+            target = source;
+            benchmark::DoNotOptimize(&target[0]);
+        }
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * n));
+    }
+
+    template <typename Vec>
+    void indexed_iteration(benchmark::State &state)
+    {
+        std::size_t n = static_cast<std::size_t>(state.range(0));
+        Vec vec = make_filled<Vec>(n);
+        allocation_report report(state);
+        for (auto _ : state)
+        {
+            typename Vec::value_type sum{};
+            for (std::size_t i = 0; i < vec.size(); ++i)
+            {
+                sum += vec[i];
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * n));
+    }
+}
+
+// element counts from 10 to 10^8 for small items, up to 10^6 for items that own heap memory or are large
+#define ASD_SMALL_RANGE RangeMultiplier(10)->Range(10, 100000000)->Unit(benchmark::kMicrosecond)
+#define ASD_LARGE_RANGE RangeMultiplier(10)->Range(10, 1000000)->Unit(benchmark::kMicrosecond)
+
+BENCHMARK_TEMPLATE(push_back_growth, asd_vector<int>)->ASD_SMALL_RANGE;
+BENCHMARK_TEMPLATE(push_back_growth, std_vector<int>)->ASD_SMALL_RANGE;
+BENCHMARK_TEMPLATE(push_back_growth, asd_vector<record>)->ASD_SMALL_RANGE;
+BENCHMARK_TEMPLATE(push_back_growth, std_vector<record>)->ASD_SMALL_RANGE;
+BENCHMARK_TEMPLATE(push_back_growth, asd_vector<large_pod>)->ASD_LARGE_RANGE;
+BENCHMARK_TEMPLATE(push_back_growth, std_vector<large_pod>)->ASD_LARGE_RANGE;
+BENCHMARK_TEMPLATE(push_back_growth, asd_mmap_vector<record>)->ASD_SMALL_RANGE;
+BENCHMARK_TEMPLATE(push_back_growth, asd_mmap_vector<large_pod>)->ASD_LARGE_RANGE;
+BENCHMARK_TEMPLATE(push_back_growth, asd_cached_vector<int>)->ASD_SMALL_RANGE;
+BENCHMARK_TEMPLATE(push_back_growth, asd_cached_vector<record>)->ASD_SMALL_RANGE;
+BENCHMARK_TEMPLATE(push_back_growth, asd_segmented_vector<record>)->ASD_SMALL_RANGE;
+BENCHMARK_TEMPLATE(push_back_growth, asd_segmented_vector<large_pod>)->ASD_LARGE_RANGE;
+BENCHMARK_TEMPLATE(push_back_growth, asd_vector<std::string>)->ASD_LARGE_RANGE;
+BENCHMARK_TEMPLATE(push_back_growth, std_vector<std::string>)->ASD_LARGE_RANGE;
+BENCHMARK_TEMPLATE(push_back_growth, asd_cached_vector<std::string>)->ASD_LARGE_RANGE;
+BENCHMARK_TEMPLATE(push_back_growth, asd_segmented_vector<std::string>)->ASD_LARGE_RANGE;
+
+BENCHMARK_TEMPLATE(emplace_back_growth, asd_vector<int>)->ASD_SMALL_RANGE;
+BENCHMARK_TEMPLATE(emplace_back_growth, std_vector<int>)->ASD_SMALL_RANGE;
+BENCHMARK_TEMPLATE(emplace_back_growth, asd_vector<std::string>)->ASD_LARGE_RANGE;
+BENCHMARK_TEMPLATE(emplace_back_growth, std_vector<std::string>)->ASD_LARGE_RANGE;
+
+BENCHMARK_TEMPLATE(copy_construction, asd_vector<int>)->ASD_SMALL_RANGE;
+BENCHMARK_TEMPLATE(copy_construction, std_vector<int>)->ASD_SMALL_RANGE;
+BENCHMARK_TEMPLATE(copy_construction, asd_vector<std::string>)->ASD_LARGE_RANGE;
+BENCHMARK_TEMPLATE(copy_construction, std_vector<std::string>)->ASD_LARGE_RANGE;
+
+BENCHMARK_TEMPLATE(move_construction, asd_vector<int>)->ASD_SMALL_RANGE;
+BENCHMARK_TEMPLATE(move_construction, std_vector<int>)->ASD_SMALL_RANGE;
+
+BENCHMARK_TEMPLATE(copy_assignment, asd_vector<int>)->ASD_SMALL_RANGE;
+BENCHMARK_TEMPLATE(copy_assignment, std_vector<int>)->ASD_SMALL_RANGE;
+BENCHMARK_TEMPLATE(copy_assignment, asd_vector<std::string>)->ASD_LARGE_RANGE;
+BENCHMARK_TEMPLATE(copy_assignment, std_vector<std::string>)->ASD_LARGE_RANGE;
+
+BENCHMARK_TEMPLATE(indexed_iteration, asd_vector<int>)->ASD_SMALL_RANGE;
+BENCHMARK_TEMPLATE(indexed_iteration, std_vector<int>)->ASD_SMALL_RANGE;
+BENCHMARK_TEMPLATE(indexed_iteration, asd_vector<double>)->ASD_SMALL_RANGE;
+BENCHMARK_TEMPLATE(indexed_iteration, std_vector<double>)->ASD_SMALL_RANGE;
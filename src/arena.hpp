@@ -0,0 +1,298 @@
+/*
+ * Copyright (C) 2023 Sofyan Gaber <sofyanhalaby@gmail.com>
+ *
+ * This code is for demonstration and educational purposes. It 
+ * implements a monotonic arena and an allocator that allocates from it.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ASD_ARENA_2023
+#define ASD_ARENA_2023
+#include <stdlib.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+namespace asd
+{
+    /*
+    class asd::arena is a monotonic buffer made of chained memory blocks
+    allocation only bumps a pointer inside the current block, a new block is chained when it runs out of room
+    memory is never released one allocation at a time, reset() makes the whole arena reusable in O(1)
+    and keeps the blocks so the next round doesn't touch the heap
+    it is not thread safe, use one arena per thread / per request
+    */
+    class arena
+    {
+        struct block
+        {
+            block *next; // next block in the chain
+            std::size_t size; // number of usable bytes after the block header
+
+            char *begin() noexcept
+            {
+                return reinterpret_cast<char *>(this + 1);
+            }
+
+            char *end() noexcept
+            {
+                return begin() + size;
+            }
+        };
+
+        block *m_head; // first block of the chain
+        block *m_current; // block the allocations are bumped from
+        char *m_ptr; // first free byte in the current block
+        char *m_end; // end of the current block
+        char *m_last; // start of the last allocation, it can be extended in place
+        std::size_t m_next_block_size; // size of the next block to be allocated, it grows geometrically
+
+        static char *align_up(char *ptr, std::size_t alignment) noexcept
+        {
+            std::uintptr_t address = reinterpret_cast<std::uintptr_t>(ptr);
+            return ptr + ((alignment - address % alignment) % alignment);
+        }
+
+        void set_current(block *current) noexcept
+        {
+            m_current = current;
+            m_ptr = current == nullptr ? nullptr : current->begin();
+            m_end = current == nullptr ? nullptr : current->end();
+            m_last = nullptr;
+        }
+
+        /*
+        moves to the next block of the chain that can fit bytes with alignment,
+        blocks kept from previous rounds are reused before a new block is allocated
+        - thows bad_alloc exception in case of allocation failure
+        */
+        void next_block(std::size_t bytes, std::size_t alignment)
+        {
+            std::size_t needed = bytes + alignment;
+            block *previous = m_current;
+            for (block *candidate = m_current == nullptr ? m_head : m_current->next; candidate != nullptr; candidate = candidate->next)
+            {
+                if (candidate->size >= needed)
+                {
+                    set_current(candidate);
+                    return;
+                }
+                previous = candidate;
+            }
+            while (m_next_block_size < needed)
+            {
+                m_next_block_size *= 2;
+            }
+            block *new_block = static_cast<block *>(std::malloc(sizeof(block) + m_next_block_size));
+            if (new_block == nullptr)
+            {
+                throw std::bad_alloc();
+            }
+            new_block->next = nullptr;
+            new_block->size = m_next_block_size;
+            m_next_block_size *= 2;
+            if (previous == nullptr)
+            {
+                m_head = new_block;
+            }
+            else
+            {
+                previous->next = new_block;
+            }
+            set_current(new_block);
+        }
+
+    public:
+        /*
+        creates an empty arena, first block of initial_block_size bytes is allocated on first use
+        */
+        explicit arena(std::size_t initial_block_size = 4096) noexcept
+            : m_head(nullptr),
+              m_next_block_size(initial_block_size == 0 ? 1 : initial_block_size)
+        {
+            set_current(nullptr);
+        }
+
+        arena(const arena &) = delete;
+        arena &operator=(const arena &) = delete;
+
+        ~arena() noexcept
+        {
+            release();
+        }
+
+        /*
+        allocates bytes of raw memory aligned to alignment, alignment must be a power of two
+        - thows bad_alloc exception in case of allocation failure
+        */
+        void *allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t))
+        {
+            char *ptr = align_up(m_ptr, alignment);
+            // aligning may step past the end of the block, then the block has no room either
+            if (m_ptr == nullptr || ptr > m_end || bytes > static_cast<std::size_t>(m_end - ptr))
+            {
+                next_block(bytes, alignment);
+                ptr = align_up(m_ptr, alignment);
+            }
+            m_ptr = ptr + bytes;
+            m_last = ptr;
+            return ptr;
+        }
+
+        /*
+        resizes the allocation at ptr from old_bytes to bytes, the old content is kept
+        the last allocation is extended in place when the current block has room, shrinking is always in place,
+        otherwise the content is copied
+        ptr may be nullptr with old_bytes 0, then it allocates
+        - thows bad_alloc exception in case of allocation failure
+        */
+        void *reallocate(void *ptr, std::size_t old_bytes, std::size_t bytes, std::size_t alignment = alignof(std::max_align_t))
+        {
+            if (ptr != nullptr && ptr == m_last && bytes <= static_cast<std::size_t>(m_end - m_last))
+            {
+                m_ptr = m_last + bytes;
+                return ptr;
+            }
+            if (bytes <= old_bytes)
+            {
+                return ptr;
+            }
+            void *new_ptr = allocate(bytes, alignment);
+            if (old_bytes != 0)
+            {
+                std::memcpy(new_ptr, ptr, old_bytes < bytes ? old_bytes : bytes);
+            }
+            return new_ptr;
+        }
+
+        /*
+        makes all the memory reusable in O(1), every allocation from this arena becomes invalid
+        the blocks are kept for next allocations
+        */
+        void reset() noexcept
+        {
+            set_current(m_head);
+        }
+
+        /*
+        returns all the blocks to the heap, every allocation from this arena becomes invalid
+        */
+        void release() noexcept
+        {
+            while (m_head != nullptr)
+            {
+                block *next = m_head->next;
+                std::free(m_head);
+                m_head = next;
+            }
+            set_current(nullptr);
+        }
+
+        /*
+        number of bytes owned by the arena blocks
+        */
+        std::size_t capacity() const noexcept
+        {
+            std::size_t total = 0;
+            for (block *current = m_head; current != nullptr; current = current->next)
+            {
+                total += current->size;
+            }
+            return total;
+        }
+    };
+
+    /*
+    class asd::arena_allocator allocates from an asd::arena, it meets the standard Allocator requirements
+    deallocation is a no-op, the memory is reclaimed all at once by arena::reset()
+    the allocator only refers to the arena, so it propagates on copy, move and swap,
+    the arena must outlive every container using it
+    */
+    template <typename T>
+    class arena_allocator
+    {
+        template <typename U>
+        friend class arena_allocator;
+
+        arena *m_arena;
+
+    public:
+        using value_type = T;
+        using propagate_on_container_copy_assignment = std::true_type;
+        using propagate_on_container_move_assignment = std::true_type;
+        using propagate_on_container_swap = std::true_type;
+        using is_always_equal = std::false_type;
+
+        arena_allocator(arena &source) noexcept
+            : m_arena(&source)
+        {
+        }
+
+        template <typename U>
+        arena_allocator(const arena_allocator<U> &other) noexcept
+            : m_arena(other.m_arena)
+        {
+        }
+
+        /*
+        bumps memory that can hold n T items from the arena
+        - thows bad_alloc exception in case of allocation failure 
+        */
+        T *allocate(std::size_t n)
+        {
+            return static_cast<T *>(m_arena->allocate(n * sizeof(T), alignof(T)));
+        }
+
+        /*
+        extends the memory in place if it is the last allocation of the arena, see asd::has_reallocate
+        */
+        T *reallocate(T *ptr, std::size_t old_n, std::size_t n)
+        {
+            return static_cast<T *>(m_arena->reallocate(ptr, old_n * sizeof(T), n * sizeof(T), alignof(T)));
+        }
+
+        /*
+        does nothing, the memory is reclaimed by arena::reset()
+        */
+        void deallocate(T *, std::size_t) noexcept
+        {
+        }
+
+        arena &source() const noexcept
+        {
+            return *m_arena;
+        }
+
+        template <typename U>
+        bool operator==(const arena_allocator<U> &other) const noexcept
+        {
+            return m_arena == other.m_arena;
+        }
+
+        template <typename U>
+        bool operator!=(const arena_allocator<U> &other) const noexcept
+        {
+            return m_arena != other.m_arena;
+        }
+    };
+}
+#endif //ifndef ASD_ARENA_2023
@@ -0,0 +1,74 @@
+
+#include <iostream>
+#include <string>
+#include <algorithm>
+#include <cstdint>
+#include <assert.h>
+#include "vector.hpp"
+#include "arena.hpp"
+
+int main()
+{
+    asd::arena requestArena(256);
+
+    for (int round = 0; round < 3; ++round)
+    {
+        {
+            // Test vectors allocated from the arena
+            asd::vector<int, asd::arena_allocator<int>> myVec1{asd::arena_allocator<int>(requestArena)};
+            for (int i = 0; i < 1000; ++i)
+            {
+                myVec1.push_back(i);
+            }
+            for (int i = 0; i < 1000; ++i)
+            {
+                assert(myVec1[i] == i);
+            }
+
+            // Test non-trivial items, allocator propagates with the container
+            using string_vector = asd::vector<std::string, asd::arena_allocator<std::string>>;
+            string_vector myVec2{asd::arena_allocator<std::string>(requestArena)};
+            for (int i = 0; i < 100; ++i)
+            {
+                myVec2.push_back("arena string that is long enough to go to heap " + std::to_string(i));
+            }
+            string_vector myVec3(myVec2);
+            assert(myVec3.get_allocator() == myVec2.get_allocator());
+            assert(myVec3[99] == myVec2[99]);
+            string_vector myVec4(std::move(myVec3));
+            assert(myVec4.size() == 100 && myVec3.size() == 0);
+
+            // Test last allocation grows in place
+            void *first = requestArena.allocate(16, 16);
+            assert(reinterpret_cast<std::uintptr_t>(first) % 16 == 0);
+            assert(requestArena.reallocate(first, 16, 32, 16) == first);
+        }
+
+        std::size_t capacity = requestArena.capacity();
+        // every container of the round is gone, reclaim their memory at once
+        requestArena.reset();
+        assert(requestArena.capacity() == capacity);
+    }
+
+    // Test an alignment that steps past the end of the block takes a new block
+    {
+        asd::arena smallArena(4096);
+        char *first = static_cast<char *>(smallArena.allocate(4090, 1));
+        char *second = static_cast<char *>(smallArena.allocate(32, 64));
+        assert(reinterpret_cast<std::uintptr_t>(second) % 64 == 0);
+        assert(second + 32 <= first || second >= first + 4090);
+        assert(second + 32 <= first + 4096 || smallArena.capacity() > 4096);
+        std::fill(second, second + 32, 'x');
+        // a page alignment steps past the end whatever address malloc gave the block
+        asd::arena pageArena(4096);
+        char *third = static_cast<char *>(pageArena.allocate(4095, 1));
+        char *fourth = static_cast<char *>(pageArena.allocate(32, 4096));
+        assert(reinterpret_cast<std::uintptr_t>(fourth) % 4096 == 0 && (fourth + 32 <= third || fourth >= third + 4095));
+        assert(pageArena.capacity() > 4096);
+        std::fill(fourth, fourth + 32, 'x');
+    }
+
+    std::cout << "arena examples done" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,608 @@
+/*
+ * Copyright (C) 2023 Sofyan Gaber <sofyanhalaby@gmail.com>
+ *
+ * This code is for demonstration and educational purposes. It
+ * implements a bit packed vector class.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ASD_BIT_VECTOR_2023
+#define ASD_BIT_VECTOR_2023
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include "vector.hpp"
+#include "simd.hpp"
+
+namespace asd
+{
+    namespace detail
+    {
+        inline std::size_t popcount_word(std::uint64_t word) noexcept
+        {
+            return static_cast<std::size_t>(__builtin_popcountll(word));
+        }
+
+        /*
+        position of the k-th set bit of word, k counts from 0 and is less than popcount_word(word)
+        */
+        inline std::size_t select_in_word(std::uint64_t word, std::size_t k) noexcept
+        {
+            for (; k > 0; --k)
+            {
+                word &= word - 1;
+            }
+            return static_cast<std::size_t>(__builtin_ctzll(word));
+        }
+    }
+
+    /*
+    class asd::bit_vector<Alloc, GrowthPolicy> stores one bit per flag in an asd::vector of 64 bit words,
+    8 times less memory than a byte per flag, the allocator and growth policy are the ones of that vector
+    operator[] returns a proxy reference to the bit, the bulk operations work a word at a time,
+    count, rank, select and the find_first / find_next scans run on the asd::simd word kernels
+    (popcnt, and tzcnt over AVX2 / AVX-512 tests that skip a cache line of zero words per step)
+    the bits past size() in the last word are kept zero, so the word kernels never see stale bits
+    */
+    template <typename Alloc = allocator<std::uint64_t>, typename GrowthPolicy = growth::doubling>
+    class bit_vector
+    {
+    public:
+        using word_type = std::uint64_t;
+        using words_type = vector<word_type, Alloc, GrowthPolicy>;
+        static constexpr std::size_t word_bits = 64;
+
+    private:
+        words_type m_words;
+        std::size_t m_count; // number of bits
+
+        static constexpr std::size_t words_for(std::size_t bits) noexcept
+        {
+            return (bits + word_bits - 1) / word_bits;
+        }
+
+        static constexpr word_type bit_mask(std::size_t pos) noexcept
+        {
+            return word_type(1) << (pos % word_bits);
+        }
+
+        /*
+        zeroes the bits past size() in the last word
+        */
+        void clear_tail() noexcept
+        {
+            if (m_count % word_bits != 0)
+            {
+                m_words.back() &= (word_type(1) << (m_count % word_bits)) - 1;
+            }
+        }
+
+        void check_size(const bit_vector &other) const
+        {
+            if (other.m_count != m_count)
+            {
+                throw std::invalid_argument("bit_vector sizes differ");
+            }
+        }
+
+    public:
+        /*
+        proxy of one bit, it converts to bool and assigning a bool changes the bit
+        */
+        class reference
+        {
+            friend class bit_vector;
+
+            word_type *m_word;
+            word_type m_mask;
+
+            reference(word_type *word, word_type mask) noexcept
+                : m_word(word), m_mask(mask)
+            {
+            }
+
+        public:
+            operator bool() const noexcept
+            {
+                return (*m_word & m_mask) != 0;
+            }
+
+            reference &operator=(bool value) noexcept
+            {
+                *m_word = (*m_word & ~m_mask) | ((word_type(0) - static_cast<word_type>(value)) & m_mask);
+                return *this;
+            }
+
+            reference &operator=(const reference &other) noexcept
+            {
+                return *this = static_cast<bool>(other);
+            }
+
+            void flip() noexcept
+            {
+                *m_word ^= m_mask;
+            }
+        };
+
+        bit_vector() noexcept(noexcept(Alloc()))
+            : m_count(0)
+        {
+        }
+
+        explicit bit_vector(const Alloc &alloc) noexcept
+            : m_words(alloc), m_count(0)
+        {
+        }
+
+        bit_vector(const bit_vector &other) = default;
+
+        bit_vector(bit_vector &&other) noexcept
+            : m_words(std::move(other.m_words)), m_count(other.m_count)
+        {
+            other.m_count = 0;
+        }
+
+        bit_vector &operator=(const bit_vector &other) = default;
+
+        bit_vector &operator=(bit_vector &&other) noexcept
+        {
+            if (this != &other)
+            {
+                m_words = std::move(other.m_words);
+                m_count = other.m_count;
+                other.m_count = 0;
+            }
+            return *this;
+        }
+
+        std::size_t size() const noexcept
+        {
+            return m_count;
+        }
+
+        bool empty() const noexcept
+        {
+            return m_count == 0;
+        }
+
+        /*
+        number of bits that fit without growing
+        */
+        std::size_t capacity() const noexcept
+        {
+            return m_words.capacity() * word_bits;
+        }
+
+        /*
+        the words that hold the bits, bit i is bit (i % 64) of word i / 64
+        */
+        const words_type &words() const noexcept
+        {
+            return m_words;
+        }
+
+        const word_type *data() const noexcept
+        {
+            return m_words.data();
+        }
+
+        /*
+        it raises the bad_alloc exception
+        */
+        void push_back(bool value)
+        {
+            if (m_count % word_bits == 0)
+            {
+                m_words.push_back(word_type(0));
+            }
+            m_words.back() |= static_cast<word_type>(value) << (m_count % word_bits);
+            ++m_count;
+        }
+
+        void pop_back() noexcept
+        {
+            --m_count;
+            if (m_count % word_bits == 0)
+            {
+                m_words.pop_back();
+            }
+            else
+            {
+                clear_tail();
+            }
+        }
+
+        reference operator[](std::size_t pos) noexcept
+        {
+            return reference(m_words.data() + pos / word_bits, bit_mask(pos));
+        }
+
+        bool operator[](std::size_t pos) const noexcept
+        {
+            return test(pos);
+        }
+
+        bool test(std::size_t pos) const noexcept
+        {
+            return (m_words[pos / word_bits] & bit_mask(pos)) != 0;
+        }
+
+        void set(std::size_t pos, bool value = true) noexcept
+        {
+            (*this)[pos] = value;
+        }
+
+        void reset(std::size_t pos) noexcept
+        {
+            m_words[pos / word_bits] &= ~bit_mask(pos);
+        }
+
+        void flip(std::size_t pos) noexcept
+        {
+            m_words[pos / word_bits] ^= bit_mask(pos);
+        }
+
+        /*
+        sets every bit
+        */
+        void set() noexcept
+        {
+            std::fill(m_words.begin(), m_words.end(), ~word_type(0));
+            clear_tail();
+        }
+
+        /*
+        clears every bit
+        */
+        void reset() noexcept
+        {
+            std::fill(m_words.begin(), m_words.end(), word_type(0));
+        }
+
+        /*
+        flips every bit
+        */
+        void flip() noexcept
+        {
+            for (word_type &word : m_words)
+            {
+                word = ~word;
+            }
+            clear_tail();
+        }
+
+        /*
+        the bulk operations of two bit vectors of the same size, a word at a time
+        they raise the invalid_argument exception when the sizes differ
+        */
+        bit_vector &operator&=(const bit_vector &other)
+        {
+            check_size(other);
+            for (std::size_t i = 0; i < m_words.size(); i++)
+            {
+                m_words[i] &= other.m_words[i];
+            }
+            return *this;
+        }
+
+        bit_vector &operator|=(const bit_vector &other)
+        {
+            check_size(other);
+            for (std::size_t i = 0; i < m_words.size(); i++)
+            {
+                m_words[i] |= other.m_words[i];
+            }
+            return *this;
+        }
+
+        bit_vector &operator^=(const bit_vector &other)
+        {
+            check_size(other);
+            for (std::size_t i = 0; i < m_words.size(); i++)
+            {
+                m_words[i] ^= other.m_words[i];
+            }
+            return *this;
+        }
+
+        /*
+        clears the bits that are set in other, *this &= ~other
+        */
+        bit_vector &andnot(const bit_vector &other)
+        {
+            check_size(other);
+            for (std::size_t i = 0; i < m_words.size(); i++)
+            {
+                m_words[i] &= ~other.m_words[i];
+            }
+            return *this;
+        }
+
+        /*
+        number of set bits
+        */
+        std::size_t count() const noexcept
+        {
+            return simd::popcount(m_words.data(), m_words.size());
+        }
+
+        bool any() const noexcept
+        {
+            return simd::find_nonzero(m_words.data(), m_words.size()) != m_words.size();
+        }
+
+        bool none() const noexcept
+        {
+            return !any();
+        }
+
+        bool all() const noexcept
+        {
+            return count() == m_count;
+        }
+
+        /*
+        number of set bits before pos, pos may be size()
+        */
+        std::size_t rank(std::size_t pos) const noexcept
+        {
+            std::size_t word = pos / word_bits;
+            std::size_t result = simd::popcount(m_words.data(), word);
+            if (pos % word_bits != 0)
+            {
+                result += detail::popcount_word(m_words[word] & (bit_mask(pos) - 1));
+            }
+            return result;
+        }
+
+        /*
+        position of the k-th set bit, k counts from 0, size() when there are k set bits or less
+        it scans the words, asd::rank_select_index answers it in O(log n)
+        */
+        std::size_t select(std::size_t k) const noexcept
+        {
+            // whole chunks of words are counted by the popcount kernel, then the chunk with the bit word by word
+            constexpr std::size_t chunk = 64;
+            std::size_t i = 0;
+            for (; i + chunk <= m_words.size(); i += chunk)
+            {
+                std::size_t n = simd::popcount(m_words.data() + i, chunk);
+                if (k < n)
+                {
+                    break;
+                }
+                k -= n;
+            }
+            for (; i < m_words.size(); i++)
+            {
+                std::size_t n = detail::popcount_word(m_words[i]);
+                if (k < n)
+                {
+                    return i * word_bits + detail::select_in_word(m_words[i], k);
+                }
+                k -= n;
+            }
+            return m_count;
+        }
+
+        /*
+        position of the first set bit, size() when there is none
+        */
+        std::size_t find_first() const noexcept
+        {
+            std::size_t word = simd::find_nonzero(m_words.data(), m_words.size());
+            if (word == m_words.size())
+            {
+                return m_count;
+            }
+            return word * word_bits + static_cast<std::size_t>(__builtin_ctzll(m_words[word]));
+        }
+
+        /*
+        position of the first set bit after pos, size() when there is none
+        */
+        std::size_t find_next(std::size_t pos) const noexcept
+        {
+            ++pos;
+            if (pos >= m_count)
+            {
+                return m_count;
+            }
+            std::size_t word = pos / word_bits;
+            // the bits of the word before pos are masked out
+            word_type rest = m_words[word] & ~(bit_mask(pos) - 1);
+            if (rest != 0)
+            {
+                return word * word_bits + static_cast<std::size_t>(__builtin_ctzll(rest));
+            }
+            ++word;
+            std::size_t next = word + simd::find_nonzero(m_words.data() + word, m_words.size() - word);
+            if (next == m_words.size())
+            {
+                return m_count;
+            }
+            return next * word_bits + static_cast<std::size_t>(__builtin_ctzll(m_words[next]));
+        }
+
+        /*
+        changes the number of bits to n, the new bits are value
+        it raises the bad_alloc exception
+        */
+        void resize(std::size_t n, bool value = false)
+        {
+            if (n <= m_count)
+            {
+                m_words.resize(words_for(n));
+                m_count = n;
+                clear_tail();
+                return;
+            }
+            if (value && m_count % word_bits != 0)
+            {
+                // the unused bits of the last word become new bits
+                m_words.back() |= ~((word_type(1) << (m_count % word_bits)) - 1);
+            }
+            m_words.resize(words_for(n), value ? ~word_type(0) : word_type(0));
+            m_count = n;
+            clear_tail();
+        }
+
+        void assign(std::size_t n, bool value)
+        {
+            m_words.resize(0);
+            m_count = 0;
+            resize(n, value);
+        }
+
+        /*
+        makes room for n bits
+        it raises the bad_alloc exception
+        */
+        void reserve(std::size_t n)
+        {
+            m_words.reserve(words_for(n));
+        }
+
+        void shrink_to_fit()
+        {
+            m_words.shrink_to_fit();
+        }
+
+        /*
+        bytes the bit_vector takes, see asd::vector::memory_usage
+        */
+        std::size_t memory_usage() const noexcept
+        {
+            return sizeof(*this) - sizeof(m_words) + m_words.memory_usage();
+        }
+
+        void swap(bit_vector &other) noexcept
+        {
+            m_words.swap(other.m_words);
+            std::swap(m_count, other.m_count);
+        }
+
+        friend bool operator==(const bit_vector &a, const bit_vector &b) noexcept
+        {
+            return a.m_count == b.m_count && std::equal(a.m_words.begin(), a.m_words.end(), b.m_words.begin());
+        }
+
+        friend bool operator!=(const bit_vector &a, const bit_vector &b) noexcept
+        {
+            return !(a == b);
+        }
+    };
+
+    /*
+    class asd::rank_select_index answers rank in O(1) and select in O(log n) over the bits of an asd::bit_vector,
+    it keeps the number of set bits before every block of 8 words (512 bits), 1/8 of the memory of the bits
+    it refers to the words of the bit vector, so it has to be rebuilt after the bits change
+    */
+    class rank_select_index
+    {
+        static constexpr std::size_t block_words = 8;
+        static constexpr std::size_t block_bits = block_words * 64;
+
+        const std::uint64_t *m_words;
+        std::size_t m_word_count;
+        std::size_t m_count;
+        // m_ranks[b] is the number of set bits before block b, the last one is the count of all bits
+        vector<std::uint64_t> m_ranks;
+
+    public:
+        /*
+        it raises the bad_alloc exception
+        */
+        template <typename Alloc, typename GrowthPolicy>
+        explicit rank_select_index(const bit_vector<Alloc, GrowthPolicy> &bits)
+            : m_words(bits.data()), m_word_count(bits.words().size()), m_count(bits.size())
+        {
+            std::size_t blocks = (m_word_count + block_words - 1) / block_words;
+            m_ranks.reserve(blocks + 1);
+            std::uint64_t rank = 0;
+            m_ranks.push_back(rank);
+            for (std::size_t b = 0; b < blocks; b++)
+            {
+                std::size_t first = b * block_words;
+                rank += simd::popcount(m_words + first, std::min(block_words, m_word_count - first));
+                m_ranks.push_back(rank);
+            }
+        }
+
+        std::size_t size() const noexcept
+        {
+            return m_count;
+        }
+
+        /*
+        number of set bits
+        */
+        std::size_t count() const noexcept
+        {
+            return static_cast<std::size_t>(m_ranks.back());
+        }
+
+        /*
+        number of set bits before pos, pos may be size()
+        */
+        std::size_t rank(std::size_t pos) const noexcept
+        {
+            std::size_t block = pos / block_bits;
+            std::size_t result = static_cast<std::size_t>(m_ranks[block]);
+            std::size_t word = pos / 64;
+            for (std::size_t i = block * block_words; i < word; i++)
+            {
+                result += detail::popcount_word(m_words[i]);
+            }
+            if (pos % 64 != 0)
+            {
+                result += detail::popcount_word(m_words[word] & ((std::uint64_t(1) << (pos % 64)) - 1));
+            }
+            return result;
+        }
+
+        /*
+        position of the k-th set bit, k counts from 0, size() when there are k set bits or less
+        */
+        std::size_t select(std::size_t k) const noexcept
+        {
+            if (k >= count())
+            {
+                return m_count;
+            }
+            // the last block that starts with k set bits or less before it
+            std::size_t block = static_cast<std::size_t>(std::upper_bound(m_ranks.begin(), m_ranks.end(), std::uint64_t(k)) - m_ranks.begin()) - 1;
+            k -= static_cast<std::size_t>(m_ranks[block]);
+            for (std::size_t i = block * block_words;; i++)
+            {
+                std::size_t n = detail::popcount_word(m_words[i]);
+                if (k < n)
+                {
+                    return i * 64 + detail::select_in_word(m_words[i], k);
+                }
+                k -= n;
+            }
+        }
+    };
+}
+
+#endif //ifndef ASD_BIT_VECTOR_2023
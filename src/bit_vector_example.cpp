@@ -0,0 +1,128 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <stdexcept>
+#include <cstdint>
+#include <assert.h>
+#include "bit_vector.hpp"
+
+int main()
+{
+    // Test push_back and the proxy reference against std::vector<bool>
+    asd::bit_vector<> myBits1;
+    std::vector<bool> stdBits1;
+    std::mt19937 random(17);
+    for (std::size_t i = 0; i < 1000; ++i)
+    {
+        bool bit = random() % 3 == 0;
+        myBits1.push_back(bit);
+        stdBits1.push_back(bit);
+    }
+    assert(myBits1.size() == 1000 && myBits1.words().size() == 16 && myBits1.capacity() >= 1000);
+    assert(myBits1.memory_usage() >= sizeof(myBits1) + 16 * sizeof(std::uint64_t));
+    myBits1[5] = true;
+    stdBits1[5] = true;
+    myBits1[6] = myBits1[5];
+    stdBits1[6] = true;
+    myBits1[7].flip();
+    stdBits1[7].flip();
+    myBits1.set(8, false);
+    stdBits1[8] = false;
+    myBits1.flip(999);
+    stdBits1[999].flip();
+    std::size_t expected = 0;
+    for (std::size_t i = 0; i < 1000; ++i)
+    {
+        assert(myBits1[i] == stdBits1[i] && myBits1.test(i) == stdBits1[i]);
+        expected += stdBits1[i];
+    }
+    assert(myBits1.count() == expected && myBits1.any() && !myBits1.all());
+    myBits1.pop_back();
+    assert(myBits1.size() == 999 && myBits1.count() == expected - stdBits1[999]);
+
+    // Test rank, select and the set bit scans agree with a plain walk over the bits
+    for (std::size_t n : {0, 1, 63, 64, 65, 511, 512, 513, 5000, 100000})
+    {
+        asd::bit_vector<> myBits2;
+        std::vector<std::size_t> positions;
+        std::size_t every = 1 + random() % 300;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            bool bit = random() % every == 0;
+            myBits2.push_back(bit);
+            if (bit)
+            {
+                positions.push_back(i);
+            }
+        }
+        asd::rank_select_index index(myBits2);
+        assert(myBits2.count() == positions.size() && index.count() == positions.size() && index.size() == n);
+        std::size_t k = 0;
+        for (std::size_t i = myBits2.find_first(); i < myBits2.size(); i = myBits2.find_next(i))
+        {
+            assert(i == positions[k]);
+            assert(myBits2.rank(i) == k && index.rank(i) == k && myBits2.rank(i + 1) == k + 1 && index.rank(i + 1) == k + 1);
+            assert(myBits2.select(k) == i && index.select(k) == i);
+            ++k;
+        }
+        assert(k == positions.size() && myBits2.rank(n) == k && index.rank(n) == k);
+        assert(myBits2.select(k) == n && index.select(k) == n);
+    }
+
+    // Test resize keeps the bits past size() clear
+    asd::bit_vector<> myBits3;
+    myBits3.resize(70, true);
+    assert(myBits3.count() == 70 && myBits3.all() && myBits3.words()[1] == 0x3f);
+    myBits3.resize(3);
+    myBits3.resize(130, false);
+    assert(myBits3.count() == 3 && myBits3.find_next(2) == 130);
+    myBits3.resize(200, true);
+    assert(myBits3.count() == 73 && myBits3.find_next(2) == 130 && myBits3.rank(150) == 23);
+    myBits3.flip();
+    assert(myBits3.count() == 127 && myBits3.find_first() == 3);
+    myBits3.set();
+    assert(myBits3.all() && myBits3.count() == 200);
+    myBits3.reset();
+    assert(myBits3.none() && myBits3.find_first() == 200);
+    myBits3.assign(10, true);
+    assert(myBits3.size() == 10 && myBits3.count() == 10);
+
+    // Test the bulk operations
+    asd::bit_vector<> myBits4;
+    asd::bit_vector<> myBits5;
+    for (std::size_t i = 0; i < 300; ++i)
+    {
+        myBits4.push_back(i % 2 == 0);
+        myBits5.push_back(i % 3 == 0);
+    }
+    asd::bit_vector<> myBits6 = myBits4;
+    myBits6 &= myBits5;
+    assert(myBits6.count() == 50 && myBits6.test(6) && !myBits6.test(3));
+    myBits6 = myBits4;
+    myBits6 |= myBits5;
+    assert(myBits6.count() == 200);
+    myBits6 = myBits4;
+    myBits6 ^= myBits5;
+    assert(myBits6.count() == 150);
+    myBits6 = myBits4;
+    myBits6.andnot(myBits5);
+    assert(myBits6.count() == 100 && myBits6.test(2) && !myBits6.test(6));
+    assert(myBits6 != myBits4 && myBits4 == asd::bit_vector<>(myBits4));
+    bool thrown = false;
+    try
+    {
+        myBits6.push_back(true);
+        myBits6 &= myBits5;
+    }
+    catch (const std::invalid_argument &)
+    {
+        thrown = true;
+    }
+    assert(thrown);
+    asd::bit_vector<> myBits7(std::move(myBits6));
+    assert(myBits7.size() == 301 && myBits6.empty());
+
+    std::cout << "bit_vector examples done" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,399 @@
+/*
+ * Copyright (C) 2023 Sofyan Gaber <sofyanhalaby@gmail.com>
+ *
+ * This code is for demonstration and educational purposes. It
+ * implements an allocator that caches freed buffers per thread.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ASD_CACHING_ALLOCATOR_2023
+#define ASD_CACHING_ALLOCATOR_2023
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include "vector.hpp"
+
+namespace asd
+{
+    namespace detail
+    {
+        inline constexpr std::size_t cache_min_shift = 6; // the smallest size class is 64 bytes
+        inline constexpr std::size_t cache_max_shift = 24; // the largest cached size class is 16 MiB
+        inline constexpr std::size_t cache_classes = cache_max_shift - cache_min_shift + 1;
+        inline constexpr std::size_t cache_limit_bytes = std::size_t(1) << 26; // bytes a thread keeps cached at most
+        inline constexpr std::size_t cache_header_bytes = 64; // the header before every buffer, it keeps buffers cache line aligned
+
+        class buffer_cache;
+
+        /*
+        header of a cached block, the buffer follows it at cache_header_bytes
+        */
+        struct cache_block
+        {
+            buffer_cache *owner; // the cache of the thread that allocated the block, nullptr if it is not cached
+            cache_block *next;
+            std::size_t size_class; // cache_classes for blocks too large to cache
+            std::size_t bytes; // bytes of the buffer
+        };
+
+        static_assert(sizeof(cache_block) <= cache_header_bytes);
+
+        /*
+        size class of a buffer of bytes, the smallest power of two that holds it
+        */
+        inline std::size_t cache_class(std::size_t bytes) noexcept
+        {
+            std::size_t size_class = 0;
+            while (size_class < cache_classes && (std::size_t(1) << (size_class + cache_min_shift)) < bytes)
+            {
+                ++size_class;
+            }
+            return size_class;
+        }
+
+        inline std::size_t cache_class_bytes(std::size_t size_class) noexcept
+        {
+            return std::size_t(1) << (size_class + cache_min_shift);
+        }
+
+        inline cache_block *heap_block(buffer_cache *owner, std::size_t size_class, std::size_t bytes)
+        {
+            std::size_t buffer_bytes = size_class < cache_classes ? cache_class_bytes(size_class) : bytes;
+            void *memory = std::aligned_alloc(cache_header_bytes, cache_header_bytes + (buffer_bytes + cache_header_bytes - 1) / cache_header_bytes * cache_header_bytes);
+            if (memory == nullptr)
+            {
+                throw std::bad_alloc();
+            }
+            ASD_INSTRUMENT_ALLOCATE(buffer_bytes);
+            return ::new (memory) cache_block{owner, nullptr, size_class, buffer_bytes};
+        }
+
+        inline void free_block(cache_block *block) noexcept
+        {
+            ASD_INSTRUMENT_DEALLOCATE(block->bytes);
+            std::free(block);
+        }
+
+        /*
+        the freed blocks of one thread, a free list per size class
+        blocks freed by other threads are pushed to a lock free return stack that the owner drains
+        when it misses, a cache outlives its thread and is adopted by the next thread that starts,
+        so the owner of a block always exists
+        */
+        class buffer_cache
+        {
+            cache_block *m_free[cache_classes] = {};
+            std::size_t m_cached_bytes = 0;
+            std::atomic<cache_block *> m_returned{nullptr};
+            buffer_cache *m_next_orphan = nullptr;
+
+            static std::mutex &orphans_lock() noexcept
+            {
+                static std::mutex lock;
+                return lock;
+            }
+
+            static buffer_cache *&orphans() noexcept
+            {
+                static buffer_cache *head = nullptr;
+                return head;
+            }
+
+        public:
+            /*
+            a cache for a starting thread, a cache left by a finished thread if there is one
+            */
+            static buffer_cache *adopt()
+            {
+                std::lock_guard<std::mutex> lock(orphans_lock());
+                buffer_cache *cache = orphans();
+                if (cache == nullptr)
+                {
+                    return new buffer_cache();
+                }
+                orphans() = cache->m_next_orphan;
+                return cache;
+            }
+
+            /*
+            frees the cached blocks of a finishing thread and leaves the cache to the next thread
+            */
+            void orphan() noexcept
+            {
+                drain();
+                for (std::size_t i = 0; i < cache_classes; ++i)
+                {
+                    while (cache_block *block = m_free[i])
+                    {
+                        m_free[i] = block->next;
+                        free_block(block);
+                    }
+                }
+                m_cached_bytes = 0;
+                std::lock_guard<std::mutex> lock(orphans_lock());
+                m_next_orphan = orphans();
+                orphans() = this;
+            }
+
+            /*
+            a cached block of size_class, nullptr if there is none
+            */
+            cache_block *get(std::size_t size_class) noexcept
+            {
+                if (m_free[size_class] == nullptr)
+                {
+                    drain();
+                }
+                cache_block *block = m_free[size_class];
+                if (block != nullptr)
+                {
+                    m_free[size_class] = block->next;
+                    m_cached_bytes -= block->bytes;
+                }
+                return block;
+            }
+
+            /*
+            caches a block of this cache on its own thread, it is freed if the cache is full
+            */
+            void put(cache_block *block) noexcept
+            {
+                if (m_cached_bytes + block->bytes > cache_limit_bytes)
+                {
+                    free_block(block);
+                    return;
+                }
+                block->next = m_free[block->size_class];
+                m_free[block->size_class] = block;
+                m_cached_bytes += block->bytes;
+            }
+
+            /*
+            returns a block of this cache from another thread
+            */
+            void give_back(cache_block *block) noexcept
+            {
+                cache_block *head = m_returned.load(std::memory_order_relaxed);
+                do
+                {
+                    block->next = head;
+                } while (!m_returned.compare_exchange_weak(head, block, std::memory_order_release, std::memory_order_relaxed));
+            }
+
+            /*
+            moves the blocks returned by other threads to the free lists
+            */
+            void drain() noexcept
+            {
+                if (m_returned.load(std::memory_order_relaxed) == nullptr)
+                {
+                    return;
+                }
+                cache_block *block = m_returned.exchange(nullptr, std::memory_order_acquire);
+                while (block != nullptr)
+                {
+                    cache_block *next = block->next;
+                    put(block);
+                    block = next;
+                }
+            }
+
+            std::size_t cached_bytes() const noexcept
+            {
+                return m_cached_bytes;
+            }
+        };
+
+        /*
+        the cache of the current thread, nullptr while the thread is finishing
+        the pointer is trivially destructible so it can be read after the holder is destroyed
+        */
+        struct cache_holder
+        {
+            buffer_cache *cache;
+
+            cache_holder();
+            ~cache_holder();
+        };
+
+        inline thread_local buffer_cache *this_thread_cache = nullptr;
+        inline thread_local bool this_thread_finished = false;
+
+        inline cache_holder::cache_holder()
+            : cache(buffer_cache::adopt())
+        {
+            this_thread_cache = cache;
+        }
+
+        inline cache_holder::~cache_holder()
+        {
+            this_thread_cache = nullptr;
+            this_thread_finished = true;
+            cache->orphan();
+        }
+
+        inline buffer_cache *local_cache()
+        {
+            if (this_thread_cache == nullptr && !this_thread_finished)
+            {
+                static thread_local cache_holder holder;
+            }
+            return this_thread_cache;
+        }
+
+        inline cache_block *block_of(void *ptr) noexcept
+        {
+            return reinterpret_cast<cache_block *>(static_cast<unsigned char *>(ptr) - cache_header_bytes);
+        }
+
+        inline void *buffer_of(cache_block *block) noexcept
+        {
+            return reinterpret_cast<unsigned char *>(block) + cache_header_bytes;
+        }
+    }
+
+    /*
+    class asd::caching_allocator<T> keeps freed buffers in thread local free lists of power of two size classes
+    (64 bytes to 16 MiB), so building and dropping a vector over and over, and every step of its growth,
+    reuses buffers instead of calling malloc and free, a buffer freed by another thread goes back to
+    the thread that allocated it, a thread caches 64 MiB at most and larger buffers are not cached
+    reallocate keeps the buffer while the new size fits its size class
+    buffers are 64 bytes aligned, it is stateless and meets the standard Allocator requirements
+    */
+    template <typename T>
+    class caching_allocator
+    {
+        static_assert(alignof(T) <= detail::cache_header_bytes, "caching_allocator aligns buffers to 64 bytes");
+
+    public:
+        using value_type = T;
+        using is_always_equal = std::true_type;
+
+        static constexpr std::size_t alignment = detail::cache_header_bytes;
+
+        template <typename U>
+        struct rebind
+        {
+            using other = caching_allocator<U>;
+        };
+
+        caching_allocator() = default;
+
+        template <typename U>
+        caching_allocator(const caching_allocator<U> &) noexcept
+        {
+        }
+
+        /*
+        bytes of the buffer allocate(n) returns, n items rounded up to their size class
+        */
+        static std::size_t buffer_bytes(std::size_t n) noexcept
+        {
+            std::size_t size_class = detail::cache_class(n * sizeof(T));
+            return size_class < detail::cache_classes ? detail::cache_class_bytes(size_class) : n * sizeof(T);
+        }
+
+        /*
+        bytes the current thread keeps cached
+        */
+        static std::size_t cached_bytes()
+        {
+            detail::buffer_cache *cache = detail::local_cache();
+            return cache == nullptr ? 0 : cache->cached_bytes();
+        }
+
+        /*
+        raw memory for n items from the cache of the current thread, from the heap if it is empty
+        - thows bad_alloc exception in case of allocation failure
+        */
+        T *allocate(std::size_t n)
+        {
+            std::size_t size_class = detail::cache_class(n * sizeof(T));
+            detail::buffer_cache *cache = size_class < detail::cache_classes ? detail::local_cache() : nullptr;
+            detail::cache_block *block = cache == nullptr ? nullptr : cache->get(size_class);
+            if (block == nullptr)
+            {
+                block = detail::heap_block(cache, size_class, n * sizeof(T));
+            }
+            return static_cast<T *>(detail::buffer_of(block));
+        }
+
+        /*
+        resizes the buffer to n items, the first min(old_n, n) items are kept bitwise,
+        the buffer doesn't change while n fits its size class
+        ptr may be nullptr with old_n 0, then it allocates
+        - thows bad_alloc exception in case of allocation failure, ptr stays valid in this case
+        */
+        T *reallocate(T *ptr, std::size_t old_n, std::size_t n)
+        {
+            if (ptr == nullptr)
+            {
+                return allocate(n);
+            }
+            detail::cache_block *block = detail::block_of(ptr);
+            if (block->size_class < detail::cache_classes && detail::cache_class(n * sizeof(T)) == block->size_class)
+            {
+                return ptr;
+            }
+            T *new_ptr = allocate(n);
+            std::memcpy(static_cast<void *>(new_ptr), static_cast<const void *>(ptr), (old_n < n ? old_n : n) * sizeof(T));
+            deallocate(ptr, old_n);
+            return new_ptr;
+        }
+
+        /*
+        returns the buffer to the cache of the thread that allocated it
+        */
+        void deallocate(T *ptr, std::size_t n) noexcept
+        {
+            (void)n;
+            detail::cache_block *block = detail::block_of(ptr);
+            if (block->owner == nullptr)
+            {
+                detail::free_block(block);
+            }
+            else if (block->owner == detail::this_thread_cache)
+            {
+                block->owner->put(block);
+            }
+            else
+            {
+                block->owner->give_back(block);
+            }
+        }
+    };
+
+    template <typename T, typename U>
+    bool operator==(const caching_allocator<T> &, const caching_allocator<U> &) noexcept
+    {
+        return true;
+    }
+
+    template <typename T, typename U>
+    bool operator!=(const caching_allocator<T> &, const caching_allocator<U> &) noexcept
+    {
+        return false;
+    }
+}
+#endif //ifndef ASD_CACHING_ALLOCATOR_2023
@@ -0,0 +1,85 @@
+
+// instrumentation must be enabled for the whole program, before including any asd header
+#define ASD_VECTOR_INSTRUMENTATION
+#include <iostream>
+#include <string>
+#include <thread>
+#include <cstdint>
+#include <assert.h>
+#include "vector.hpp"
+#include "caching_allocator.hpp"
+
+template <typename T>
+using cached_vector = asd::vector<T, asd::caching_allocator<T>>;
+
+int main()
+{
+    // Test building and dropping a vector reuses the buffers of every growth step
+    for (int round = 0; round < 100; ++round)
+    {
+        asd::instrumentation::scoped_tag tag(round == 0 ? "first round" : "next rounds");
+        cached_vector<int> myVec1;
+        for (int i = 0; i < 10000; ++i)
+        {
+            myVec1.push_back(i);
+        }
+        assert(myVec1[9999] == 9999 && reinterpret_cast<std::uintptr_t>(myVec1.data()) % 64 == 0);
+        cached_vector<std::string> myVec2;
+        for (int i = 0; i < 100; ++i)
+        {
+            myVec2.push_back(std::to_string(i));
+        }
+        assert(myVec2[99] == "99");
+    }
+    assert(asd::instrumentation::snapshot("first round").allocations > 0);
+    assert(asd::instrumentation::snapshot("next rounds").allocations == 0);
+    assert(asd::caching_allocator<int>::cached_bytes() > 0 && asd::caching_allocator<int>::cached_bytes() <= (1 << 26));
+
+    // Test reallocate keeps the buffer inside its size class
+    asd::caching_allocator<char> allocator1;
+    static_assert(decltype(allocator1)::alignment == 64);
+    assert(allocator1.buffer_bytes(1) == 64 && allocator1.buffer_bytes(100) == 128 && allocator1.buffer_bytes(128) == 128);
+    char *ptr1 = allocator1.allocate(100);
+    ptr1[99] = 'x';
+    assert(allocator1.reallocate(ptr1, 100, 120) == ptr1);
+    char *ptr2 = allocator1.reallocate(ptr1, 120, 129);
+    assert(ptr2[99] == 'x');
+    allocator1.deallocate(ptr2, 129);
+    assert(allocator1.allocate(200) == ptr2);
+    allocator1.deallocate(ptr2, 200);
+
+    // Test a buffer freed by another thread goes back to the thread that allocated it
+    asd::caching_allocator<double> allocator2;
+    double *ptr3 = allocator2.allocate(1000);
+    std::thread other([&] { allocator2.deallocate(ptr3, 1000); });
+    other.join();
+    assert(allocator2.allocate(1000) == ptr3);
+    double *ptr4 = nullptr;
+    std::thread finished([&] {
+        ptr4 = allocator2.allocate(5000);
+        cached_vector<int> myVec3;
+        myVec3.resize(100);
+    });
+    finished.join();
+    allocator2.deallocate(ptr4, 5000);
+    allocator2.deallocate(ptr3, 1000);
+
+    // Test large buffers are not cached and the cache is bounded
+    {
+        asd::instrumentation::scoped_tag tag("large");
+        cached_vector<char> myVec4;
+        for (int i = 0; i < 8; ++i)
+        {
+            cached_vector<char> myVec5;
+            myVec5.resize_uninitialized(std::size_t(1) << 24);
+            myVec4.resize_uninitialized(std::size_t(1) << 25);
+        }
+        assert(asd::caching_allocator<char>::cached_bytes() <= (1 << 26));
+    }
+    asd::instrumentation::stats large = asd::instrumentation::snapshot("large");
+    assert(large.allocations == 2 && large.deallocations == 1);
+
+    std::cout << "caching_allocator examples done" << std::endl;
+
+    return 0;
+}
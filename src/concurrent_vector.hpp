@@ -0,0 +1,474 @@
+/*
+ * Copyright (C) 2023 Sofyan Gaber <sofyanhalaby@gmail.com>
+ *
+ * This code is for demonstration and educational purposes. It
+ * implements a vector class that many threads can append to at once.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ASD_CONCURRENT_VECTOR_2023
+#define ASD_CONCURRENT_VECTOR_2023
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "vector.hpp"
+
+namespace asd
+{
+    /*
+    class asd::concurrent_vector<T, Alloc, FirstSegment> can be appended to by many threads without a lock
+    the items live in segments of FirstSegment, 2 * FirstSegment, 4 * FirstSegment, ... items
+    allocated on demand, so an item never moves and references to it stay valid until the container dies
+    - push_back / emplace_back / grow_by reserve their slots by one atomic add, they are lock free
+    - operator[] reads the segment table and the item, it is wait free
+    - size() counts reserved slots, an item is published to another thread by whatever tells that thread
+      its index (a queue, a join, ...) or by holds_item(), the container doesn't order the items by completion
+    - a slot whose constructor or segment allocation threw holds no item, holds_item() tells and iterators skip it
+    clear() and destruction need no other thread to use the container at the same time
+    */
+    template <typename T, typename Alloc = allocator<T>, std::size_t FirstSegment = 32>
+    class concurrent_vector
+    {
+        static_assert(FirstSegment > 0 && (FirstSegment & (FirstSegment - 1)) == 0, "FirstSegment must be a power of two");
+
+        using alloc_traits = std::allocator_traits<Alloc>;
+        using word = std::atomic<std::uint64_t>;
+        using word_allocator = typename alloc_traits::template rebind_alloc<word>;
+        using word_traits = std::allocator_traits<word_allocator>;
+        static constexpr std::size_t max_segments = sizeof(std::size_t) * 8;
+        static constexpr std::size_t word_bits = 64;
+
+        std::atomic<T *> m_segments[max_segments];
+        std::atomic<word *> m_ready[max_segments]; // a bit per slot of the segment, set once its item is constructed
+        std::atomic<std::size_t> m_count;
+        ASD_NO_UNIQUE_ADDRESS Alloc m_allocator;
+
+        static std::size_t log2(std::size_t n) noexcept
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return sizeof(unsigned long long) * 8 - 1 - static_cast<std::size_t>(__builtin_clzll(n));
+#else
+            std::size_t result = 0;
+            while (n >>= 1)
+            {
+                ++result;
+            }
+            return result;
+#endif
+        }
+
+        static std::size_t segment_of(std::size_t i) noexcept
+        {
+            return log2(i / FirstSegment + 1);
+        }
+
+        static std::size_t segment_begin(std::size_t segment) noexcept
+        {
+            return FirstSegment * ((std::size_t(1) << segment) - 1);
+        }
+
+        static std::size_t segment_size(std::size_t segment) noexcept
+        {
+            return FirstSegment << segment;
+        }
+
+        static std::size_t segment_words(std::size_t segment) noexcept
+        {
+            return (segment_size(segment) + word_bits - 1) / word_bits;
+        }
+
+        /*
+        the segment, allocated by this thread if no other thread did it first
+        */
+        T *acquire_segment(std::size_t segment)
+        {
+            T *ptr = m_segments[segment].load(std::memory_order_acquire);
+            if (ptr != nullptr)
+            {
+                return ptr;
+            }
+            T *fresh = alloc_traits::allocate(m_allocator, segment_size(segment));
+            if (m_segments[segment].compare_exchange_strong(ptr, fresh, std::memory_order_acq_rel, std::memory_order_acquire))
+            {
+                return fresh;
+            }
+            // another thread installed it first
+            alloc_traits::deallocate(m_allocator, fresh, segment_size(segment));
+            return ptr;
+        }
+
+        /*
+        the ready bits of the segment, installed the same way as the segment
+        */
+        word *acquire_ready(std::size_t segment)
+        {
+            word *ptr = m_ready[segment].load(std::memory_order_acquire);
+            if (ptr != nullptr)
+            {
+                return ptr;
+            }
+            word_allocator alloc(m_allocator);
+            word *fresh = word_traits::allocate(alloc, segment_words(segment));
+            for (std::size_t k = 0; k < segment_words(segment); ++k)
+            {
+                ::new (static_cast<void *>(fresh + k)) word(0);
+            }
+            if (m_ready[segment].compare_exchange_strong(ptr, fresh, std::memory_order_acq_rel, std::memory_order_acquire))
+            {
+                return fresh;
+            }
+            word_traits::deallocate(alloc, fresh, segment_words(segment));
+            return ptr;
+        }
+
+        /*
+        constructs the item of slot i and sets its ready bit, the release publishes it to holds_item()
+        a slot whose allocation or constructor throws keeps its bit clear
+        */
+        template <typename... Args>
+        void construct_at(std::size_t i, Args &&...args)
+        {
+            std::size_t segment = segment_of(i);
+            std::size_t offset = i - segment_begin(segment);
+            word *ready = acquire_ready(segment);
+            alloc_traits::construct(m_allocator, acquire_segment(segment) + offset, std::forward<Args>(args)...);
+            ready[offset / word_bits].fetch_or(std::uint64_t(1) << (offset % word_bits), std::memory_order_release);
+        }
+
+        /*
+        constructs the slots [first, last) from args, when one throws the rest of the slots hold no item
+        */
+        template <typename... Args>
+        void construct_range(std::size_t first, std::size_t last, const Args &...args)
+        {
+            for (std::size_t i = first; i < last; ++i)
+            {
+                construct_at(i, args...);
+            }
+        }
+
+        void destroy() noexcept
+        {
+            word_allocator alloc(m_allocator);
+            for (std::size_t segment = 0; segment < max_segments; ++segment)
+            {
+                T *ptr = m_segments[segment].load(std::memory_order_acquire);
+                word *ready = m_ready[segment].load(std::memory_order_acquire);
+                if constexpr (!std::is_trivially_destructible_v<T>)
+                {
+                    for (std::size_t k = 0; ready != nullptr && k < segment_words(segment); ++k)
+                    {
+                        for (std::uint64_t bits = ready[k].load(std::memory_order_relaxed); bits != 0; bits &= bits - 1)
+                        {
+                            std::size_t bit = 0;
+                            while (((bits >> bit) & 1) == 0)
+                            {
+                                ++bit;
+                            }
+                            alloc_traits::destroy(m_allocator, ptr + k * word_bits + bit);
+                        }
+                    }
+                }
+                if (ptr != nullptr)
+                {
+                    alloc_traits::deallocate(m_allocator, ptr, segment_size(segment));
+                    m_segments[segment].store(nullptr, std::memory_order_relaxed);
+                }
+                if (ready != nullptr)
+                {
+                    word_traits::deallocate(alloc, ready, segment_words(segment));
+                    m_ready[segment].store(nullptr, std::memory_order_relaxed);
+                }
+            }
+            m_count.store(0, std::memory_order_relaxed);
+        }
+
+    public:
+        using value_type = T;
+        using allocator_type = Alloc;
+
+        /*
+        forward iterator over the slots that hold an item, it walks up to size() at the time it is advanced
+        */
+        template <typename Container, typename Value>
+        class basic_iterator
+        {
+            static constexpr std::size_t past_end = static_cast<std::size_t>(-1);
+
+            Container *m_container;
+            std::size_t m_index;
+
+            void skip() noexcept
+            {
+                std::size_t count = m_container->size();
+                while (m_index < count && !m_container->holds_item(m_index))
+                {
+                    ++m_index;
+                }
+                if (m_index >= count)
+                {
+                    m_index = past_end;
+                }
+            }
+
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = std::remove_const_t<Value>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = Value *;
+            using reference = Value &;
+
+            basic_iterator() noexcept
+                : m_container(nullptr), m_index(past_end)
+            {
+            }
+
+            /*
+            the first slot from index on that holds an item, or the end
+            */
+            basic_iterator(Container *container, std::size_t index) noexcept
+                : m_container(container), m_index(index)
+            {
+                if (index != past_end)
+                {
+                    skip();
+                }
+            }
+
+            reference operator*() const noexcept
+            {
+                return (*m_container)[m_index];
+            }
+
+            pointer operator->() const noexcept
+            {
+                return &(*m_container)[m_index];
+            }
+
+            basic_iterator &operator++() noexcept
+            {
+                ++m_index;
+                skip();
+                return *this;
+            }
+
+            basic_iterator operator++(int) noexcept
+            {
+                basic_iterator result = *this;
+                ++*this;
+                return result;
+            }
+
+            bool operator==(const basic_iterator &other) const noexcept
+            {
+                return m_index == other.m_index;
+            }
+
+            bool operator!=(const basic_iterator &other) const noexcept
+            {
+                return m_index != other.m_index;
+            }
+
+            friend class concurrent_vector;
+        };
+
+        using iterator = basic_iterator<concurrent_vector, T>;
+        using const_iterator = basic_iterator<const concurrent_vector, const T>;
+
+        concurrent_vector() noexcept(noexcept(Alloc()))
+            : concurrent_vector(Alloc())
+        {
+        }
+
+        explicit concurrent_vector(const Alloc &alloc) noexcept
+            : m_segments{}, m_ready{}, m_count(0), m_allocator(alloc)
+        {
+        }
+
+        concurrent_vector(const concurrent_vector &) = delete;
+        concurrent_vector &operator=(const concurrent_vector &) = delete;
+
+        ~concurrent_vector()
+        {
+            destroy();
+        }
+
+        allocator_type get_allocator() const noexcept
+        {
+            return m_allocator;
+        }
+
+        /*
+        adds a copy of item and returns its index, it is safe to call from many threads at once
+        it raises the bad_alloc exception, or what the item constructor throws, the slot then holds no item
+        */
+        template <class U>
+        std::size_t push_back(U &&item)
+        {
+            std::size_t i = m_count.fetch_add(1, std::memory_order_relaxed);
+            construct_at(i, std::forward<U>(item));
+            return i;
+        }
+
+        /*
+        adds an item made from args and returns its index, it is safe to call from many threads at once
+        */
+        template <typename... Args>
+        std::size_t emplace_back(Args &&...args)
+        {
+            std::size_t i = m_count.fetch_add(1, std::memory_order_relaxed);
+            construct_at(i, std::forward<Args>(args)...);
+            return i;
+        }
+
+        /*
+        reserves n consecutive slots at once, value initializes them and returns the index of the first one
+        threads appending in batches pay one atomic add per batch
+        when a constructor throws, the slots from it to the end of the batch stay reserved but hold no item
+        */
+        std::size_t grow_by(std::size_t n)
+        {
+            std::size_t first = m_count.fetch_add(n, std::memory_order_relaxed);
+            construct_range(first, first + n);
+            return first;
+        }
+
+        /*
+        same as grow_by(n) but the items are copies of value
+        */
+        std::size_t grow_by(std::size_t n, const T &value)
+        {
+            std::size_t first = m_count.fetch_add(n, std::memory_order_relaxed);
+            construct_range(first, first + n, value);
+            return first;
+        }
+
+        /*
+        allocates the segments that hold the first n items in advance
+        */
+        void reserve(std::size_t n)
+        {
+            for (std::size_t segment = 0; n > 0 && segment <= segment_of(n - 1); ++segment)
+            {
+                acquire_segment(segment);
+            }
+        }
+
+        /*
+        tells whether slot i holds a constructed item, false for a slot still under construction and for a slot
+        whose constructor or segment allocation threw, true also publishes the item to this thread
+        */
+        bool holds_item(std::size_t i) const noexcept
+        {
+            std::size_t segment = segment_of(i);
+            std::size_t offset = i - segment_begin(segment);
+            const word *ready = m_ready[segment].load(std::memory_order_acquire);
+            return ready != nullptr && ((ready[offset / word_bits].load(std::memory_order_acquire) >> (offset % word_bits)) & 1) != 0;
+        }
+
+        /*
+        the item at index i, the item has to be published to this thread and its slot must hold an item
+        */
+        T &operator[](std::size_t i) noexcept
+        {
+            std::size_t segment = segment_of(i);
+            return m_segments[segment].load(std::memory_order_acquire)[i - segment_begin(segment)];
+        }
+
+        const T &operator[](std::size_t i) const noexcept
+        {
+            std::size_t segment = segment_of(i);
+            return m_segments[segment].load(std::memory_order_acquire)[i - segment_begin(segment)];
+        }
+
+        /*
+        number of reserved slots, some of them may still be under construction by other threads
+        */
+        std::size_t size() const noexcept
+        {
+            return m_count.load(std::memory_order_acquire);
+        }
+
+        bool empty() const noexcept
+        {
+            return size() == 0;
+        }
+
+        /*
+        number of items the allocated segments can hold without allocating
+        */
+        std::size_t capacity() const noexcept
+        {
+            std::size_t result = 0;
+            for (std::size_t segment = 0; segment < max_segments; ++segment)
+            {
+                if (m_segments[segment].load(std::memory_order_acquire) != nullptr)
+                {
+                    result += segment_size(segment);
+                }
+            }
+            return result;
+        }
+
+        /*
+        destroys the items and releases the segments, no other thread may use the container meanwhile
+        */
+        void clear() noexcept
+        {
+            destroy();
+        }
+
+        iterator begin() noexcept
+        {
+            return iterator(this, 0);
+        }
+
+        const_iterator begin() const noexcept
+        {
+            return const_iterator(this, 0);
+        }
+
+        iterator end() noexcept
+        {
+            return iterator(this, iterator::past_end);
+        }
+
+        const_iterator end() const noexcept
+        {
+            return const_iterator(this, const_iterator::past_end);
+        }
+
+        const_iterator cbegin() const noexcept
+        {
+            return begin();
+        }
+
+        const_iterator cend() const noexcept
+        {
+            return end();
+        }
+    };
+}
+#endif //ifndef ASD_CONCURRENT_VECTOR_2023
@@ -0,0 +1,228 @@
+
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <assert.h>
+#include "concurrent_vector.hpp"
+
+struct fragile
+{
+    int value;
+
+    explicit fragile(int v)
+        : value(v)
+    {
+        if (v < 0)
+        {
+            throw std::invalid_argument("negative");
+        }
+    }
+};
+
+// counts the live items, a copy throws once copiesLeft runs out
+struct tracked
+{
+    static int live;
+    static int copiesLeft;
+
+    tracked()
+    {
+        ++live;
+    }
+
+    tracked(const tracked &)
+    {
+        if (copiesLeft-- == 0)
+        {
+            throw std::runtime_error("copy failed");
+        }
+        ++live;
+    }
+
+    ~tracked()
+    {
+        --live;
+    }
+};
+
+int tracked::live = 0;
+int tracked::copiesLeft = 0;
+
+// an allocator that fails while failAllocations is set
+bool failAllocations = false;
+
+template <typename T>
+struct flaky_allocator
+{
+    using value_type = T;
+
+    flaky_allocator() = default;
+
+    template <typename U>
+    flaky_allocator(const flaky_allocator<U> &) noexcept
+    {
+    }
+
+    T *allocate(std::size_t n)
+    {
+        if (failAllocations)
+        {
+            throw std::bad_alloc();
+        }
+        return static_cast<T *>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T *ptr, std::size_t) noexcept
+    {
+        ::operator delete(ptr);
+    }
+
+    template <typename U>
+    bool operator==(const flaky_allocator<U> &) const noexcept
+    {
+        return true;
+    }
+
+    template <typename U>
+    bool operator!=(const flaky_allocator<U> &) const noexcept
+    {
+        return false;
+    }
+};
+
+int main()
+{
+    // Test many producers appending at once
+    asd::concurrent_vector<std::string> myVec1;
+    const int producers = 4;
+    const int itemsPerProducer = 10000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < producers; ++t)
+    {
+        threads.emplace_back([&myVec1, t]() {
+            for (int i = 0; i < itemsPerProducer; ++i)
+            {
+                std::size_t index = myVec1.push_back("concurrent string long enough to go to heap " + std::to_string(t * itemsPerProducer + i));
+                assert(&myVec1[index] != nullptr);
+            }
+        });
+    }
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+    assert(myVec1.size() == producers * itemsPerProducer);
+    std::vector<int> seen;
+    for (const std::string &item : myVec1)
+    {
+        seen.push_back(std::stoi(item.substr(item.rfind(' ') + 1)));
+    }
+    std::sort(seen.begin(), seen.end());
+    for (int i = 0; i < producers * itemsPerProducer; ++i)
+    {
+        assert(seen[i] == i);
+    }
+
+    // Test references stay valid while the container grows
+    asd::concurrent_vector<int, asd::allocator<int>, 4> myVec2;
+    std::size_t first = myVec2.emplace_back(42);
+    int *firstItem = &myVec2[first];
+    for (int i = 0; i < 10000; ++i)
+    {
+        myVec2.push_back(i);
+    }
+    assert(firstItem == &myVec2[0] && *firstItem == 42 && myVec2[10000] == 9999);
+
+    // Test batch reservation
+    std::size_t batch = myVec2.grow_by(100, 7);
+    assert(batch == 10001 && myVec2.size() == 10101 && myVec2[10100] == 7);
+    batch = myVec2.grow_by(10);
+    assert(myVec2[batch + 9] == 0);
+    myVec2.clear();
+    assert(myVec2.empty() && myVec2.capacity() == 0);
+    myVec2.reserve(100);
+    assert(myVec2.capacity() >= 100);
+
+    // Test a throwing constructor leaves the other items intact
+    asd::concurrent_vector<fragile> myVec3;
+    myVec3.emplace_back(1);
+    bool thrown = false;
+    try
+    {
+        myVec3.emplace_back(-1);
+    }
+    catch (const std::invalid_argument &)
+    {
+        thrown = true;
+    }
+    std::size_t last = myVec3.emplace_back(3);
+    assert(thrown && last == 2 && myVec3[2].value == 3);
+    assert(myVec3.holds_item(0) && !myVec3.holds_item(1) && myVec3.holds_item(2));
+    int total = 0;
+    for (const fragile &item : myVec3)
+    {
+        total += item.value;
+    }
+    assert(total == 4 && std::distance(myVec3.begin(), myVec3.end()) == 2);
+
+    // Test a batch that throws halfway fails the rest of its slots, they are never destroyed
+    {
+        tracked prototype;
+        asd::concurrent_vector<tracked> myVec4;
+        myVec4.grow_by(5);
+        tracked::copiesLeft = 3;
+        thrown = false;
+        try
+        {
+            myVec4.grow_by(10, prototype);
+        }
+        catch (const std::runtime_error &)
+        {
+            thrown = true;
+        }
+        assert(thrown && myVec4.size() == 15 && tracked::live == 1 + 5 + 3);
+        assert(myVec4.holds_item(7) && !myVec4.holds_item(8) && !myVec4.holds_item(14));
+        assert(std::distance(myVec4.begin(), myVec4.end()) == 8);
+        tracked::copiesLeft = 100;
+        myVec4.grow_by(2, prototype);
+        myVec4.clear();
+        assert(tracked::live == 1);
+        myVec4.grow_by(3);
+        assert(tracked::live == 4);
+    }
+    assert(tracked::live == 0);
+
+    // Test a failed segment allocation leaves its slot without an item, later slots get the segment
+    asd::concurrent_vector<std::string, flaky_allocator<std::string>, 4> myVec5;
+    for (int i = 0; i < 4; ++i)
+    {
+        myVec5.push_back(std::to_string(i));
+    }
+    failAllocations = true;
+    thrown = false;
+    try
+    {
+        myVec5.push_back("lost");
+    }
+    catch (const std::bad_alloc &)
+    {
+        thrown = true;
+    }
+    failAllocations = false;
+    myVec5.push_back("5");
+    myVec5.push_back("6");
+    assert(thrown && myVec5.size() == 7 && !myVec5.holds_item(4) && myVec5.holds_item(5) && myVec5[6] == "6");
+    std::string joined;
+    for (const std::string &item : myVec5)
+    {
+        joined += item;
+    }
+    assert(joined == "012356");
+
+    std::cout << "concurrent_vector examples done" << std::endl;
+
+    return 0;
+}
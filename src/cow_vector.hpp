@@ -0,0 +1,390 @@
+/*
+ * Copyright (C) 2023 Sofyan Gaber <sofyanhalaby@gmail.com>
+ *
+ * This code is for demonstration and educational purposes. It
+ * implements a copy on write vector for read mostly data.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ASD_COW_VECTOR_2023
+#define ASD_COW_VECTOR_2023
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include "vector.hpp"
+
+namespace asd
+{
+    template <typename T, typename Alloc>
+    class atomic_cow_vector;
+
+    /*
+    class asd::cow_vector<T, Alloc> shares one immutable buffer between its copies, copying is a reference count
+    increment and the items are copied only by the first change of a shared buffer, so a snapshot that was handed
+    to readers never changes under them and reading it takes no lock
+    the items are read only, changes go through edit() or the few modifiers, which unshare the buffer first
+    the reference count is atomic, so copies can be made and dropped on any thread,
+    one cow_vector object is not safe to change from two threads at once, see asd::atomic_cow_vector to publish versions
+    */
+    template <typename T, typename Alloc = allocator<T>>
+    class cow_vector
+    {
+    public:
+        using vector_type = vector<T, Alloc>;
+
+    private:
+        struct buffer
+        {
+            std::atomic<std::size_t> refs;
+            vector_type items;
+
+            explicit buffer(vector_type &&other) noexcept
+                : refs(1), items(std::move(other))
+            {
+            }
+        };
+
+        using buffer_allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<buffer>;
+        using buffer_traits = std::allocator_traits<buffer_allocator>;
+
+        buffer *m_buffer; // nullptr until the first change of an empty container
+        ASD_NO_UNIQUE_ADDRESS Alloc m_allocator;
+
+        friend class atomic_cow_vector<T, Alloc>;
+
+        buffer *make_buffer(vector_type &&items)
+        {
+            buffer_allocator alloc(m_allocator);
+            buffer *ptr = buffer_traits::allocate(alloc, 1);
+            return ::new (static_cast<void *>(ptr)) buffer(std::move(items));
+        }
+
+        static void retain(buffer *ptr) noexcept
+        {
+            if (ptr != nullptr)
+            {
+                ptr->refs.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        static void release(buffer *ptr) noexcept
+        {
+            if (ptr != nullptr && ptr->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                buffer_allocator alloc(ptr->items.get_allocator());
+                ptr->~buffer();
+                buffer_traits::deallocate(alloc, ptr, 1);
+            }
+        }
+
+        /*
+        takes over a reference to ptr
+        */
+        cow_vector(buffer *ptr, const Alloc &alloc) noexcept
+            : m_buffer(ptr), m_allocator(alloc)
+        {
+        }
+
+        static const vector_type &empty_items() noexcept
+        {
+            static const vector_type items;
+            return items;
+        }
+
+        const vector_type &items() const noexcept
+        {
+            return m_buffer == nullptr ? empty_items() : m_buffer->items;
+        }
+
+    public:
+        using value_type = T;
+        using allocator_type = Alloc;
+        using const_iterator = const T *;
+        using iterator = const_iterator;
+
+        cow_vector() noexcept(noexcept(Alloc()))
+            : m_buffer(nullptr), m_allocator()
+        {
+        }
+
+        explicit cow_vector(const Alloc &alloc) noexcept
+            : m_buffer(nullptr), m_allocator(alloc)
+        {
+        }
+
+        /*
+        takes the items of a vector without copying them
+        */
+        explicit cow_vector(vector_type &&items)
+            : m_buffer(nullptr), m_allocator(items.get_allocator())
+        {
+            m_buffer = make_buffer(std::move(items));
+        }
+
+        /*
+        shares the buffer of other, it doesn't copy the items
+        */
+        cow_vector(const cow_vector &other) noexcept
+            : m_buffer(other.m_buffer), m_allocator(other.m_allocator)
+        {
+            retain(m_buffer);
+        }
+
+        cow_vector(cow_vector &&other) noexcept
+            : m_buffer(std::exchange(other.m_buffer, nullptr)), m_allocator(other.m_allocator)
+        {
+        }
+
+        cow_vector &operator=(const cow_vector &other) noexcept
+        {
+            retain(other.m_buffer);
+            release(m_buffer);
+            m_buffer = other.m_buffer;
+            m_allocator = other.m_allocator;
+            return *this;
+        }
+
+        cow_vector &operator=(cow_vector &&other) noexcept
+        {
+            if (this != &other)
+            {
+                release(m_buffer);
+                m_buffer = std::exchange(other.m_buffer, nullptr);
+                m_allocator = other.m_allocator;
+            }
+            return *this;
+        }
+
+        ~cow_vector() noexcept
+        {
+            release(m_buffer);
+        }
+
+        void swap(cow_vector &other) noexcept
+        {
+            std::swap(m_buffer, other.m_buffer);
+            std::swap(m_allocator, other.m_allocator);
+        }
+
+        allocator_type get_allocator() const noexcept
+        {
+            return m_allocator;
+        }
+
+        /*
+        number of cow_vector and atomic_cow_vector objects sharing the buffer, 0 if there is no buffer
+        */
+        std::size_t use_count() const noexcept
+        {
+            return m_buffer == nullptr ? 0 : m_buffer->refs.load(std::memory_order_acquire);
+        }
+
+        /*
+        the items to be changed, the buffer is copied first if it is shared so no other copy sees the changes
+        the reference is valid until this container is copied, assigned or destroyed
+        it raises the bad_alloc exception
+        */
+        vector_type &edit()
+        {
+            if (m_buffer == nullptr)
+            {
+                m_buffer = make_buffer(vector_type(m_allocator));
+            }
+            else if (m_buffer->refs.load(std::memory_order_acquire) != 1)
+            {
+                buffer *copy = make_buffer(vector_type(m_buffer->items));
+                release(m_buffer);
+                m_buffer = copy;
+            }
+            return m_buffer->items;
+        }
+
+        template <class U>
+        void push_back(U &&item)
+        {
+            edit().push_back(std::forward<U>(item));
+        }
+
+        template <typename... Args>
+        void emplace_back(Args &&...args)
+        {
+            edit().emplace_back(std::forward<Args>(args)...);
+        }
+
+        void pop_back()
+        {
+            edit().pop_back();
+        }
+
+        void resize(std::size_t n)
+        {
+            edit().resize(n);
+        }
+
+        void reserve(std::size_t n)
+        {
+            edit().reserve(n);
+        }
+
+        /*
+        drops the reference to the buffer, it copies nothing
+        */
+        void clear() noexcept
+        {
+            release(std::exchange(m_buffer, nullptr));
+        }
+
+        /*
+        doesn't provide boundary checks to give faster access, API client should take care
+        */
+        const T &operator[](std::size_t idx) const
+        {
+            return m_buffer->items[idx];
+        }
+
+        std::size_t size() const noexcept
+        {
+            return m_buffer == nullptr ? 0 : m_buffer->items.size();
+        }
+
+        bool empty() const noexcept
+        {
+            return size() == 0;
+        }
+
+        const T *data() const noexcept
+        {
+            return items().data();
+        }
+
+        const_iterator begin() const noexcept
+        {
+            return items().begin();
+        }
+
+        const_iterator end() const noexcept
+        {
+            return items().end();
+        }
+
+        const_iterator cbegin() const noexcept
+        {
+            return begin();
+        }
+
+        const_iterator cend() const noexcept
+        {
+            return end();
+        }
+
+        const T &front() const
+        {
+            return m_buffer->items.front();
+        }
+
+        const T &back() const
+        {
+            return m_buffer->items.back();
+        }
+    };
+
+    /*
+    class asd::atomic_cow_vector<T, Alloc> holds the current version of a cow_vector for many threads,
+    readers load() a snapshot without a lock and keep reading it while writers store() new versions
+    load() announces itself on a counter while it takes its reference, so a writer releases the old version
+    only after the loads that may have seen it are done, a writer may wait for those few instructions,
+    a reader never waits
+    */
+    template <typename T, typename Alloc = allocator<T>>
+    class atomic_cow_vector
+    {
+        using snapshot_type = cow_vector<T, Alloc>;
+        using buffer = typename snapshot_type::buffer;
+
+        std::atomic<buffer *> m_current;
+        mutable std::atomic<std::size_t> m_loading; // number of load() calls in progress
+        ASD_NO_UNIQUE_ADDRESS Alloc m_allocator;
+
+        /*
+        waits until no load() can still take a reference to a buffer that was replaced
+        */
+        void wait_for_loads() const noexcept
+        {
+            while (m_loading.load(std::memory_order_seq_cst) != 0)
+            {
+                std::this_thread::yield();
+            }
+        }
+
+    public:
+        atomic_cow_vector() noexcept(noexcept(Alloc()))
+            : m_current(nullptr), m_loading(0), m_allocator()
+        {
+        }
+
+        explicit atomic_cow_vector(snapshot_type items) noexcept
+            : m_current(std::exchange(items.m_buffer, nullptr)), m_loading(0), m_allocator(items.m_allocator)
+        {
+        }
+
+        atomic_cow_vector(const atomic_cow_vector &) = delete;
+        atomic_cow_vector &operator=(const atomic_cow_vector &) = delete;
+
+        ~atomic_cow_vector() noexcept
+        {
+            snapshot_type::release(m_current.load(std::memory_order_relaxed));
+        }
+
+        /*
+        the current version, its items don't change while the snapshot is kept, it never waits
+        */
+        snapshot_type load() const noexcept
+        {
+            m_loading.fetch_add(1, std::memory_order_seq_cst);
+            buffer *current = m_current.load(std::memory_order_seq_cst);
+            snapshot_type::retain(current);
+            m_loading.fetch_sub(1, std::memory_order_release);
+            return snapshot_type(current, m_allocator);
+        }
+
+        /*
+        publishes items as the current version, the snapshots loaded before keep the old version
+        */
+        void store(snapshot_type items) noexcept
+        {
+            exchange(std::move(items));
+        }
+
+        /*
+        publishes items as the current version and returns the previous one
+        */
+        snapshot_type exchange(snapshot_type items) noexcept
+        {
+            buffer *previous = m_current.exchange(std::exchange(items.m_buffer, nullptr), std::memory_order_seq_cst);
+            wait_for_loads();
+            return snapshot_type(previous, m_allocator);
+        }
+    };
+}
+#endif //ifndef ASD_COW_VECTOR_2023
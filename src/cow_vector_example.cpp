@@ -0,0 +1,88 @@
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <assert.h>
+#include "cow_vector.hpp"
+
+int main()
+{
+    // Test copies share the buffer until the first change
+    asd::vector<std::string> items;
+    for (int i = 0; i < 100; ++i)
+    {
+        items.push_back(std::to_string(i));
+    }
+    const std::string *itemsData = items.data();
+    asd::cow_vector<std::string> myVec1(std::move(items));
+    assert(myVec1.size() == 100 && myVec1.data() == itemsData && myVec1.use_count() == 1);
+    asd::cow_vector<std::string> myVec2(myVec1);
+    asd::cow_vector<std::string> myVec3;
+    myVec3 = myVec2;
+    assert(myVec2.data() == myVec1.data() && myVec3.data() == myVec1.data() && myVec1.use_count() == 3);
+    myVec2.push_back("new");
+    assert(myVec2.size() == 101 && myVec1.size() == 100 && myVec2.data() != myVec1.data());
+    assert(myVec2[50] == "50" && myVec2.back() == "new" && myVec1.back() == "99" && myVec1.use_count() == 2);
+    const std::string *unshared = myVec2.data();
+    myVec2.edit()[0] = "first";
+    myVec2.pop_back();
+    assert(myVec2.data() == unshared && myVec2.front() == "first" && myVec1.front() == "0" && myVec2.use_count() == 1);
+    myVec3.clear();
+    assert(myVec3.empty() && myVec3.begin() == myVec3.end() && myVec1.use_count() == 1);
+    myVec3.emplace_back(3, 'x');
+    assert(myVec3.size() == 1 && myVec3[0] == "xxx");
+    myVec3.swap(myVec1);
+    assert(myVec3.size() == 100 && myVec1[0] == "xxx");
+    asd::cow_vector<int> myVec4;
+    assert(myVec4.empty() && myVec4.use_count() == 0 && myVec4.data() == asd::cow_vector<int>().data());
+    myVec4.resize(10);
+    myVec4.reserve(100);
+    assert(myVec4.size() == 10 && myVec4[9] == 0);
+
+    // Test readers see whole versions while a writer publishes new ones
+    asd::vector<int> first;
+    first.resize(1000);
+    asd::atomic_cow_vector<int> current(asd::cow_vector<int>(std::move(first)));
+    std::atomic<bool> done{false};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 4; ++r)
+    {
+        readers.emplace_back([&] {
+            int last = 0;
+            while (!done.load())
+            {
+                asd::cow_vector<int> snapshot = current.load();
+                int version = snapshot[0];
+                for (int item : snapshot)
+                {
+                    assert(item == version);
+                }
+                assert(snapshot.size() == 1000 && version >= last);
+                last = version;
+            }
+        });
+    }
+    asd::cow_vector<int> version1 = current.load();
+    for (int v = 1; v <= 200; ++v)
+    {
+        asd::cow_vector<int> next = current.load();
+        for (int &item : next.edit())
+        {
+            item = v;
+        }
+        current.store(std::move(next));
+    }
+    done = true;
+    for (std::thread &reader : readers)
+    {
+        reader.join();
+    }
+    assert(version1[999] == 0 && current.load()[0] == 200);
+    asd::cow_vector<int> previous = current.exchange(asd::cow_vector<int>());
+    assert(previous[0] == 200 && current.load().empty());
+
+    std::cout << "cow_vector examples done" << std::endl;
+
+    return 0;
+}
@@ -1,9 +1,57 @@
 #include <iostream>
 #include <vector>
 #include <string>
+#include <memory>
+#include <memory_resource>
+#include <algorithm>
+#include <numeric>
+#include <functional>
+#include <iterator>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
 #include <assert.h>
 #include "vector.hpp"
 
+struct alignas(64) cache_line
+{
+    int value;
+};
+
+// an item whose copy throws when copiesLeft runs out, live counts the constructed items
+struct fragile
+{
+    static int live;
+    static int copiesLeft;
+    std::string value;
+
+    explicit fragile(const std::string &v)
+        : value(v)
+    {
+        ++live;
+    }
+
+    fragile(const fragile &other)
+        : value(other.value)
+    {
+        if (copiesLeft-- == 0)
+        {
+            throw std::runtime_error("copy");
+        }
+        ++live;
+    }
+
+    fragile &operator=(const fragile &) = default;
+
+    ~fragile()
+    {
+        --live;
+    }
+};
+
+int fragile::live = 0;
+int fragile::copiesLeft = -1;
+
 int main()
 {
 
@@ -64,6 +112,375 @@ int main()
     myVec2.emplace_back("asd");
     assert(myVec2[0] == "asd");
 
+    // Test trivially relocatable growth (realloc path)
+    asd::vector<std::unique_ptr<int>> myVec5;
+    for (int i = 0; i < 100; ++i)
+    {
+        myVec5.push_back(std::make_unique<int>(i));
+    }
+    for (int i = 0; i < 100; ++i)
+    {
+        assert(*myVec5[i] == i);
+    }
+    static_assert(asd::is_trivially_relocatable_v<int>);
+    static_assert(asd::is_trivially_relocatable_v<std::unique_ptr<int>>);
+    static_assert(!asd::is_trivially_relocatable_v<std::string>);
+
+    // Test copy assignment reuses capacity
+    asd::vector<std::string> myVec6;
+    for (int i = 0; i < 8; ++i)
+    {
+        myVec6.push_back(std::to_string(i));
+    }
+    myVec6 = myVec3;
+    assert(myVec6.size() == myVec3.size());
+    assert(myVec6[99] == "test99");
+    asd::vector<int> myVec7;
+    myVec7 = myVec1;
+    assert(myVec7.size() == myVec1.size() && myVec7[42] == 42);
+
+    // Test reserve / resize / shrink_to_fit
+    asd::vector<std::string> myVec8;
+    myVec8.reserve(50);
+    assert(myVec8.capacity() == 50 && myVec8.size() == 0);
+    myVec8.resize(10, "x");
+    assert(myVec8.size() == 10 && myVec8[9] == "x");
+    myVec8.resize(60);
+    assert(myVec8.size() == 60 && myVec8[59].empty() && myVec8[0] == "x");
+    myVec8.resize(5);
+    assert(myVec8.size() == 5);
+    myVec8.shrink_to_fit();
+    assert(myVec8.capacity() == 5 && myVec8[4] == "x");
+    myVec8.resize(0);
+    myVec8.shrink_to_fit();
+    assert(myVec8.capacity() == 0);
+
+    // Test growth policies
+    asd::vector<int, asd::allocator<int>, asd::growth::fixed_step<16>> myVec9;
+    asd::vector<int, asd::allocator<int>, asd::growth::one_and_half> myVec10;
+    asd::vector<int, asd::allocator<int>, asd::growth::size_class<>> myVec11;
+    for (int i = 0; i < 100; ++i)
+    {
+        myVec9.push_back(i);
+        myVec10.push_back(i);
+        myVec11.push_back(i);
+    }
+    assert(myVec9.capacity() == 112);
+    assert(myVec10.capacity() >= 100 && myVec10[99] == 99);
+    assert(myVec11.capacity() >= 100 && myVec11[99] == 99);
+    static_assert(asd::growth::size_class<>::round_up(17) == 32);
+    static_assert(asd::growth::size_class<>::round_up(100) == 112);
+    static_assert(asd::growth::size_class<>::round_up(1000) == 1024);
+
+    // Test std::pmr allocator, items get the container allocator
+    std::pmr::monotonic_buffer_resource resource;
+    using pmr_vector = asd::vector<std::pmr::string, std::pmr::polymorphic_allocator<std::pmr::string>>;
+    pmr_vector myVec12{std::pmr::polymorphic_allocator<std::pmr::string>(&resource)};
+    for (int i = 0; i < 20; ++i)
+    {
+        myVec12.emplace_back("a string that is too long for small string optimization " + std::to_string(i));
+    }
+    assert(myVec12.get_allocator().resource() == &resource);
+    assert(myVec12[19].get_allocator().resource() == &resource);
+    pmr_vector myVec13(myVec12);
+    assert(myVec13.get_allocator().resource() == std::pmr::get_default_resource());
+    assert(myVec13[19] == myVec12[19]);
+    myVec13 = std::move(myVec12);
+    assert(myVec13.size() == 20 && myVec12.size() == 0);
+    assert(myVec13.get_allocator().resource() == std::pmr::get_default_resource());
+    pmr_vector myVec14;
+    myVec14.swap(myVec13);
+    assert(myVec14.size() == 20 && myVec13.size() == 0);
+
+    // Test stateless allocator takes no space, and asd::allocator works with std containers
+    static_assert(sizeof(asd::vector<int>) == sizeof(void *) + 2 * sizeof(std::size_t));
+    std::vector<std::string, asd::allocator<std::string>> stdVec5(100, "asd");
+    assert(stdVec5[99] == "asd");
+
+    // Test bulk append, it allocates once for forward ranges
+    asd::vector<int> myVec15;
+    myVec15.append(stdVec1.data(), stdVec1.data() + stdVec1.size());
+    assert(myVec15.size() == 100 && myVec15.capacity() == 100 && myVec15[99] == 99);
+    myVec15.append(&myVec15[0], &myVec15[0] + 50);
+    assert(myVec15.size() == 150 && myVec15[149] == 49);
+    asd::vector<std::string> myVec16;
+    myVec16.append(stdVec3.begin(), stdVec3.end());
+    myVec16.append({"a", "b"});
+    assert(myVec16.size() == 102 && myVec16[99] == "test99" && myVec16[101] == "b");
+
+    // Test insert of ranges and copies
+    asd::vector<std::string> myVec17;
+    myVec17.insert(0, {"c", "d"});
+    myVec17.insert(0, {"a", "b"});
+    myVec17.insert(4, 2, std::string("e"));
+    myVec17.insert(2, 3, std::string("x"));
+    std::vector<std::string> expected17 = {"a", "b", "x", "x", "x", "c", "d", "e", "e"};
+    assert(myVec17.size() == expected17.size());
+    for (std::size_t i = 0; i < expected17.size(); ++i)
+    {
+        assert(myVec17[i] == expected17[i]);
+    }
+    myVec17.insert(1, &myVec17[5], &myVec17[5] + 2);
+    assert(myVec17.size() == 11 && myVec17[1] == "c" && myVec17[2] == "d" && myVec17[3] == "b");
+    myVec17.insert(0, 1, myVec17[10]);
+    assert(myVec17[0] == "e" && myVec17.size() == 12);
+    asd::vector<int> myVec18;
+    myVec18.insert(0, 5, 7);
+    myVec18.insert(2, {1, 2, 3});
+    int expected18[] = {7, 7, 1, 2, 3, 7, 7, 7};
+    assert(myVec18.size() == 8);
+    for (std::size_t i = 0; i < 8; ++i)
+    {
+        assert(myVec18[i] == expected18[i]);
+    }
+
+    // Test assign
+    myVec18.assign(3, 9);
+    assert(myVec18.size() == 3 && myVec18[2] == 9 && myVec18.capacity() >= 8);
+    myVec17.assign(stdVec3.begin(), stdVec3.begin() + 50);
+    assert(myVec17.size() == 50 && myVec17[49] == "test49");
+    myVec17.assign(&myVec17[10], &myVec17[10] + 5);
+    assert(myVec17.size() == 5 && myVec17[0] == "test10");
+    myVec17.assign({"one"});
+    assert(myVec17.size() == 1 && myVec17[0] == "one");
+
+    // Test contiguous iterators with std algorithms
+    asd::vector<int> myVec19;
+    for (int i = 0; i < 100; ++i)
+    {
+        myVec19.push_back(99 - i);
+    }
+    std::sort(myVec19.begin(), myVec19.end());
+    assert(std::is_sorted(myVec19.cbegin(), myVec19.cend()));
+    assert(myVec19.front() == 0 && myVec19.back() == 99 && *myVec19.rbegin() == 99);
+    assert(std::accumulate(myVec19.begin(), myVec19.end(), 0) == 4950);
+    std::transform(myVec19.begin(), myVec19.end(), myVec19.begin(), [](int item) { return item * 2; });
+    int total = 0;
+    for (int item : myVec19)
+    {
+        total += item;
+    }
+    assert(total == 9900 && myVec19.data() == &myVec19[0] && !myVec19.empty());
+    const asd::vector<std::string> &constVec3 = myVec3;
+    assert(std::find(constVec3.begin(), constVec3.end(), "test42") - constVec3.begin() == 42);
+#if __cplusplus >= 202002L
+    static_assert(std::contiguous_iterator<asd::vector<int>::iterator>);
+    static_assert(std::contiguous_iterator<asd::vector<int>::const_iterator>);
+#endif
+
+    // Test over-aligned storage
+    asd::vector<cache_line> myVec20;
+    static_assert(asd::vector<cache_line>::alignment == 64);
+    for (int i = 0; i < 1000; ++i)
+    {
+        myVec20.push_back(cache_line{i});
+        assert(reinterpret_cast<std::uintptr_t>(myVec20.data()) % 64 == 0);
+    }
+    assert(myVec20[999].value == 999 && myVec20.front().value == 0);
+    myVec20.shrink_to_fit();
+    assert(reinterpret_cast<std::uintptr_t>(myVec20.data()) % 64 == 0 && myVec20[500].value == 500);
+    asd::vector<float, asd::aligned_allocator<float, 64>> myVec21;
+    static_assert(decltype(myVec21)::alignment == 64 && asd::vector<float>::alignment == alignof(std::max_align_t));
+    static_assert(sizeof(myVec21) == sizeof(asd::vector<float>));
+    for (int i = 0; i < 1000; ++i)
+    {
+        myVec21.push_back(static_cast<float>(i));
+        assert(reinterpret_cast<std::uintptr_t>(myVec21.data()) % 64 == 0);
+    }
+    std::vector<double, asd::aligned_allocator<double, 128>> stdVec6(100, 1.0);
+    assert(reinterpret_cast<std::uintptr_t>(stdVec6.data()) % 128 == 0);
+
+    // Test uninitialized resize keeps the items and skips zeroing the new ones
+    asd::vector<unsigned char> myVec22;
+    myVec22.resize(4, static_cast<unsigned char>(7));
+    myVec22.resize_uninitialized(1 << 20);
+    assert(myVec22.size() == (1 << 20) && myVec22[3] == 7);
+    std::memset(myVec22.data() + 4, 1, myVec22.size() - 4);
+    myVec22.resize(10, asd::default_init);
+    assert(myVec22.size() == 10 && myVec22[9] == 1 && myVec22.capacity() >= (1 << 20));
+
+    // Test compact header layout
+    static_assert(std::is_final_v<asd::vector<int>> && !std::is_polymorphic_v<asd::vector<int>>);
+    static_assert(sizeof(asd::vector<int>) == 3 * sizeof(void *));
+    static_assert(sizeof(asd::compact_vector<int>) == sizeof(void *) + 8);
+    static_assert(asd::compact_vector<char>::max_size() == UINT32_MAX);
+    asd::compact_vector<std::string> myVec23;
+    for (int i = 0; i < 1000; ++i)
+    {
+        myVec23.push_back(std::to_string(i));
+    }
+    myVec23.insert(0, 1, std::string("first"));
+    assert(myVec23.size() == 1001 && myVec23[0] == "first" && myVec23[1000] == "999");
+    asd::compact_vector<std::string> myVec24(myVec23);
+    assert(myVec24.size() == 1001 && myVec24.back() == "999");
+    myVec24.resize(3);
+    myVec24.swap(myVec23);
+    assert(myVec23.size() == 3 && myVec24.size() == 1001);
+    asd::compact_vector<char> myVec25;
+    bool thrown = false;
+    try
+    {
+        myVec25.reserve(std::size_t(1) << 32);
+    }
+    catch (const std::length_error &)
+    {
+        thrown = true;
+    }
+    assert(thrown && myVec25.capacity() == 0);
+
+    // Test erase keeps the order of the other items
+    asd::vector<int> myVec26;
+    for (int i = 0; i < 10; ++i)
+    {
+        myVec26.push_back(i);
+    }
+    myVec26.pop_back();
+    myVec26.erase(0);
+    myVec26.erase(2, 5);
+    assert(myVec26.size() == 5 && myVec26[0] == 1 && myVec26[1] == 2 && myVec26[2] == 6 && myVec26[4] == 8);
+    myVec26.erase(1, 1);
+    myVec26.swap_erase(0);
+    assert(myVec26.size() == 4 && myVec26[0] == 8 && myVec26[1] == 2 && myVec26[3] == 7);
+    myVec26.swap_erase(3);
+    assert(myVec26.size() == 3 && myVec26.back() == 6);
+    assert(myVec26.erase_if([](int item) { return item % 2 == 0; }) == 3 && myVec26.empty());
+
+    // Test erase destroys the removed items once
+    auto counter = std::make_shared<int>(0);
+    asd::vector<std::shared_ptr<int>> myVec27;
+    myVec27.assign(2, counter);
+    asd::vector<std::string> myVec28;
+    for (int i = 0; i < 100; ++i)
+    {
+        myVec27.push_back(counter);
+        myVec28.push_back(std::to_string(i));
+    }
+    myVec27.erase(10, 50);
+    myVec27.swap_erase(0);
+    myVec27.pop_back();
+    assert(myVec27.size() == 60 && counter.use_count() == 61);
+    int calls = 0;
+    assert(myVec27.erase_if([&](const std::shared_ptr<int> &) { return ++calls % 3 == 0; }) == 20);
+    assert(calls == 60 && myVec27.size() == 40 && counter.use_count() == 41);
+    myVec28.erase(0, 10);
+    myVec28.swap_erase(0);
+    assert(myVec28.size() == 89 && myVec28[0] == "99" && myVec28[1] == "11" && myVec28.back() == "98");
+    assert(myVec28.erase_if([](const std::string &item) { return item.size() == 2 && item[1] != '1'; }) == 80);
+    assert(myVec28.size() == 9 && myVec28[0] == "11" && myVec28[8] == "91");
+    asd::vector<std::unique_ptr<int>> myVec29;
+    for (int i = 0; i < 100; ++i)
+    {
+        myVec29.push_back(std::make_unique<int>(i));
+    }
+    myVec29.erase(0, 10);
+    myVec29.swap_erase(0);
+    assert(myVec29.size() == 89 && *myVec29[0] == 99 && *myVec29[1] == 11 && *myVec29.back() == 98);
+    assert(myVec29.erase_if([](const std::unique_ptr<int> &item) { return *item % 10 != 1; }) == 80);
+    assert(myVec29.size() == 9 && *myVec29[0] == 11 && *myVec29[8] == 91);
+
+    // Test resize_with constructs the new items by the callback
+    asd::vector<std::string> myVec30;
+    myVec30.push_back("first");
+    myVec30.resize_with(4, [](std::string *first, std::size_t count) {
+        std::uninitialized_fill(first, first + count, std::string("new"));
+    });
+    assert(myVec30.size() == 4 && myVec30[0] == "first" && myVec30[3] == "new");
+    myVec30.resize_with(1, [](std::string *, std::size_t) { assert(false); });
+    assert(myVec30.size() == 1 && myVec30[0] == "first");
+
+    // Test memory_usage and slack_bytes count the header and the memory malloc reserved
+    asd::vector<std::uint64_t> myVec31;
+    assert(myVec31.memory_usage() == sizeof(myVec31) && myVec31.slack_bytes() == 0);
+    for (std::uint64_t i = 0; i < 1000; ++i)
+    {
+        myVec31.push_back(i);
+    }
+    assert(myVec31.capacity() == 1024);
+    assert(myVec31.memory_usage() >= sizeof(myVec31) + 1024 * sizeof(std::uint64_t));
+    assert(myVec31.slack_bytes() == myVec31.memory_usage() - sizeof(myVec31) - 1000 * sizeof(std::uint64_t));
+    myVec31.erase(0, 900);
+    assert(myVec31.slack_bytes() >= 924 * sizeof(std::uint64_t));
+    myVec31.shrink_to_fit();
+    assert(myVec31.capacity() == 100 && myVec31.slack_bytes() < 32);
+    asd::vector<int, std::allocator<int>> myVec32;
+    myVec32.resize(10, 1);
+    assert(myVec32.memory_usage() == sizeof(myVec32) + myVec32.capacity() * sizeof(int));
+    assert(myVec32.slack_bytes() == (myVec32.capacity() - 10) * sizeof(int));
+
+    // Test push_back and emplace_back of an own item when the container is full
+    asd::vector<std::string> myVec33;
+    myVec33.push_back(std::string(100, 'a'));
+    assert(myVec33.size() == myVec33.capacity());
+    myVec33.emplace_back(myVec33[0]);
+    assert(myVec33.size() == myVec33.capacity());
+    myVec33.push_back(myVec33[1]);
+    myVec33.emplace_back(myVec33[0], 10, 5);
+    assert(myVec33.size() == 4 && myVec33.size() == myVec33.capacity());
+    myVec33.push_back(std::move(myVec33[3]));
+    assert(myVec33[1] == std::string(100, 'a') && myVec33[2] == myVec33[1] && myVec33[4] == "aaaaa");
+    asd::vector<int> myVec34;
+    myVec34.push_back(7);
+    for (int i = 0; i < 10; ++i)
+    {
+        myVec34.push_back(myVec34.back());
+    }
+    assert(myVec34.size() == 11 && std::count(myVec34.begin(), myVec34.end(), 7) == 11);
+
+    // Test a throwing copy leaves copy assignment and the copy constructor consistent
+    {
+        asd::vector<fragile> myVec35;
+        asd::vector<fragile> myVec36;
+        asd::vector<fragile> myVec37;
+        for (int i = 0; i < 10; ++i)
+        {
+            myVec35.emplace_back(std::string(30, static_cast<char>('a' + i)));
+        }
+        for (int i = 0; i < 20; ++i)
+        {
+            myVec36.emplace_back("old");
+        }
+        myVec37.emplace_back("kept");
+        assert(fragile::live == 31);
+        bool thrown = false;
+        fragile::copiesLeft = 5;
+        try
+        {
+            myVec36 = myVec35;
+        }
+        catch (const std::runtime_error &)
+        {
+            thrown = true;
+        }
+        assert(thrown && myVec36.empty() && fragile::live == 11);
+        thrown = false;
+        fragile::copiesLeft = 5;
+        try
+        {
+            myVec37 = myVec35;
+        }
+        catch (const std::runtime_error &)
+        {
+            thrown = true;
+        }
+        assert(thrown && myVec37.size() == 1 && myVec37[0].value == "kept" && fragile::live == 11);
+        thrown = false;
+        fragile::copiesLeft = 5;
+        try
+        {
+            asd::vector<fragile> myVec38(myVec35);
+        }
+        catch (const std::runtime_error &)
+        {
+            thrown = true;
+        }
+        assert(thrown && fragile::live == 11);
+        fragile::copiesLeft = -1;
+        myVec36 = myVec35;
+        myVec37 = myVec35;
+        assert(myVec36.size() == 10 && myVec37[9].value == myVec35[9].value && fragile::live == 30);
+    }
+    assert(fragile::live == 0);
+
     std::cout << "examples done" << std::endl;
 
     return 0;
@@ -0,0 +1,893 @@
+/*
+ * Copyright (C) 2023 Sofyan Gaber <sofyanhalaby@gmail.com>
+ *
+ * This code is for demonstration and educational purposes. It
+ * implements sorted flat map and set classes.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ASD_FLAT_MAP_2023
+#define ASD_FLAT_MAP_2023
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include "vector.hpp"
+
+namespace asd
+{
+    /*
+    marks input that is already sorted and free of equal keys, so it is adopted without sorting
+    */
+    struct sorted_unique_t
+    {
+        explicit sorted_unique_t() = default;
+    };
+
+    inline constexpr sorted_unique_t sorted_unique{};
+
+    /*
+    lookup policies of asd::flat_map and asd::flat_set, each one has an index<K> class that is built
+    over the sorted keys after every change and finds the position of the first key not less than a key
+    */
+    namespace lookup
+    {
+        /*
+        std::lower_bound, a branch per level that the cpu has to guess
+        */
+        struct binary
+        {
+            template <typename K>
+            class index
+            {
+            public:
+                void build(const K *, std::size_t) noexcept
+                {
+                }
+
+                template <typename Compare>
+                static std::size_t lower_bound(const K *keys, std::size_t n, const K &key, const Compare &compare)
+                {
+                    return static_cast<std::size_t>(std::lower_bound(keys, keys + n, key, compare) - keys);
+                }
+            };
+        };
+
+        /*
+        halves the range by a conditional move instead of a branch, so a search has no mispredictions
+        and takes log2(n) steps however the keys compare
+        */
+        struct branchless
+        {
+            template <typename K>
+            class index
+            {
+            public:
+                void build(const K *, std::size_t) noexcept
+                {
+                }
+
+                template <typename Compare>
+                static std::size_t lower_bound(const K *keys, std::size_t n, const K &key, const Compare &compare)
+                {
+                    if (n == 0)
+                    {
+                        return 0;
+                    }
+                    const K *base = keys;
+                    while (n > 1)
+                    {
+                        std::size_t half = n / 2;
+                        base = compare(base[half], key) ? base + half : base;
+                        n -= half;
+                    }
+                    return static_cast<std::size_t>(base - keys) + static_cast<std::size_t>(compare(*base, key));
+                }
+            };
+        };
+
+        /*
+        keeps a copy of the keys in the breadth first order of a complete binary tree (the Eytzinger layout),
+        the first levels of every search share the same cache lines and the next levels are prefetched
+        four steps ahead, it is meant for large tables that are built once and searched many times
+        the copy doubles the memory of the keys and every change rebuilds it in O(n),
+        flat_map_benchmark compares it with the branchless search
+        */
+        struct eytzinger
+        {
+            template <typename K>
+            class index
+            {
+                // m_tree[k - 1] is node k, the children of node k are 2k and 2k + 1
+                vector<K> m_tree;
+                // m_ranks[k - 1] is the sorted position of node k
+                vector<std::size_t> m_ranks;
+
+                static std::size_t fill(vector<K> &tree, vector<std::size_t> &ranks, const K *keys, std::size_t k, std::size_t i)
+                {
+                    if (k <= tree.size())
+                    {
+                        i = fill(tree, ranks, keys, 2 * k, i);
+                        tree[k - 1] = keys[i];
+                        ranks[k - 1] = i++;
+                        i = fill(tree, ranks, keys, 2 * k + 1, i);
+                    }
+                    return i;
+                }
+
+            public:
+                /*
+                a failed build leaves the index empty and the searches fall back to the branchless one
+                */
+                void build(const K *keys, std::size_t n)
+                {
+                    m_tree.erase(0, m_tree.size());
+                    m_ranks.erase(0, m_ranks.size());
+                    vector<K> tree;
+                    vector<std::size_t> ranks;
+                    tree.assign(keys, keys + n);
+                    ranks.resize(n);
+                    fill(tree, ranks, keys, 1, 0);
+                    m_tree.swap(tree);
+                    m_ranks.swap(ranks);
+                }
+
+                template <typename Compare>
+                std::size_t lower_bound(const K *keys, std::size_t n, const K &key, const Compare &compare) const
+                {
+                    if (m_tree.size() != n)
+                    {
+                        return branchless::index<K>::lower_bound(keys, n, key, compare);
+                    }
+                    const K *tree = m_tree.data();
+                    std::size_t k = 1;
+                    while (k <= n)
+                    {
+                        if (16 * k <= n)
+                        {
+                            __builtin_prefetch(tree + (16 * k - 1));
+                        }
+                        k = 2 * k + static_cast<std::size_t>(compare(tree[k - 1], key));
+                    }
+                    // drop the right turns taken after the last left turn, that node is the lower bound
+                    k >>= __builtin_ctzll(~static_cast<unsigned long long>(k)) + 1;
+                    return k == 0 ? n : m_ranks[k - 1];
+                }
+            };
+        };
+    }
+
+    namespace detail
+    {
+        /*
+        the sorted keys of a flat container and the lookup index over them,
+        reindex() has to be called after every change of items()
+        */
+        template <typename K, typename Compare, typename Search>
+        class flat_keys
+        {
+            vector<K> m_items;
+            ASD_NO_UNIQUE_ADDRESS Compare m_compare;
+            ASD_NO_UNIQUE_ADDRESS typename Search::template index<K> m_index;
+
+        public:
+            explicit flat_keys(const Compare &compare)
+                : m_compare(compare)
+            {
+            }
+
+            vector<K> &items() noexcept
+            {
+                return m_items;
+            }
+
+            const vector<K> &items() const noexcept
+            {
+                return m_items;
+            }
+
+            const Compare &compare() const noexcept
+            {
+                return m_compare;
+            }
+
+            bool equivalent(const K &a, const K &b) const
+            {
+                return !m_compare(a, b) && !m_compare(b, a);
+            }
+
+            std::size_t lower_bound(const K &key) const
+            {
+                return m_index.lower_bound(m_items.data(), m_items.size(), key, m_compare);
+            }
+
+            /*
+            the position of key, or size() when it is missing
+            */
+            std::size_t find(const K &key) const
+            {
+                std::size_t pos = lower_bound(key);
+                return pos != m_items.size() && !m_compare(key, m_items[pos]) ? pos : m_items.size();
+            }
+
+            void reindex()
+            {
+                m_index.build(m_items.data(), m_items.size());
+            }
+        };
+    }
+
+    /*
+    class asd::flat_set<K, Compare, Search> keeps unique keys sorted in one asd::vector,
+    a lookup reads a few cache lines of contiguous keys instead of chasing the nodes of std::set
+    and the keys take no memory beyond their own, searching is done by the Search policy of asd::lookup
+    insert and erase move the keys after the position, so batches should go through insert_range,
+    which sorts the batch and merges it with the keys in O(n + m)
+    positions are indices like asd::vector, begin() and end() walk the keys in order
+    */
+    template <typename K, typename Compare = std::less<K>, typename Search = lookup::branchless>
+    class flat_set
+    {
+        detail::flat_keys<K, Compare, Search> m_keys;
+
+        /*
+        sorts the items and drops the equal ones in one pass
+        */
+        void normalize()
+        {
+            vector<K> &items = m_keys.items();
+            const Compare &compare = m_keys.compare();
+            std::sort(items.begin(), items.end(), compare);
+            // the items are sorted, so two neighbours are equal when the first is not less than the second
+            K *last = std::unique(items.begin(), items.end(), [&](const K &a, const K &b) { return !compare(a, b); });
+            items.erase(static_cast<std::size_t>(last - items.begin()), items.size());
+            m_keys.reindex();
+        }
+
+        /*
+        merges the sorted unique keys of batch, the keys already in the set are kept
+        */
+        void merge(vector<K> &batch)
+        {
+            vector<K> &items = m_keys.items();
+            const Compare &compare = m_keys.compare();
+            if (batch.empty())
+            {
+                return;
+            }
+            if (items.empty() || compare(items.back(), batch.front()))
+            {
+                // the batch goes after the last key, appending keeps the order
+                items.insert(items.size(), std::make_move_iterator(batch.begin()), std::make_move_iterator(batch.end()));
+                m_keys.reindex();
+                return;
+            }
+            vector<K> merged;
+            merged.reserve(items.size() + batch.size());
+            std::size_t i = 0;
+            std::size_t j = 0;
+            while (i < items.size() && j < batch.size())
+            {
+                if (compare(batch[j], items[i]))
+                {
+                    merged.push_back(std::move_if_noexcept(batch[j++]));
+                }
+                else
+                {
+                    if (!compare(items[i], batch[j]))
+                    {
+                        ++j;
+                    }
+                    merged.push_back(std::move_if_noexcept(items[i++]));
+                }
+            }
+            for (; i < items.size(); ++i)
+            {
+                merged.push_back(std::move_if_noexcept(items[i]));
+            }
+            for (; j < batch.size(); ++j)
+            {
+                merged.push_back(std::move_if_noexcept(batch[j]));
+            }
+            items.swap(merged);
+            m_keys.reindex();
+        }
+
+        template <typename U>
+        std::pair<std::size_t, bool> insert_key(U &&key)
+        {
+            std::size_t pos = m_keys.lower_bound(key);
+            vector<K> &items = m_keys.items();
+            if (pos != items.size() && !m_keys.compare()(key, items[pos]))
+            {
+                return {pos, false};
+            }
+            K item(std::forward<U>(key));
+            items.insert(pos, std::make_move_iterator(&item), std::make_move_iterator(&item + 1));
+            m_keys.reindex();
+            return {pos, true};
+        }
+
+    public:
+        using key_type = K;
+        using value_type = K;
+        using key_compare = Compare;
+        using size_type = std::size_t;
+        using iterator = const K *;
+        using const_iterator = const K *;
+
+        explicit flat_set(const Compare &compare = Compare())
+            : m_keys(compare)
+        {
+        }
+
+        /*
+        bulk construction, the keys are sorted once and one of every equal keys is kept
+        */
+        template <typename InputIt, typename = std::enable_if_t<is_iterator_v<InputIt>>>
+        flat_set(InputIt first, InputIt last, const Compare &compare = Compare())
+            : m_keys(compare)
+        {
+            m_keys.items().append(first, last);
+            normalize();
+        }
+
+        flat_set(std::initializer_list<K> keys, const Compare &compare = Compare())
+            : flat_set(keys.begin(), keys.end(), compare)
+        {
+        }
+
+        /*
+        takes the buffer of keys, it has no copy beyond the sort
+        */
+        explicit flat_set(vector<K> keys, const Compare &compare = Compare())
+            : m_keys(compare)
+        {
+            m_keys.items().swap(keys);
+            normalize();
+        }
+
+        /*
+        takes keys that are sorted and unique already, nothing is sorted or copied
+        */
+        flat_set(sorted_unique_t, vector<K> keys, const Compare &compare = Compare())
+            : m_keys(compare)
+        {
+            m_keys.items().swap(keys);
+            m_keys.reindex();
+        }
+
+        std::size_t size() const noexcept
+        {
+            return m_keys.items().size();
+        }
+
+        bool empty() const noexcept
+        {
+            return m_keys.items().empty();
+        }
+
+        const K *data() const noexcept
+        {
+            return m_keys.items().data();
+        }
+
+        const K *begin() const noexcept
+        {
+            return m_keys.items().begin();
+        }
+
+        const K *end() const noexcept
+        {
+            return m_keys.items().end();
+        }
+
+        /*
+        the key at sorted position pos
+        */
+        const K &operator[](std::size_t pos) const noexcept
+        {
+            return m_keys.items()[pos];
+        }
+
+        const vector<K> &keys() const noexcept
+        {
+            return m_keys.items();
+        }
+
+        const Compare &key_comp() const noexcept
+        {
+            return m_keys.compare();
+        }
+
+        /*
+        the position of the first key not less than key, size() when there is none
+        */
+        std::size_t lower_bound(const K &key) const
+        {
+            return m_keys.lower_bound(key);
+        }
+
+        /*
+        the position of key, size() when it is missing
+        */
+        std::size_t find(const K &key) const
+        {
+            return m_keys.find(key);
+        }
+
+        bool contains(const K &key) const
+        {
+            return m_keys.find(key) != size();
+        }
+
+        std::size_t count(const K &key) const
+        {
+            return contains(key) ? 1 : 0;
+        }
+
+        /*
+        adds key unless an equal key is there, it returns the position of the key and whether it was added
+        it raises the bad_alloc exception
+        */
+        std::pair<std::size_t, bool> insert(const K &key)
+        {
+            return insert_key(key);
+        }
+
+        std::pair<std::size_t, bool> insert(K &&key)
+        {
+            return insert_key(std::move(key));
+        }
+
+        /*
+        adds the keys of [first, last) that are not there, the batch is sorted and merged with the keys in one pass
+        it raises the bad_alloc exception
+        */
+        template <typename InputIt, typename = std::enable_if_t<is_iterator_v<InputIt>>>
+        void insert_range(InputIt first, InputIt last)
+        {
+            flat_set batch(first, last, m_keys.compare());
+            merge(batch.m_keys.items());
+        }
+
+        void insert_range(std::initializer_list<K> keys)
+        {
+            insert_range(keys.begin(), keys.end());
+        }
+
+        /*
+        removes key, it returns the number of keys removed
+        */
+        std::size_t erase(const K &key)
+        {
+            std::size_t pos = m_keys.find(key);
+            if (pos == size())
+            {
+                return 0;
+            }
+            m_keys.items().erase(pos);
+            m_keys.reindex();
+            return 1;
+        }
+
+        void reserve(std::size_t n)
+        {
+            m_keys.items().reserve(n);
+        }
+
+        void clear() noexcept
+        {
+            m_keys.items().erase(0, m_keys.items().size());
+            m_keys.reindex();
+        }
+    };
+
+    /*
+    class asd::flat_map<K, V, Compare, Search> keeps unique keys sorted in one asd::vector and their values
+    in another one at the same positions, a lookup scans the keys alone, so the values never pollute the cache
+    until the key is found, searching is done by the Search policy of asd::lookup
+    insert and erase move the items after the position, so batches should go through insert_range,
+    which sorts the batch and merges it with the items in O(n + m)
+    positions are indices like asd::vector, keys() and values() give the two arrays in key order
+    */
+    template <typename K, typename V, typename Compare = std::less<K>, typename Search = lookup::branchless>
+    class flat_map
+    {
+        detail::flat_keys<K, Compare, Search> m_keys;
+        vector<V> m_values;
+
+        /*
+        sorts the pairs by their keys and moves them to the two arrays in one pass,
+        the first of every equal keys is kept like std::map does
+        */
+        void adopt(vector<std::pair<K, V>> &pairs)
+        {
+            const Compare &compare = m_keys.compare();
+            std::stable_sort(pairs.begin(), pairs.end(), [&](const std::pair<K, V> &a, const std::pair<K, V> &b) {
+                return compare(a.first, b.first);
+            });
+            vector<K> &keys = m_keys.items();
+            keys.reserve(pairs.size());
+            m_values.reserve(pairs.size());
+            for (std::pair<K, V> &pair : pairs)
+            {
+                if (keys.empty() || compare(keys.back(), pair.first))
+                {
+                    keys.push_back(std::move(pair.first));
+                    m_values.push_back(std::move(pair.second));
+                }
+            }
+            m_keys.reindex();
+        }
+
+        /*
+        merges the sorted unique items of batch, the keys already in the map keep their values
+        */
+        void merge(flat_map &batch)
+        {
+            vector<K> &keys = m_keys.items();
+            vector<K> &batch_keys = batch.m_keys.items();
+            const Compare &compare = m_keys.compare();
+            if (batch_keys.empty())
+            {
+                return;
+            }
+            if (keys.empty() || compare(keys.back(), batch_keys.front()))
+            {
+                // the batch goes after the last key, appending keeps the order
+                std::size_t old_count = keys.size();
+                keys.insert(old_count, std::make_move_iterator(batch_keys.begin()), std::make_move_iterator(batch_keys.end()));
+                try
+                {
+                    m_values.insert(old_count, std::make_move_iterator(batch.m_values.begin()), std::make_move_iterator(batch.m_values.end()));
+                }
+                catch (...)
+                {
+                    keys.erase(old_count, keys.size());
+                    throw;
+                }
+                m_keys.reindex();
+                return;
+            }
+            vector<K> merged_keys;
+            vector<V> merged_values;
+            merged_keys.reserve(keys.size() + batch_keys.size());
+            merged_values.reserve(keys.size() + batch_keys.size());
+            std::size_t i = 0;
+            std::size_t j = 0;
+            while (i < keys.size() && j < batch_keys.size())
+            {
+                if (compare(batch_keys[j], keys[i]))
+                {
+                    merged_keys.push_back(std::move_if_noexcept(batch_keys[j]));
+                    merged_values.push_back(std::move_if_noexcept(batch.m_values[j++]));
+                }
+                else
+                {
+                    if (!compare(keys[i], batch_keys[j]))
+                    {
+                        ++j;
+                    }
+                    merged_keys.push_back(std::move_if_noexcept(keys[i]));
+                    merged_values.push_back(std::move_if_noexcept(m_values[i++]));
+                }
+            }
+            for (; i < keys.size(); ++i)
+            {
+                merged_keys.push_back(std::move_if_noexcept(keys[i]));
+                merged_values.push_back(std::move_if_noexcept(m_values[i]));
+            }
+            for (; j < batch_keys.size(); ++j)
+            {
+                merged_keys.push_back(std::move_if_noexcept(batch_keys[j]));
+                merged_values.push_back(std::move_if_noexcept(batch.m_values[j]));
+            }
+            keys.swap(merged_keys);
+            m_values.swap(merged_values);
+            m_keys.reindex();
+        }
+
+        /*
+        the key and the value are constructed before any item moves, so a failure leaves the map as it was
+        */
+        template <typename U, typename... Args>
+        std::pair<std::size_t, bool> emplace_key(U &&key, Args &&...args)
+        {
+            std::size_t pos = m_keys.lower_bound(key);
+            vector<K> &keys = m_keys.items();
+            if (pos != keys.size() && !m_keys.compare()(key, keys[pos]))
+            {
+                return {pos, false};
+            }
+            K key_item(std::forward<U>(key));
+            V value_item(std::forward<Args>(args)...);
+            keys.insert(pos, std::make_move_iterator(&key_item), std::make_move_iterator(&key_item + 1));
+            try
+            {
+                m_values.insert(pos, std::make_move_iterator(&value_item), std::make_move_iterator(&value_item + 1));
+            }
+            catch (...)
+            {
+                keys.erase(pos);
+                throw;
+            }
+            m_keys.reindex();
+            return {pos, true};
+        }
+
+    public:
+        using key_type = K;
+        using mapped_type = V;
+        using key_compare = Compare;
+        using size_type = std::size_t;
+
+        explicit flat_map(const Compare &compare = Compare())
+            : m_keys(compare)
+        {
+        }
+
+        /*
+        bulk construction from pairs, the pairs are sorted once and the first of every equal keys is kept
+        */
+        template <typename InputIt, typename = std::enable_if_t<is_iterator_v<InputIt>>>
+        flat_map(InputIt first, InputIt last, const Compare &compare = Compare())
+            : m_keys(compare)
+        {
+            vector<std::pair<K, V>> pairs;
+            pairs.append(first, last);
+            adopt(pairs);
+        }
+
+        flat_map(std::initializer_list<std::pair<K, V>> pairs, const Compare &compare = Compare())
+            : flat_map(pairs.begin(), pairs.end(), compare)
+        {
+        }
+
+        /*
+        takes the buffers of keys and values that are sorted and unique already, nothing is sorted or copied
+        it raises the invalid_argument exception when their sizes differ
+        */
+        flat_map(sorted_unique_t, vector<K> keys, vector<V> values, const Compare &compare = Compare())
+            : m_keys(compare)
+        {
+            if (keys.size() != values.size())
+            {
+                throw std::invalid_argument("flat_map keys and values differ in size");
+            }
+            m_keys.items().swap(keys);
+            m_values.swap(values);
+            m_keys.reindex();
+        }
+
+        std::size_t size() const noexcept
+        {
+            return m_values.size();
+        }
+
+        bool empty() const noexcept
+        {
+            return m_values.empty();
+        }
+
+        const vector<K> &keys() const noexcept
+        {
+            return m_keys.items();
+        }
+
+        /*
+        the values in the order of their keys, they may be changed in place but not resized
+        */
+        vector<V> &values() noexcept
+        {
+            return m_values;
+        }
+
+        const vector<V> &values() const noexcept
+        {
+            return m_values;
+        }
+
+        const K &key(std::size_t pos) const noexcept
+        {
+            return m_keys.items()[pos];
+        }
+
+        V &value(std::size_t pos) noexcept
+        {
+            return m_values[pos];
+        }
+
+        const V &value(std::size_t pos) const noexcept
+        {
+            return m_values[pos];
+        }
+
+        const Compare &key_comp() const noexcept
+        {
+            return m_keys.compare();
+        }
+
+        /*
+        the position of the first key not less than key, size() when there is none
+        */
+        std::size_t lower_bound(const K &key) const
+        {
+            return m_keys.lower_bound(key);
+        }
+
+        /*
+        the position of key, size() when it is missing
+        */
+        std::size_t find(const K &key) const
+        {
+            return m_keys.find(key);
+        }
+
+        bool contains(const K &key) const
+        {
+            return m_keys.find(key) != size();
+        }
+
+        std::size_t count(const K &key) const
+        {
+            return contains(key) ? 1 : 0;
+        }
+
+        /*
+        the value of key, nullptr when it is missing
+        */
+        V *get(const K &key)
+        {
+            std::size_t pos = m_keys.find(key);
+            return pos != size() ? &m_values[pos] : nullptr;
+        }
+
+        const V *get(const K &key) const
+        {
+            std::size_t pos = m_keys.find(key);
+            return pos != size() ? &m_values[pos] : nullptr;
+        }
+
+        /*
+        it raises the out_of_range exception when key is missing
+        */
+        V &at(const K &key)
+        {
+            V *value = get(key);
+            if (value == nullptr)
+            {
+                throw std::out_of_range("flat_map key is missing");
+            }
+            return *value;
+        }
+
+        const V &at(const K &key) const
+        {
+            const V *value = get(key);
+            if (value == nullptr)
+            {
+                throw std::out_of_range("flat_map key is missing");
+            }
+            return *value;
+        }
+
+        /*
+        the value of key, a value initialized one is added when key is missing
+        */
+        V &operator[](const K &key)
+        {
+            return m_values[emplace_key(key).first];
+        }
+
+        V &operator[](K &&key)
+        {
+            return m_values[emplace_key(std::move(key)).first];
+        }
+
+        /*
+        adds key with a value constructed from args unless an equal key is there,
+        it returns the position of the key and whether it was added
+        it raises the bad_alloc exception
+        */
+        template <typename... Args>
+        std::pair<std::size_t, bool> try_emplace(const K &key, Args &&...args)
+        {
+            return emplace_key(key, std::forward<Args>(args)...);
+        }
+
+        template <typename... Args>
+        std::pair<std::size_t, bool> try_emplace(K &&key, Args &&...args)
+        {
+            return emplace_key(std::move(key), std::forward<Args>(args)...);
+        }
+
+        template <typename U>
+        std::pair<std::size_t, bool> insert(const K &key, U &&value)
+        {
+            return emplace_key(key, std::forward<U>(value));
+        }
+
+        /*
+        like insert, but the value of a key that is there already is replaced
+        */
+        template <typename U>
+        std::pair<std::size_t, bool> insert_or_assign(const K &key, U &&value)
+        {
+            std::size_t pos = m_keys.find(key);
+            if (pos != size())
+            {
+                m_values[pos] = std::forward<U>(value);
+                return {pos, false};
+            }
+            return emplace_key(key, std::forward<U>(value));
+        }
+
+        /*
+        adds the pairs of [first, last) whose keys are not there, the batch is sorted and merged with the items in one pass
+        it raises the bad_alloc exception
+        */
+        template <typename InputIt, typename = std::enable_if_t<is_iterator_v<InputIt>>>
+        void insert_range(InputIt first, InputIt last)
+        {
+            flat_map batch(first, last, m_keys.compare());
+            merge(batch);
+        }
+
+        void insert_range(std::initializer_list<std::pair<K, V>> pairs)
+        {
+            insert_range(pairs.begin(), pairs.end());
+        }
+
+        /*
+        removes key and its value, it returns the number of items removed
+        */
+        std::size_t erase(const K &key)
+        {
+            std::size_t pos = m_keys.find(key);
+            if (pos == size())
+            {
+                return 0;
+            }
+            m_keys.items().erase(pos);
+            m_values.erase(pos);
+            m_keys.reindex();
+            return 1;
+        }
+
+        void reserve(std::size_t n)
+        {
+            m_keys.items().reserve(n);
+            m_values.reserve(n);
+        }
+
+        void clear() noexcept
+        {
+            m_keys.items().erase(0, m_keys.items().size());
+            m_values.erase(0, m_values.size());
+            m_keys.reindex();
+        }
+    };
+}
+
+#endif //ifndef ASD_FLAT_MAP_2023
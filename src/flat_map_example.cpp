@@ -0,0 +1,138 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <random>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <assert.h>
+#include "flat_map.hpp"
+
+// checks every lookup of a flat set against std::set, keys from 0 to limit
+template <typename Set>
+void check_lookups(const Set &set, const std::set<int> &stdSet, int limit)
+{
+    assert(set.size() == stdSet.size() && std::equal(stdSet.begin(), stdSet.end(), set.begin()));
+    for (int key = -1; key <= limit; ++key)
+    {
+        std::size_t expected = static_cast<std::size_t>(std::distance(stdSet.begin(), stdSet.lower_bound(key)));
+        assert(set.lower_bound(key) == expected);
+        assert(set.contains(key) == (stdSet.count(key) == 1));
+        assert(set.find(key) == (stdSet.count(key) == 1 ? expected : set.size()));
+    }
+}
+
+int main()
+{
+    // Test bulk construction sorts and drops equal keys for every lookup policy
+    std::mt19937 random(11);
+    for (std::size_t n : {0, 1, 2, 3, 7, 8, 15, 16, 17, 100, 1000, 4097})
+    {
+        std::vector<int> stdVec1;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            stdVec1.push_back(static_cast<int>(random() % (2 * n + 1)));
+        }
+        std::set<int> stdSet1(stdVec1.begin(), stdVec1.end());
+        int limit = static_cast<int>(2 * n + 2);
+        check_lookups(asd::flat_set<int, std::less<int>, asd::lookup::binary>(stdVec1.begin(), stdVec1.end()), stdSet1, limit);
+        check_lookups(asd::flat_set<int>(stdVec1.begin(), stdVec1.end()), stdSet1, limit);
+        check_lookups(asd::flat_set<int, std::less<int>, asd::lookup::eytzinger>(stdVec1.begin(), stdVec1.end()), stdSet1, limit);
+    }
+    asd::flat_set<std::string, std::greater<std::string>, asd::lookup::eytzinger> mySet1{"b", "c", "a", "c"};
+    assert(mySet1.size() == 3 && mySet1[0] == "c" && mySet1[2] == "a" && mySet1.find("b") == 1 && mySet1.find("d") == 3);
+
+    // Test insert and erase keep the keys sorted and the index in step
+    asd::flat_set<int, std::less<int>, asd::lookup::eytzinger> mySet2;
+    std::set<int> stdSet2;
+    for (int i = 0; i < 2000; ++i)
+    {
+        int key = static_cast<int>(random() % 500);
+        if (i % 3 == 0)
+        {
+            assert(mySet2.erase(key) == stdSet2.erase(key));
+        }
+        else
+        {
+            std::pair<std::size_t, bool> result = mySet2.insert(key);
+            assert(result.second == stdSet2.insert(key).second && mySet2[result.first] == key);
+        }
+    }
+    check_lookups(mySet2, stdSet2, 501);
+    mySet2.clear();
+    assert(mySet2.empty() && !mySet2.contains(1) && mySet2.insert(1).second && mySet2.contains(1));
+
+    // Test insert_range merges a batch, appends a batch past the last key and keeps the keys already there
+    asd::vector<int> myVec1;
+    myVec1.assign({9, 1, 5, 3, 7});
+    asd::flat_set<int> mySet3(std::move(myVec1));
+    mySet3.insert_range({4, 5, 2, 4, 100});
+    std::vector<int> expected{1, 2, 3, 4, 5, 7, 9, 100};
+    assert(std::equal(expected.begin(), expected.end(), mySet3.begin(), mySet3.end()));
+    mySet3.insert_range({200, 101});
+    assert(mySet3.size() == 10 && mySet3[8] == 101 && mySet3.find(200) == 9);
+    asd::vector<int> myVec2;
+    myVec2.assign({1, 2, 3});
+    asd::flat_set<int> mySet4(asd::sorted_unique, std::move(myVec2));
+    assert(mySet4.size() == 3 && mySet4.count(2) == 1 && mySet4.count(4) == 0);
+
+    // Test flat_map keeps the values in step with the keys and matches std::map
+    asd::flat_map<std::string, int> myMap1{{"one", 1}, {"two", 2}, {"three", 3}, {"one", 10}};
+    assert(myMap1.size() == 3 && myMap1.at("one") == 1 && myMap1.key(0) == "one" && myMap1.value(1) == 3);
+    assert(myMap1.get("four") == nullptr && *myMap1.get("two") == 2);
+    myMap1["four"] = 4;
+    ++myMap1["one"];
+    assert(myMap1.size() == 4 && myMap1.at("one") == 2 && myMap1.keys()[0] == "four" && myMap1.values()[0] == 4);
+    assert(!myMap1.insert("two", 20).second && myMap1.at("two") == 2);
+    assert(!myMap1.insert_or_assign("two", 20).second && myMap1.at("two") == 20);
+    assert(myMap1.try_emplace("five", 5).second && myMap1.erase("three") == 1 && myMap1.erase("three") == 0);
+    bool thrown = false;
+    try
+    {
+        myMap1.at("three");
+    }
+    catch (const std::out_of_range &)
+    {
+        thrown = true;
+    }
+    assert(thrown);
+    std::map<int, std::string> stdMap1;
+    asd::flat_map<int, std::string, std::less<int>, asd::lookup::eytzinger> myMap2;
+    for (int round = 0; round < 20; ++round)
+    {
+        std::vector<std::pair<int, std::string>> batch;
+        for (int i = 0; i < 100; ++i)
+        {
+            int key = static_cast<int>(random() % 3000);
+            batch.emplace_back(key, std::to_string(key * 7 + round));
+        }
+        for (const std::pair<int, std::string> &item : batch)
+        {
+            stdMap1.insert(item);
+        }
+        myMap2.insert_range(batch.begin(), batch.end());
+        myMap2.erase(round);
+        stdMap1.erase(round);
+    }
+    assert(myMap2.size() == stdMap1.size());
+    std::size_t pos = 0;
+    for (const std::pair<const int, std::string> &item : stdMap1)
+    {
+        assert(myMap2.key(pos) == item.first && myMap2.value(pos) == item.second && myMap2.find(item.first) == pos);
+        ++pos;
+    }
+    asd::vector<int> keys;
+    asd::vector<double> values;
+    keys.assign({1, 2, 3});
+    values.assign({0.5, 1.5, 2.5});
+    asd::flat_map<int, double> myMap3(asd::sorted_unique, std::move(keys), std::move(values));
+    assert(myMap3.at(2) == 1.5 && myMap3.lower_bound(0) == 0 && myMap3.lower_bound(4) == 3);
+    myMap3.insert_range({{5, 4.5}, {4, 3.5}});
+    assert(myMap3.size() == 5 && myMap3.at(5) == 4.5 && myMap3.value(3) == 3.5);
+
+    std::cout << "flat_map examples done" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,484 @@
+/*
+ * Copyright (C) 2023 Sofyan Gaber <sofyanhalaby@gmail.com>
+ *
+ * This code is for demonstration and educational purposes. It 
+ * implements opt-in allocation and reallocation instrumentation.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ASD_INSTRUMENTATION_2023
+#define ASD_INSTRUMENTATION_2023
+
+/*
+instrumentation of asd::allocator and the reallocations of asd containers
+it is disabled by default and costs nothing then, define ASD_VECTOR_INSTRUMENTATION
+for the whole program (before including any asd header) to enable it
+stats are kept per call-site tag, set by asd::instrumentation::scoped_tag on the current thread
+the memory registry adds up the storage of the live asd::vector buffers per element type and tag
+*/
+#ifdef ASD_VECTOR_INSTRUMENTATION
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#if defined(__has_include)
+#if __has_include(<cxxabi.h>)
+#include <cxxabi.h>
+#define ASD_INSTRUMENTATION_DEMANGLE 1
+#endif
+#endif
+
+namespace asd
+{
+    namespace instrumentation
+    {
+        /*
+        snapshot of the counters of one tag
+        */
+        struct stats
+        {
+            std::size_t allocations = 0; // number of allocations, a reallocation counts as one
+            std::size_t deallocations = 0; // number of deallocations, a reallocation counts as one
+            std::size_t allocated_bytes = 0; // total bytes allocated
+            std::size_t deallocated_bytes = 0; // total bytes deallocated
+            std::size_t reallocations = 0; // number of container reallocations (growth and shrink)
+            std::size_t moved_bytes = 0; // bytes of items relocated by container reallocations
+            std::size_t slack_bytes = 0; // unused capacity bytes left by container growths
+            std::size_t peak_capacity_bytes = 0; // largest capacity a container reached, in bytes
+        };
+
+        /*
+        passed to the reallocation callback
+        */
+        struct reallocation_event
+        {
+            const char *tag; // tag of the thread doing the reallocation
+            std::size_t item_size;
+            std::size_t count; // number of items relocated
+            std::size_t old_capacity;
+            std::size_t new_capacity;
+        };
+
+        using reallocation_callback = void (*)(const reallocation_event &);
+
+        /*
+        the storage of the live containers of one element type and tag
+        */
+        struct memory_stats
+        {
+            std::string type; // element type, demangled where the compiler tells how
+            std::string tag; // tag of the thread that allocated the storage
+            std::size_t containers = 0; // number of live buffers
+            std::size_t capacity_bytes = 0; // capacity * sizeof(T) of the live buffers
+            std::size_t usable_bytes = 0; // bytes the allocator really reserved for them
+            std::size_t peak_usable_bytes = 0; // largest usable_bytes reached
+        };
+
+        namespace detail
+        {
+            struct counters
+            {
+                std::atomic<std::size_t> allocations{0};
+                std::atomic<std::size_t> deallocations{0};
+                std::atomic<std::size_t> allocated_bytes{0};
+                std::atomic<std::size_t> deallocated_bytes{0};
+                std::atomic<std::size_t> reallocations{0};
+                std::atomic<std::size_t> moved_bytes{0};
+                std::atomic<std::size_t> slack_bytes{0};
+                std::atomic<std::size_t> peak_capacity_bytes{0};
+
+                stats load() const noexcept
+                {
+                    stats result;
+                    result.allocations = allocations.load(std::memory_order_relaxed);
+                    result.deallocations = deallocations.load(std::memory_order_relaxed);
+                    result.allocated_bytes = allocated_bytes.load(std::memory_order_relaxed);
+                    result.deallocated_bytes = deallocated_bytes.load(std::memory_order_relaxed);
+                    result.reallocations = reallocations.load(std::memory_order_relaxed);
+                    result.moved_bytes = moved_bytes.load(std::memory_order_relaxed);
+                    result.slack_bytes = slack_bytes.load(std::memory_order_relaxed);
+                    result.peak_capacity_bytes = peak_capacity_bytes.load(std::memory_order_relaxed);
+                    return result;
+                }
+
+                void clear() noexcept
+                {
+                    allocations = 0;
+                    deallocations = 0;
+                    allocated_bytes = 0;
+                    deallocated_bytes = 0;
+                    reallocations = 0;
+                    moved_bytes = 0;
+                    slack_bytes = 0;
+                    peak_capacity_bytes = 0;
+                }
+            };
+
+            /*
+            process wide map from tag to its counters, counters are never removed so threads can keep pointers to them
+            */
+            class registry
+            {
+                std::mutex m_mutex;
+                std::map<std::string, std::unique_ptr<counters>> m_tags;
+
+            public:
+                std::atomic<reallocation_callback> callback{nullptr};
+
+                static registry &instance()
+                {
+                    static registry the_registry;
+                    return the_registry;
+                }
+
+                counters &find(const char *tag)
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    std::unique_ptr<counters> &entry = m_tags[tag];
+                    if (!entry)
+                    {
+                        entry = std::make_unique<counters>();
+                    }
+                    return *entry;
+                }
+
+                std::vector<std::pair<std::string, stats>> snapshot()
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    std::vector<std::pair<std::string, stats>> result;
+                    result.reserve(m_tags.size());
+                    for (const auto &entry : m_tags)
+                    {
+                        result.emplace_back(entry.first, entry.second->load());
+                    }
+                    return result;
+                }
+
+                void clear()
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    for (const auto &entry : m_tags)
+                    {
+                        entry.second->clear();
+                    }
+                }
+            };
+
+            inline constexpr const char *untagged = "untagged";
+
+            struct thread_state
+            {
+                const char *tag = untagged;
+                counters *current = nullptr;
+            };
+
+            inline thread_local thread_state this_thread;
+
+            inline counters &current()
+            {
+                if (this_thread.current == nullptr)
+                {
+                    this_thread.current = &registry::instance().find(this_thread.tag);
+                }
+                return *this_thread.current;
+            }
+
+            inline std::string type_name(const std::type_index &type)
+            {
+#ifdef ASD_INSTRUMENTATION_DEMANGLE
+                int status = 0;
+                std::unique_ptr<char, void (*)(void *)> name(abi::__cxa_demangle(type.name(), nullptr, nullptr, &status), std::free);
+                if (status == 0 && name)
+                {
+                    return name.get();
+                }
+#endif
+                return type.name();
+            }
+
+            /*
+            process wide record of every live container buffer, keyed by its address so a buffer is taken off
+            the type and tag it was allocated for, whichever thread releases it
+            */
+            class memory_registry
+            {
+                struct totals
+                {
+                    std::size_t containers = 0;
+                    std::size_t capacity_bytes = 0;
+                    std::size_t usable_bytes = 0;
+                    std::size_t peak_usable_bytes = 0;
+                };
+
+                struct buffer
+                {
+                    totals *owner;
+                    std::size_t capacity_bytes;
+                    std::size_t usable_bytes;
+                };
+
+                std::mutex m_mutex;
+                std::map<std::pair<std::type_index, std::string>, totals> m_totals; // nodes are stable, buffers point to them
+                std::unordered_map<const void *, buffer> m_buffers;
+
+                static void release(const buffer &entry) noexcept
+                {
+                    entry.owner->containers--;
+                    entry.owner->capacity_bytes -= entry.capacity_bytes;
+                    entry.owner->usable_bytes -= entry.usable_bytes;
+                }
+
+            public:
+                static memory_registry &instance()
+                {
+                    static memory_registry the_registry;
+                    return the_registry;
+                }
+
+                /*
+                a buffer that can't be recorded for lack of memory is left out, the diagnostics never fail an allocation
+                */
+                void add(const std::type_info &type, const void *ptr, std::size_t capacity_bytes, std::size_t usable_bytes) noexcept
+                {
+                    if (ptr == nullptr)
+                    {
+                        return;
+                    }
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    try
+                    {
+                        totals &owner = m_totals[std::make_pair(std::type_index(type), std::string(this_thread.tag))];
+                        auto slot = m_buffers.try_emplace(ptr, buffer{&owner, 0, 0});
+                        if (!slot.second)
+                        {
+                            // the address was freed without being removed and handed out again, its old buffer is gone
+                            release(slot.first->second);
+                        }
+                        slot.first->second = buffer{&owner, capacity_bytes, usable_bytes};
+                        owner.containers++;
+                        owner.capacity_bytes += capacity_bytes;
+                        owner.usable_bytes += usable_bytes;
+                        owner.peak_usable_bytes = std::max(owner.peak_usable_bytes, owner.usable_bytes);
+                    }
+                    catch (const std::bad_alloc &)
+                    {
+                    }
+                }
+
+                void remove(const void *ptr) noexcept
+                {
+                    if (ptr == nullptr)
+                    {
+                        return;
+                    }
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    auto found = m_buffers.find(ptr);
+                    if (found == m_buffers.end())
+                    {
+                        return;
+                    }
+                    release(found->second);
+                    m_buffers.erase(found);
+                }
+
+                std::vector<memory_stats> snapshot()
+                {
+                    std::vector<std::pair<std::pair<std::type_index, std::string>, totals>> entries;
+                    {
+                        std::lock_guard<std::mutex> lock(m_mutex);
+                        entries.assign(m_totals.begin(), m_totals.end());
+                    }
+                    std::vector<memory_stats> result;
+                    result.reserve(entries.size());
+                    for (const auto &entry : entries)
+                    {
+                        memory_stats stats;
+                        stats.type = type_name(entry.first.first);
+                        stats.tag = entry.first.second;
+                        stats.containers = entry.second.containers;
+                        stats.capacity_bytes = entry.second.capacity_bytes;
+                        stats.usable_bytes = entry.second.usable_bytes;
+                        stats.peak_usable_bytes = entry.second.peak_usable_bytes;
+                        result.push_back(std::move(stats));
+                    }
+                    std::stable_sort(result.begin(), result.end(), [](const memory_stats &lhs, const memory_stats &rhs) {
+                        return lhs.usable_bytes > rhs.usable_bytes;
+                    });
+                    return result;
+                }
+            };
+
+            inline void on_allocate(std::size_t bytes)
+            {
+                counters &target = current();
+                target.allocations.fetch_add(1, std::memory_order_relaxed);
+                target.allocated_bytes.fetch_add(bytes, std::memory_order_relaxed);
+            }
+
+            inline void on_deallocate(std::size_t bytes)
+            {
+                counters &target = current();
+                target.deallocations.fetch_add(1, std::memory_order_relaxed);
+                target.deallocated_bytes.fetch_add(bytes, std::memory_order_relaxed);
+            }
+
+            inline void on_reallocate(std::size_t old_bytes, std::size_t new_bytes)
+            {
+                if (old_bytes != 0)
+                {
+                    on_deallocate(old_bytes);
+                }
+                on_allocate(new_bytes);
+            }
+
+            inline void on_container_reallocate(std::size_t item_size, std::size_t count, std::size_t old_capacity, std::size_t new_capacity)
+            {
+                counters &target = current();
+                target.reallocations.fetch_add(1, std::memory_order_relaxed);
+                target.moved_bytes.fetch_add(count * item_size, std::memory_order_relaxed);
+                if (new_capacity > old_capacity)
+                {
+                    target.slack_bytes.fetch_add((new_capacity - count) * item_size, std::memory_order_relaxed);
+                }
+                std::size_t capacity_bytes = new_capacity * item_size;
+                std::size_t peak = target.peak_capacity_bytes.load(std::memory_order_relaxed);
+                while (peak < capacity_bytes &&
+                       !target.peak_capacity_bytes.compare_exchange_weak(peak, capacity_bytes, std::memory_order_relaxed))
+                {
+                }
+                reallocation_callback callback = registry::instance().callback.load(std::memory_order_acquire);
+                if (callback != nullptr)
+                {
+                    callback(reallocation_event{this_thread.tag, item_size, count, old_capacity, new_capacity});
+                }
+            }
+        }
+
+        /*
+        tags the allocations and reallocations of the current thread until it goes out of scope,
+        tags nest, the previous tag is restored on destruction
+        the tag string must outlive the scope, a string literal is the easy choice
+        */
+        class scoped_tag
+        {
+            detail::thread_state m_previous;
+
+        public:
+            explicit scoped_tag(const char *tag)
+                : m_previous(detail::this_thread)
+            {
+                detail::this_thread.tag = tag;
+                detail::this_thread.current = &detail::registry::instance().find(tag);
+            }
+
+            scoped_tag(const scoped_tag &) = delete;
+            scoped_tag &operator=(const scoped_tag &) = delete;
+
+            ~scoped_tag() noexcept
+            {
+                detail::this_thread = m_previous;
+            }
+        };
+
+        /*
+        returns the stats of every tag seen so far, to be exported to a metrics pipeline
+        */
+        inline std::vector<std::pair<std::string, stats>> snapshot()
+        {
+            return detail::registry::instance().snapshot();
+        }
+
+        /*
+        returns the stats of one tag
+        */
+        inline stats snapshot(const char *tag)
+        {
+            return detail::registry::instance().find(tag).load();
+        }
+
+        /*
+        returns the storage of the live containers per element type and tag, the largest first
+        */
+        inline std::vector<memory_stats> memory_snapshot()
+        {
+            return detail::memory_registry::instance().snapshot();
+        }
+
+        /*
+        writes memory_snapshot() as a table, one line per element type and tag, e.g. for an admin endpoint
+        overhead is what the allocator reserved past the capacity
+        */
+        inline void dump_memory(std::ostream &out)
+        {
+            std::vector<memory_stats> entries = memory_snapshot();
+            out << "containers\tcapacity_bytes\tusable_bytes\toverhead_bytes\tpeak_usable_bytes\ttag\ttype\n";
+            for (const memory_stats &entry : entries)
+            {
+                out << entry.containers << '\t' << entry.capacity_bytes << '\t' << entry.usable_bytes << '\t'
+                    << entry.usable_bytes - entry.capacity_bytes << '\t' << entry.peak_usable_bytes << '\t'
+                    << entry.tag << '\t' << entry.type << '\n';
+            }
+        }
+
+        /*
+        zeroes the counters of every tag
+        */
+        inline void reset()
+        {
+            detail::registry::instance().clear();
+        }
+
+        /*
+        sets the function called on every container reallocation, nullptr removes it
+        the callback runs on the reallocating thread, keep it cheap
+        */
+        inline void set_reallocation_callback(reallocation_callback callback) noexcept
+        {
+            detail::registry::instance().callback.store(callback, std::memory_order_release);
+        }
+    }
+}
+
+#define ASD_INSTRUMENT_ALLOCATE(bytes) ::asd::instrumentation::detail::on_allocate(bytes)
+#define ASD_INSTRUMENT_DEALLOCATE(bytes) ::asd::instrumentation::detail::on_deallocate(bytes)
+#define ASD_INSTRUMENT_REALLOCATE(old_bytes, new_bytes) ::asd::instrumentation::detail::on_reallocate(old_bytes, new_bytes)
+#define ASD_INSTRUMENT_CONTAINER_REALLOCATE(item_size, count, old_capacity, new_capacity) \
+    ::asd::instrumentation::detail::on_container_reallocate(item_size, count, old_capacity, new_capacity)
+#define ASD_INSTRUMENT_STORAGE_ALLOCATE(type, ptr, capacity_bytes, usable_bytes) \
+    ::asd::instrumentation::detail::memory_registry::instance().add(typeid(type), ptr, capacity_bytes, usable_bytes)
+#define ASD_INSTRUMENT_STORAGE_DEALLOCATE(ptr) ::asd::instrumentation::detail::memory_registry::instance().remove(ptr)
+#else
+#define ASD_INSTRUMENT_ALLOCATE(bytes) ((void)0)
+#define ASD_INSTRUMENT_DEALLOCATE(bytes) ((void)0)
+#define ASD_INSTRUMENT_REALLOCATE(old_bytes, new_bytes) ((void)0)
+#define ASD_INSTRUMENT_CONTAINER_REALLOCATE(item_size, count, old_capacity, new_capacity) ((void)0)
+#define ASD_INSTRUMENT_STORAGE_ALLOCATE(type, ptr, capacity_bytes, usable_bytes) ((void)0)
+#define ASD_INSTRUMENT_STORAGE_DEALLOCATE(ptr) ((void)0)
+#endif //ifdef ASD_VECTOR_INSTRUMENTATION
+#endif //ifndef ASD_INSTRUMENTATION_2023
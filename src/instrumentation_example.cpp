@@ -0,0 +1,155 @@
+
+// instrumentation must be enabled for the whole program, before including any asd header
+#define ASD_VECTOR_INSTRUMENTATION
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <assert.h>
+#include "vector.hpp"
+
+namespace
+{
+    std::size_t reallocationEvents = 0;
+
+    void countReallocation(const asd::instrumentation::reallocation_event &event)
+    {
+        assert(event.new_capacity >= event.count);
+        ++reallocationEvents;
+    }
+
+    // the registry entry of one element type and tag, a zero entry if there is none
+    asd::instrumentation::memory_stats liveMemory(const std::string &type, const std::string &tag)
+    {
+        for (const auto &entry : asd::instrumentation::memory_snapshot())
+        {
+            if (entry.type == type && entry.tag == tag)
+            {
+                return entry;
+            }
+        }
+        return asd::instrumentation::memory_stats();
+    }
+}
+
+int main()
+{
+    asd::instrumentation::set_reallocation_callback(countReallocation);
+
+    // Test growth stats of a tagged call-site
+    {
+        asd::instrumentation::scoped_tag tag("ingest");
+        asd::vector<int> myVec1;
+        for (int i = 0; i < 100; ++i)
+        {
+            myVec1.push_back(i);
+        }
+    }
+    asd::instrumentation::stats ingest = asd::instrumentation::snapshot("ingest");
+    assert(ingest.reallocations == 8); // 1, 2, 4 ... 128
+    assert(ingest.allocated_bytes == ingest.deallocated_bytes);
+    assert(ingest.peak_capacity_bytes == 128 * sizeof(int));
+    assert(ingest.moved_bytes == (1 + 2 + 4 + 8 + 16 + 32 + 64) * sizeof(int));
+    assert(ingest.slack_bytes > 0);
+    assert(reallocationEvents == 8);
+
+    // Test tags nest, and reserve avoids growth
+    {
+        asd::instrumentation::scoped_tag outer("outer");
+        {
+            asd::instrumentation::scoped_tag inner("reserved");
+            asd::vector<std::string> myVec2;
+            myVec2.reserve(100);
+            for (int i = 0; i < 100; ++i)
+            {
+                myVec2.push_back(std::to_string(i));
+            }
+        }
+        asd::vector<double> myVec3;
+        myVec3.push_back(1.0);
+    }
+    asd::instrumentation::stats reserved = asd::instrumentation::snapshot("reserved");
+    assert(reserved.reallocations == 1 && reserved.allocations == 1 && reserved.deallocations == 1);
+    assert(asd::instrumentation::snapshot("outer").reallocations == 1);
+
+    // Test the snapshot of every tag for export
+    std::size_t tags = 0;
+    for (const auto &entry : asd::instrumentation::snapshot())
+    {
+        std::cout << entry.first << ": " << entry.second.reallocations << " reallocations, "
+                  << entry.second.moved_bytes << " bytes moved" << std::endl;
+        ++tags;
+    }
+    assert(tags >= 3);
+
+    asd::instrumentation::reset();
+    assert(asd::instrumentation::snapshot("ingest").reallocations == 0);
+    asd::instrumentation::set_reallocation_callback(nullptr);
+
+    // Test the memory registry sums up the live buffers per element type and tag
+    {
+        asd::instrumentation::scoped_tag tag("cache");
+        asd::vector<int> myVec4;
+        for (int i = 0; i < 1000; ++i)
+        {
+            myVec4.push_back(i);
+        }
+        asd::vector<int> myVec5 = myVec4;
+        asd::instrumentation::memory_stats cache = liveMemory("int", "cache");
+        assert(cache.containers == 2 && cache.capacity_bytes == (1024 + 1000) * sizeof(int));
+        assert(cache.usable_bytes == myVec4.memory_usage() + myVec5.memory_usage() - 2 * sizeof(myVec4));
+        assert(cache.peak_usable_bytes >= cache.usable_bytes);
+        asd::vector<int> myVec6 = std::move(myVec5);
+        assert(liveMemory("int", "cache").containers == 2);
+        myVec6.shrink_to_fit();
+        myVec4.erase(0, 500);
+        myVec4.shrink_to_fit();
+        cache = liveMemory("int", "cache");
+        assert(cache.containers == 2 && cache.capacity_bytes == 1500 * sizeof(int));
+
+        // a buffer is taken off its own tag, whichever thread frees it
+        std::thread worker([moved = std::move(myVec4)]() mutable {
+            asd::instrumentation::scoped_tag other("worker");
+            asd::vector<int> local = std::move(moved);
+        });
+        worker.join();
+        assert(liveMemory("int", "cache").containers == 1 && liveMemory("int", "worker").containers == 0);
+
+        std::size_t capacity = myVec6.capacity();
+        std::size_t count = myVec6.size();
+        int *data = myVec6.release();
+        assert(liveMemory("int", "cache").containers == 0);
+        asd::vector<int> myVec7;
+        myVec7.adopt(data, count, capacity);
+        cache = liveMemory("int", "cache");
+        assert(cache.containers == 1 && cache.capacity_bytes == 1000 * sizeof(int));
+
+        asd::vector<std::string> myVec8;
+        myVec8.reserve(10);
+        std::ostringstream dump;
+        asd::instrumentation::dump_memory(dump);
+        std::cout << dump.str();
+        assert(dump.str().find("\tcache\tint\n") != std::string::npos && dump.str().find("\tcache\tstd::") != std::string::npos);
+    }
+    asd::instrumentation::memory_stats cache = liveMemory("int", "cache");
+    assert(cache.containers == 0 && cache.capacity_bytes == 0 && cache.usable_bytes == 0 && cache.peak_usable_bytes > 0);
+
+    // Test an address registered again replaces its stale entry, as when a buffer was freed before it was removed
+    int slot = 0;
+    {
+        asd::instrumentation::scoped_tag tag("stale");
+        ASD_INSTRUMENT_STORAGE_ALLOCATE(int, &slot, 64, 64);
+    }
+    {
+        asd::instrumentation::scoped_tag tag("fresh");
+        ASD_INSTRUMENT_STORAGE_ALLOCATE(int, &slot, 32, 32);
+    }
+    assert(liveMemory("int", "stale").containers == 0 && liveMemory("int", "stale").usable_bytes == 0);
+    assert(liveMemory("int", "fresh").containers == 1 && liveMemory("int", "fresh").usable_bytes == 32);
+    ASD_INSTRUMENT_STORAGE_DEALLOCATE(&slot);
+    assert(liveMemory("int", "fresh").containers == 0 && liveMemory("int", "fresh").capacity_bytes == 0);
+
+    std::cout << "instrumentation examples done" << std::endl;
+
+    return 0;
+}
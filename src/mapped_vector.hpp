@@ -0,0 +1,556 @@
+/*
+ * Copyright (C) 2023 Sofyan Gaber <sofyanhalaby@gmail.com>
+ *
+ * This code is for demonstration and educational purposes. It
+ * implements a vector class whose items live in a memory mapped file.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ASD_MAPPED_VECTOR_2023
+#define ASD_MAPPED_VECTOR_2023
+#include <algorithm>
+#include <cerrno>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <typeinfo>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "vector.hpp"
+
+namespace asd
+{
+    /*
+    identifies T inside a mapped file, a file written for another type (or another layout of it) is refused,
+    it hashes the type name with size and alignment so it is stable between runs of the same build,
+    specialize it to keep files compatible across compilers
+    */
+    template <typename T>
+    struct mapped_type_hash
+    {
+        static std::uint64_t value() noexcept
+        {
+            // FNV-1a
+            std::uint64_t hash = 14695981039346656037ull;
+            auto mix = [&hash](std::uint64_t byte) { hash = (hash ^ byte) * 1099511628211ull; };
+            for (const char *name = typeid(T).name(); *name != '\0'; ++name)
+            {
+                mix(static_cast<unsigned char>(*name));
+            }
+            mix(sizeof(T));
+            mix(alignof(T));
+            return hash;
+        }
+    };
+
+    enum class map_mode
+    {
+        read_write, // opens the file or creates it, the vector can grow
+        read_only // opens an existing file, every process mapping it shares the same page cache copy
+    };
+
+    /*
+    class asd::mapped_vector<T, GrowthPolicy> keeps its items in a memory mapped file,
+    count and capacity are stored in a header at the start of the file so reopening it is O(1),
+    the pages are read lazily on first access and written back by the kernel, flush() forces it
+    growth extends the file by the growth policy and remaps it
+    T has to be trivially copyable, the items are the file bytes
+    a read_only mapping is accessed through the const accessors, the mutable ones assert it is writable
+    errors of the file system calls are thrown as std::system_error,
+    a file of another type or version as std::runtime_error
+    */
+    template <typename T, typename GrowthPolicy = growth::doubling>
+    class mapped_vector
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "mapped_vector items have to be trivially copyable");
+
+        struct header
+        {
+            std::uint64_t magic;
+            std::uint32_t version;
+            std::uint32_t item_size;
+            std::uint64_t type_hash;
+            std::uint64_t count;
+            std::uint64_t capacity;
+        };
+
+        static constexpr std::uint64_t file_magic = 0x524f544345565344ull; // "DSVECTOR" little endian
+        static constexpr std::uint32_t file_version = 1;
+        // items start on a cache line, or further if T asks for it
+        static constexpr std::size_t data_offset = alignof(T) > 64 ? alignof(T) : 64;
+        static_assert(sizeof(header) <= data_offset);
+
+        int m_fd;
+        bool m_read_only;
+        std::size_t m_mapped_bytes;
+        header *m_header;
+        T *m_data_ptr;
+
+        [[noreturn]] static void throw_errno(const char *what)
+        {
+            throw std::system_error(errno, std::generic_category(), what);
+        }
+
+        static std::size_t file_bytes(std::size_t capacity) noexcept
+        {
+            return data_offset + capacity * sizeof(T);
+        }
+
+        void set_mapping(void *ptr, std::size_t bytes) noexcept
+        {
+            m_mapped_bytes = bytes;
+            m_header = static_cast<header *>(ptr);
+            m_data_ptr = reinterpret_cast<T *>(static_cast<char *>(ptr) + data_offset);
+        }
+
+        void map(std::size_t bytes)
+        {
+            int protection = m_read_only ? PROT_READ : PROT_READ | PROT_WRITE;
+            void *ptr = ::mmap(nullptr, bytes, protection, MAP_SHARED, m_fd, 0);
+            if (ptr == MAP_FAILED)
+            {
+                throw_errno("mapped_vector: mmap");
+            }
+            set_mapping(ptr, bytes);
+        }
+
+        void unmap() noexcept
+        {
+            if (m_header != nullptr)
+            {
+                ::munmap(m_header, m_mapped_bytes);
+            }
+            if (m_fd >= 0)
+            {
+                ::close(m_fd);
+            }
+            m_fd = -1;
+            m_header = nullptr;
+            m_data_ptr = nullptr;
+            m_mapped_bytes = 0;
+        }
+
+        void open(const char *path, map_mode mode)
+        {
+            m_fd = m_read_only ? ::open(path, O_RDONLY | O_CLOEXEC) : ::open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+            if (m_fd < 0)
+            {
+                throw_errno("mapped_vector: open");
+            }
+            struct stat status;
+            if (::fstat(m_fd, &status) != 0)
+            {
+                throw_errno("mapped_vector: fstat");
+            }
+            std::size_t size = static_cast<std::size_t>(status.st_size);
+            if (size == 0 && mode == map_mode::read_write)
+            {
+                // new file, only the header
+                if (::ftruncate(m_fd, static_cast<off_t>(file_bytes(0))) != 0)
+                {
+                    throw_errno("mapped_vector: ftruncate");
+                }
+                map(file_bytes(0));
+                *m_header = header{file_magic, file_version, sizeof(T), mapped_type_hash<T>::value(), 0, 0};
+                return;
+            }
+            if (size < file_bytes(0))
+            {
+                throw std::runtime_error("mapped_vector: file is too small for the header");
+            }
+            map(size);
+            if (m_header->magic != file_magic || m_header->version != file_version)
+            {
+                throw std::runtime_error("mapped_vector: not a mapped_vector file or unsupported version");
+            }
+            if (m_header->item_size != sizeof(T) || m_header->type_hash != mapped_type_hash<T>::value())
+            {
+                throw std::runtime_error("mapped_vector: file holds items of another type");
+            }
+            // a corrupt capacity could wrap file_bytes() below the file size
+            if (m_header->count > m_header->capacity || m_header->capacity > (SIZE_MAX - data_offset) / sizeof(T) ||
+                file_bytes(static_cast<std::size_t>(m_header->capacity)) > size)
+            {
+                throw std::runtime_error("mapped_vector: file is truncated");
+            }
+        }
+
+        void check_writable() const
+        {
+            if (m_read_only)
+            {
+                throw std::logic_error("mapped_vector: the file is mapped read only");
+            }
+        }
+
+        /*
+        resizes the file to hold new_capacity items and maps it again
+        the file grows before the mapping and shrinks after it, so no mapped page is past the end of the file
+        */
+        void reallocate(std::size_t new_capacity)
+        {
+            check_writable();
+            std::size_t bytes = file_bytes(new_capacity);
+            if (bytes > m_mapped_bytes && ::ftruncate(m_fd, static_cast<off_t>(bytes)) != 0)
+            {
+                throw_errno("mapped_vector: ftruncate");
+            }
+#ifdef MREMAP_MAYMOVE
+            void *ptr = ::mremap(m_header, m_mapped_bytes, bytes, MREMAP_MAYMOVE);
+            if (ptr == MAP_FAILED)
+            {
+                throw_errno("mapped_vector: mremap");
+            }
+            set_mapping(ptr, bytes);
+#else
+            ::munmap(m_header, m_mapped_bytes);
+            m_header = nullptr;
+            map(bytes);
+#endif
+            if (bytes < file_bytes(m_header->capacity) && ::ftruncate(m_fd, static_cast<off_t>(bytes)) != 0)
+            {
+                throw_errno("mapped_vector: ftruncate");
+            }
+            m_header->capacity = new_capacity;
+        }
+
+        void grow(std::size_t required)
+        {
+            reallocate(GrowthPolicy::next_capacity(m_header->capacity, required, sizeof(T)));
+        }
+
+    public:
+        using value_type = T;
+        using growth_policy = GrowthPolicy;
+        using iterator = T *;
+        using const_iterator = const T *;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+        /*
+        maps the file at path, read_write creates it when it doesn't exist
+        - throws std::system_error if the file can't be opened or mapped
+        - throws std::runtime_error if the file isn't a mapped_vector of T
+        */
+        explicit mapped_vector(const char *path, map_mode mode = map_mode::read_write)
+            : m_fd(-1), m_read_only(mode == map_mode::read_only), m_mapped_bytes(0), m_header(nullptr), m_data_ptr(nullptr)
+        {
+            try
+            {
+                open(path, mode);
+            }
+            catch (...)
+            {
+                unmap();
+                throw;
+            }
+        }
+
+        mapped_vector(const mapped_vector &) = delete;
+        mapped_vector &operator=(const mapped_vector &) = delete;
+
+        mapped_vector(mapped_vector &&other) noexcept
+            : m_fd(other.m_fd), m_read_only(other.m_read_only), m_mapped_bytes(other.m_mapped_bytes),
+              m_header(other.m_header), m_data_ptr(other.m_data_ptr)
+        {
+            other.m_fd = -1;
+            other.m_header = nullptr;
+            other.m_data_ptr = nullptr;
+            other.m_mapped_bytes = 0;
+        }
+
+        mapped_vector &operator=(mapped_vector &&other) noexcept
+        {
+            if (this != &other)
+            {
+                unmap();
+                m_fd = other.m_fd;
+                m_read_only = other.m_read_only;
+                set_mapping(other.m_header, other.m_mapped_bytes);
+                other.m_fd = -1;
+                other.m_header = nullptr;
+                other.m_data_ptr = nullptr;
+                other.m_mapped_bytes = 0;
+            }
+            return *this;
+        }
+
+        /*
+        unmaps the file, the kernel writes the dirty pages back later
+        */
+        ~mapped_vector()
+        {
+            unmap();
+        }
+
+        bool is_read_only() const noexcept
+        {
+            return m_read_only;
+        }
+
+        /*
+        writes the dirty pages back to the file and waits for it
+        */
+        void flush()
+        {
+            if (!m_read_only && ::msync(m_header, m_mapped_bytes, MS_SYNC) != 0)
+            {
+                throw_errno("mapped_vector: msync");
+            }
+        }
+
+        void push_back(const T &value)
+        {
+            check_writable();
+            if (m_header->count == m_header->capacity)
+            {
+                // value may live in the mapping that is about to move
+                T copy = value;
+                grow(m_header->count + 1);
+                m_data_ptr[m_header->count++] = copy;
+                return;
+            }
+            m_data_ptr[m_header->count++] = value;
+        }
+
+        template <typename... Args>
+        T &emplace_back(Args &&...args)
+        {
+            T value(std::forward<Args>(args)...);
+            push_back(value);
+            return back();
+        }
+
+        /*
+        appends the items of [first, last) growing the file at most once for forward ranges
+        */
+        template <typename InputIt, typename = std::enable_if_t<is_iterator_v<InputIt>>>
+        void append(InputIt first, InputIt last)
+        {
+            check_writable();
+            if constexpr (is_forward_iterator_v<InputIt>)
+            {
+                std::size_t n = static_cast<std::size_t>(std::distance(first, last));
+                if (m_header->count + n > m_header->capacity)
+                {
+                    if (owns_range(first, n))
+                    {
+                        vector<T> copy;
+                        copy.append(first, last);
+                        append(copy.begin(), copy.end());
+                        return;
+                    }
+                    grow(m_header->count + n);
+                }
+                std::copy(first, last, m_data_ptr + m_header->count);
+                m_header->count += n;
+            }
+            else
+            {
+                for (; first != last; ++first)
+                {
+                    push_back(*first);
+                }
+            }
+        }
+
+        void append(std::initializer_list<T> il)
+        {
+            append(il.begin(), il.end());
+        }
+
+        void reserve(std::size_t new_capacity)
+        {
+            if (new_capacity > m_header->capacity)
+            {
+                reallocate(new_capacity);
+            }
+        }
+
+        /*
+        new items are zero, the bytes of a freshly extended file
+        */
+        void resize(std::size_t new_size)
+        {
+            check_writable();
+            if (new_size > m_header->capacity)
+            {
+                reallocate(new_size);
+            }
+            if (new_size > m_header->count)
+            {
+                std::memset(static_cast<void *>(m_data_ptr + m_header->count), 0, (new_size - m_header->count) * sizeof(T));
+            }
+            m_header->count = new_size;
+        }
+
+        void clear()
+        {
+            check_writable();
+            m_header->count = 0;
+        }
+
+        /*
+        truncates the file to the items it holds
+        */
+        void shrink_to_fit()
+        {
+            if (m_header->capacity > m_header->count)
+            {
+                reallocate(m_header->count);
+            }
+        }
+
+        T &operator[](std::size_t i) noexcept
+        {
+            assert(!m_read_only && "mapped_vector: the file is mapped read only");
+            return m_data_ptr[i];
+        }
+
+        const T &operator[](std::size_t i) const noexcept
+        {
+            return m_data_ptr[i];
+        }
+
+        std::size_t size() const noexcept
+        {
+            return m_header->count;
+        }
+
+        std::size_t capacity() const noexcept
+        {
+            return m_header->capacity;
+        }
+
+        bool empty() const noexcept
+        {
+            return m_header->count == 0;
+        }
+
+        T *data() noexcept
+        {
+            assert(!m_read_only && "mapped_vector: the file is mapped read only");
+            return m_data_ptr;
+        }
+
+        const T *data() const noexcept
+        {
+            return m_data_ptr;
+        }
+
+        iterator begin() noexcept
+        {
+            assert(!m_read_only && "mapped_vector: the file is mapped read only");
+            return m_data_ptr;
+        }
+
+        const_iterator begin() const noexcept
+        {
+            return m_data_ptr;
+        }
+
+        const_iterator cbegin() const noexcept
+        {
+            return m_data_ptr;
+        }
+
+        iterator end() noexcept
+        {
+            assert(!m_read_only && "mapped_vector: the file is mapped read only");
+            return m_data_ptr + m_header->count;
+        }
+
+        const_iterator end() const noexcept
+        {
+            return m_data_ptr + m_header->count;
+        }
+
+        const_iterator cend() const noexcept
+        {
+            return m_data_ptr + m_header->count;
+        }
+
+        reverse_iterator rbegin() noexcept
+        {
+            return reverse_iterator(end());
+        }
+
+        const_reverse_iterator rbegin() const noexcept
+        {
+            return const_reverse_iterator(end());
+        }
+
+        reverse_iterator rend() noexcept
+        {
+            return reverse_iterator(begin());
+        }
+
+        const_reverse_iterator rend() const noexcept
+        {
+            return const_reverse_iterator(begin());
+        }
+
+        T &front() noexcept
+        {
+            assert(!m_read_only && "mapped_vector: the file is mapped read only");
+            return m_data_ptr[0];
+        }
+
+        const T &front() const noexcept
+        {
+            return m_data_ptr[0];
+        }
+
+        T &back() noexcept
+        {
+            assert(!m_read_only && "mapped_vector: the file is mapped read only");
+            return m_data_ptr[m_header->count - 1];
+        }
+
+        const T &back() const noexcept
+        {
+            return m_data_ptr[m_header->count - 1];
+        }
+
+    private:
+        template <typename It>
+        bool owns_range(It first, std::size_t n) const noexcept
+        {
+            if constexpr (std::is_pointer_v<It> && std::is_same_v<std::remove_cv_t<std::remove_pointer_t<It>>, T>)
+            {
+                auto lhs = std::less<const T *>();
+                return n > 0 && !lhs(first, m_data_ptr) && lhs(first, m_data_ptr + m_header->capacity);
+            }
+            else
+            {
+                return false;
+            }
+        }
+    };
+}
+#endif //ifndef ASD_MAPPED_VECTOR_2023
@@ -0,0 +1,124 @@
+
+#include <iostream>
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+#include <system_error>
+#include <assert.h>
+#include "mapped_vector.hpp"
+
+struct lookup_record
+{
+    std::uint64_t key;
+    double value;
+};
+
+int main()
+{
+    const char *path = "mapped_vector_example.bin";
+    std::remove(path);
+
+    {
+        // Test creating a file and growing it
+        asd::mapped_vector<lookup_record> myVec1(path);
+        assert(myVec1.empty() && !myVec1.is_read_only());
+        for (std::uint64_t i = 0; i < 1000000; ++i)
+        {
+            myVec1.push_back(lookup_record{i, static_cast<double>(i) / 2});
+        }
+        assert(myVec1.size() == 1000000 && myVec1.capacity() >= 1000000);
+        myVec1.push_back(myVec1[10]);
+        assert(myVec1.back().key == 10);
+        myVec1.append(myVec1.begin(), myVec1.begin() + 5);
+        assert(myVec1.size() == 1000006 && myVec1[1000005].key == 4);
+        myVec1.resize(1000000);
+        myVec1.shrink_to_fit();
+        myVec1.flush();
+    }
+
+    {
+        // Test reopening keeps the items without reading them
+        asd::mapped_vector<lookup_record> myVec2(path);
+        assert(myVec2.size() == 1000000 && myVec2.capacity() == 1000000);
+        assert(myVec2[999999].key == 999999 && myVec2[999999].value == 999999.0 / 2);
+        myVec2.push_back(myVec2[3]);
+        assert(myVec2.capacity() > 1000000 && myVec2.back().key == 3);
+        myVec2.emplace_back(lookup_record{7, 7.0});
+        assert(myVec2.size() == 1000002);
+        asd::mapped_vector<lookup_record> myVec3(std::move(myVec2));
+        assert(myVec3.back().key == 7);
+    }
+
+    {
+        // Test read only mappings share the file
+        asd::mapped_vector<lookup_record> myVec4(path, asd::map_mode::read_only);
+        asd::mapped_vector<lookup_record> myVec5(path, asd::map_mode::read_only);
+        assert(myVec4.is_read_only() && myVec4.size() == 1000002 && myVec5.size() == 1000002);
+        const asd::mapped_vector<lookup_record> &constVec4 = myVec4;
+        std::uint64_t total = 0;
+        for (const lookup_record &item : constVec4)
+        {
+            total += item.key;
+        }
+        assert(total == 999999ull * 1000000 / 2 + 3 + 7);
+        bool thrown = false;
+        try
+        {
+            myVec5.push_back(lookup_record{1, 1.0});
+        }
+        catch (const std::logic_error &)
+        {
+            thrown = true;
+        }
+        assert(thrown && myVec5.size() == 1000002);
+    }
+
+    // Test files of another type are refused
+    bool thrown = false;
+    try
+    {
+        asd::mapped_vector<double> myVec6(path);
+    }
+    catch (const std::runtime_error &)
+    {
+        thrown = true;
+    }
+    assert(thrown);
+
+    // Test a corrupt capacity that wraps the file size around is refused
+    {
+        asd::mapped_vector<lookup_record> myVec8(path);
+        myVec8.push_back(lookup_record{1, 1.0});
+    }
+    std::uint64_t wrapping = std::uint64_t(1) << 60; // 2^60 records of 16 bytes wrap to 0 bytes
+    std::FILE *file = std::fopen(path, "r+b");
+    assert(file != nullptr);
+    std::fseek(file, 32, SEEK_SET); // the capacity field of the header
+    std::fwrite(&wrapping, sizeof(wrapping), 1, file);
+    std::fclose(file);
+    thrown = false;
+    try
+    {
+        asd::mapped_vector<lookup_record> myVec9(path, asd::map_mode::read_only);
+    }
+    catch (const std::runtime_error &)
+    {
+        thrown = true;
+    }
+    assert(thrown);
+    std::remove(path);
+    thrown = false;
+    try
+    {
+        asd::mapped_vector<double> myVec7(path, asd::map_mode::read_only);
+    }
+    catch (const std::system_error &)
+    {
+        thrown = true;
+    }
+    assert(thrown);
+
+    std::cout << "mapped_vector examples done" << std::endl;
+
+    return 0;
+}
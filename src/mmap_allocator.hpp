@@ -0,0 +1,265 @@
+/*
+ * Copyright (C) 2023 Sofyan Gaber <sofyanhalaby@gmail.com>
+ *
+ * This code is for demonstration and educational purposes. It
+ * implements an allocator that maps large buffers directly from the kernel.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ASD_MMAP_ALLOCATOR_2023
+#define ASD_MMAP_ALLOCATOR_2023
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "vector.hpp"
+
+namespace asd
+{
+    /*
+    how the mapped buffers of asd::mmap_allocator use huge pages
+    - none: regular pages
+    - advise: madvise(MADV_HUGEPAGE) so transparent huge pages back the buffer when the kernel can
+    - hugetlb: MAP_HUGETLB from the reserved huge page pool, falls back to advise when the pool is empty
+    */
+    enum class huge_pages
+    {
+        none,
+        advise,
+        hugetlb
+    };
+
+    /*
+    class asd::mmap_allocator<T, Threshold, Pages> is meant for very large vectors
+    buffers smaller than Threshold bytes come from asd::allocator<T>, larger buffers are anonymous mappings,
+    growing a mapping uses mremap so the kernel moves page table entries instead of copying the items,
+    there is no moment where both the old and the new buffer are resident
+    asd::vector only calls reallocate for trivially relocatable items, other items are moved as usual
+    it is stateless and meets the standard Allocator requirements
+    */
+    template <typename T, std::size_t Threshold = std::size_t(1) << 21, huge_pages Pages = huge_pages::none>
+    class mmap_allocator
+    {
+        using small_allocator = allocator<T>;
+
+    public:
+        using value_type = T;
+        using is_always_equal = std::true_type;
+
+        static constexpr std::size_t threshold = Threshold;
+        static constexpr std::size_t alignment = small_allocator::alignment;
+        static constexpr std::size_t huge_page_size = std::size_t(1) << 21;
+
+        template <typename U>
+        struct rebind
+        {
+            using other = mmap_allocator<U, Threshold, Pages>;
+        };
+
+        mmap_allocator() = default;
+
+        template <typename U>
+        mmap_allocator(const mmap_allocator<U, Threshold, Pages> &) noexcept
+        {
+        }
+
+        /*
+        true if a buffer of n items is a mapping rather than heap memory
+        */
+        static constexpr bool is_mapped(std::size_t n) noexcept
+        {
+            return n * sizeof(T) >= Threshold;
+        }
+
+        /*
+        allocates raw memory that can hold n T items, the memory is not initialized
+        mapped memory is zero filled and the pages are committed on first touch
+        - thows bad_alloc exception in case of allocation failure
+        */
+        T *allocate(std::size_t n)
+        {
+            if (!is_mapped(n))
+            {
+                return small_allocator().allocate(n);
+            }
+            T *ptr = static_cast<T *>(map(mapped_bytes(n)));
+            ASD_INSTRUMENT_ALLOCATE(n * sizeof(T));
+            return ptr;
+        }
+
+        /*
+        grows or shrinks memory allocated by this allocator, the first min(old_n, n) items are kept bitwise,
+        mapped buffers are remapped by the kernel, heap buffers are reallocated,
+        and buffers crossing the threshold are copied once
+        ptr may be nullptr with old_n 0, then it allocates
+        - thows bad_alloc exception in case of allocation failure, ptr stays valid in this case
+        */
+        T *reallocate(T *ptr, std::size_t old_n, std::size_t n)
+        {
+            if (ptr == nullptr)
+            {
+                return allocate(n);
+            }
+            if (!is_mapped(old_n) && !is_mapped(n))
+            {
+                return small_allocator().reallocate(ptr, old_n, n);
+            }
+            if (is_mapped(old_n) && is_mapped(n))
+            {
+                T *new_ptr = static_cast<T *>(remap(ptr, mapped_bytes(old_n), mapped_bytes(n)));
+                ASD_INSTRUMENT_REALLOCATE(old_n * sizeof(T), n * sizeof(T));
+                return new_ptr;
+            }
+            // crossing the threshold changes where the memory comes from
+            T *new_ptr;
+            if (is_mapped(n))
+            {
+                new_ptr = allocate(n);
+                std::memcpy(static_cast<void *>(new_ptr), static_cast<const void *>(ptr), old_n * sizeof(T));
+                small_allocator().deallocate(ptr, old_n);
+            }
+            else
+            {
+                new_ptr = small_allocator().allocate(n);
+                std::memcpy(static_cast<void *>(new_ptr), static_cast<const void *>(ptr), n * sizeof(T));
+                deallocate(ptr, old_n);
+            }
+            return new_ptr;
+        }
+
+        void deallocate(T *ptr, std::size_t n) noexcept
+        {
+            if (!is_mapped(n))
+            {
+                small_allocator().deallocate(ptr, n);
+                return;
+            }
+            ASD_INSTRUMENT_DEALLOCATE(n * sizeof(T));
+            ::munmap(ptr, mapped_bytes(n));
+        }
+
+        /*
+        the bytes reserved for n items at ptr, whole pages for a mapping
+        */
+        std::size_t usable_size(const T *ptr, std::size_t n) const noexcept
+        {
+            if (ptr == nullptr || !is_mapped(n))
+            {
+                return small_allocator().usable_size(ptr, n);
+            }
+            return mapped_bytes(n);
+        }
+
+    private:
+        static std::size_t page_size() noexcept
+        {
+            static const std::size_t size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+            return size;
+        }
+
+        /*
+        length of the mapping that holds n items, huge page buffers are whole huge pages
+        so the same length is used whether MAP_HUGETLB succeeded or not
+        */
+        static std::size_t mapped_bytes(std::size_t n) noexcept
+        {
+            std::size_t granule = Pages == huge_pages::none ? page_size() : huge_page_size;
+            return (n * sizeof(T) + granule - 1) / granule * granule;
+        }
+
+        static void advise(void *ptr, std::size_t bytes) noexcept
+        {
+#ifdef MADV_HUGEPAGE
+            if (Pages != huge_pages::none)
+            {
+                ::madvise(ptr, bytes, MADV_HUGEPAGE);
+            }
+#else
+            (void)ptr;
+            (void)bytes;
+#endif
+        }
+
+        static void *map(std::size_t bytes)
+        {
+            void *ptr = MAP_FAILED;
+#ifdef MAP_HUGETLB
+            if (Pages == huge_pages::hugetlb)
+            {
+                ptr = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            }
+#endif
+            if (ptr == MAP_FAILED)
+            {
+                ptr = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                if (ptr == MAP_FAILED)
+                {
+                    throw std::bad_alloc();
+                }
+                advise(ptr, bytes);
+            }
+            return ptr;
+        }
+
+        static void *remap(void *ptr, std::size_t old_bytes, std::size_t bytes)
+        {
+            if (old_bytes == bytes)
+            {
+                return ptr;
+            }
+#ifdef MREMAP_MAYMOVE
+            void *new_ptr = ::mremap(ptr, old_bytes, bytes, MREMAP_MAYMOVE);
+            if (new_ptr != MAP_FAILED)
+            {
+                if (bytes > old_bytes)
+                {
+                    advise(new_ptr, bytes);
+                }
+                return new_ptr;
+            }
+#endif
+            // no mremap on this platform, or the kernel refused it (e.g. for a hugetlb mapping)
+            if (bytes < old_bytes)
+            {
+                ::munmap(static_cast<char *>(ptr) + bytes, old_bytes - bytes);
+                return ptr;
+            }
+            void *fresh_ptr = map(bytes);
+            std::memcpy(fresh_ptr, ptr, old_bytes);
+            ::munmap(ptr, old_bytes);
+            return fresh_ptr;
+        }
+    };
+
+    template <typename T, typename U, std::size_t Threshold, huge_pages Pages>
+    bool operator==(const mmap_allocator<T, Threshold, Pages> &, const mmap_allocator<U, Threshold, Pages> &) noexcept
+    {
+        return true;
+    }
+
+    template <typename T, typename U, std::size_t Threshold, huge_pages Pages>
+    bool operator!=(const mmap_allocator<T, Threshold, Pages> &, const mmap_allocator<U, Threshold, Pages> &) noexcept
+    {
+        return false;
+    }
+}
+#endif //ifndef ASD_MMAP_ALLOCATOR_2023
@@ -0,0 +1,65 @@
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <assert.h>
+#include "vector.hpp"
+#include "mmap_allocator.hpp"
+
+int main()
+{
+    // Test growth crosses from heap to mapped memory and keeps the items
+    using mapped_allocator = asd::mmap_allocator<std::int64_t, 4096>;
+    static_assert(!mapped_allocator::is_mapped(511) && mapped_allocator::is_mapped(512));
+    asd::vector<std::int64_t, mapped_allocator> myVec1;
+    for (std::int64_t i = 0; i < 3000000; ++i)
+    {
+        myVec1.push_back(i * 3);
+    }
+    assert(mapped_allocator::is_mapped(myVec1.capacity()));
+    assert(reinterpret_cast<std::uintptr_t>(myVec1.data()) % 4096 == 0);
+    for (std::int64_t i = 0; i < 3000000; ++i)
+    {
+        assert(myVec1[i] == i * 3);
+    }
+
+    // Test shrinking a mapping and going back under the threshold
+    myVec1.resize(100000);
+    myVec1.shrink_to_fit();
+    assert(myVec1.capacity() == 100000 && myVec1[99999] == 99999 * 3);
+    myVec1.resize(100);
+    myVec1.shrink_to_fit();
+    assert(!mapped_allocator::is_mapped(myVec1.capacity()) && myVec1[99] == 99 * 3);
+
+    // Test copies and non-trivial items, they are moved by the container instead of remapped
+    asd::vector<std::int64_t, mapped_allocator> myVec2(myVec1);
+    assert(myVec2.size() == 100 && myVec2[50] == 150);
+    asd::vector<std::string, asd::mmap_allocator<std::string, 4096>> myVec3;
+    for (int i = 0; i < 10000; ++i)
+    {
+        myVec3.push_back("mapped string that is long enough to go to heap " + std::to_string(i));
+    }
+    assert(myVec3[9999] == "mapped string that is long enough to go to heap 9999");
+
+    // Test huge page modes, hugetlb falls back to regular pages when the pool is empty
+    asd::vector<float, asd::mmap_allocator<float, 1 << 20, asd::huge_pages::advise>> myVec4;
+    asd::vector<float, asd::mmap_allocator<float, 1 << 20, asd::huge_pages::hugetlb>> myVec5;
+    for (int i = 0; i < 2000000; ++i)
+    {
+        myVec4.push_back(static_cast<float>(i));
+        myVec5.push_back(static_cast<float>(i));
+    }
+    assert(myVec4[1999999] == 1999999.0f && myVec5[1999999] == 1999999.0f);
+    myVec5.resize(10);
+    myVec5.shrink_to_fit();
+    assert(myVec5.size() == 10 && myVec5[9] == 9.0f);
+
+    // Test std containers
+    std::vector<int, asd::mmap_allocator<int>> stdVec1(1000000, 7);
+    assert(stdVec1[999999] == 7);
+
+    std::cout << "mmap_allocator examples done" << std::endl;
+
+    return 0;
+}
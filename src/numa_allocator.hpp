@@ -0,0 +1,256 @@
+/*
+ * Copyright (C) 2023 Sofyan Gaber <sofyanhalaby@gmail.com>
+ *
+ * This code is for demonstration and educational purposes. It
+ * implements an allocator that places large buffers on NUMA nodes.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ASD_NUMA_ALLOCATOR_2023
+#define ASD_NUMA_ALLOCATOR_2023
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include "mmap_allocator.hpp"
+
+namespace asd
+{
+    /*
+    where the pages of the mapped buffers of asd::numa_allocator are placed
+    - first_touch: the kernel default, a page lands on the node of the thread that writes it first,
+      fill the vector by asd::parallel::resize so every thread touches the pages it processes later
+    - interleave: pages are spread round robin over all nodes, for data read by all threads alike
+    - node: pages are placed on one node, other nodes are used only when it is full
+    */
+    enum class numa_policy
+    {
+        first_touch,
+        interleave,
+        node
+    };
+
+    namespace detail
+    {
+        // the mempolicy modes and flags of <numaif.h>, so libnuma is not needed
+        inline constexpr int mpol_preferred = 1;
+        inline constexpr int mpol_interleave = 3;
+        inline constexpr unsigned long mpol_f_mems_allowed = 4;
+        inline constexpr std::size_t numa_mask_bits = 1024;
+
+        struct numa_mask
+        {
+            unsigned long bits[numa_mask_bits / (8 * sizeof(unsigned long))] = {};
+
+            bool test(std::size_t node) const noexcept
+            {
+                std::size_t word_bits = 8 * sizeof(unsigned long);
+                return node < numa_mask_bits && (bits[node / word_bits] >> (node % word_bits)) & 1;
+            }
+        };
+
+        /*
+        the nodes this process may allocate on, just node 0 when the kernel has no NUMA support
+        */
+        inline const numa_mask &allowed_numa_nodes() noexcept
+        {
+            static const numa_mask mask = [] {
+                numa_mask allowed;
+                int mode = 0;
+#ifdef SYS_get_mempolicy
+                if (::syscall(SYS_get_mempolicy, &mode, allowed.bits, numa_mask_bits + 1, nullptr, mpol_f_mems_allowed) == 0)
+                {
+                    return allowed;
+                }
+#endif
+                allowed.bits[0] = 1;
+                return allowed;
+            }();
+            return mask;
+        }
+
+        /*
+        sets the policy of bytes of mapped memory at ptr for the pages not touched yet,
+        it is a placement hint so a kernel without NUMA support is not an error
+        */
+        inline void numa_bind(void *ptr, std::size_t bytes, numa_policy policy, int node) noexcept
+        {
+#ifdef SYS_mbind
+            if (policy == numa_policy::interleave)
+            {
+                ::syscall(SYS_mbind, ptr, bytes, mpol_interleave, allowed_numa_nodes().bits, numa_mask_bits + 1, 0u);
+            }
+            else if (policy == numa_policy::node)
+            {
+                numa_mask preferred;
+                std::size_t word_bits = 8 * sizeof(unsigned long);
+                preferred.bits[static_cast<std::size_t>(node) / word_bits] = 1ul << (static_cast<std::size_t>(node) % word_bits);
+                ::syscall(SYS_mbind, ptr, bytes, mpol_preferred, preferred.bits, numa_mask_bits + 1, 0u);
+            }
+#else
+            (void)ptr;
+            (void)bytes;
+            (void)policy;
+            (void)node;
+#endif
+        }
+    }
+
+    /*
+    number of NUMA nodes this process may allocate on, one past the highest allowed node
+    */
+    inline std::size_t numa_nodes() noexcept
+    {
+        std::size_t count = 0;
+        for (std::size_t node = 0; node < detail::numa_mask_bits; ++node)
+        {
+            if (detail::allowed_numa_nodes().test(node))
+            {
+                count = node + 1;
+            }
+        }
+        return count;
+    }
+
+    /*
+    class asd::numa_allocator<T, Threshold, Pages> is an asd::mmap_allocator whose mappings are placed by a numa_policy
+    buffers smaller than Threshold bytes come from the heap and are not placed
+    the policy is state of the allocator, so it is copied with the vector, a vector that takes the memory of
+    another one by move assignment keeps its own policy for the memory it allocates later
+    any numa_allocator can release the memory of another one, so they are always equal
+    */
+    template <typename T, std::size_t Threshold = std::size_t(1) << 21, huge_pages Pages = huge_pages::none>
+    class numa_allocator
+    {
+        using mapped_allocator = mmap_allocator<T, Threshold, Pages>;
+
+        numa_policy m_policy;
+        int m_node;
+
+        template <typename U, std::size_t, huge_pages>
+        friend class numa_allocator;
+
+        void bind(T *ptr, std::size_t n) const noexcept
+        {
+            if (mapped_allocator::is_mapped(n))
+            {
+                detail::numa_bind(ptr, n * sizeof(T), m_policy, m_node);
+            }
+        }
+
+    public:
+        using value_type = T;
+        using is_always_equal = std::true_type;
+
+        static constexpr std::size_t threshold = Threshold;
+        static constexpr std::size_t alignment = mapped_allocator::alignment;
+
+        template <typename U>
+        struct rebind
+        {
+            using other = numa_allocator<U, Threshold, Pages>;
+        };
+
+        /*
+        first touch placement
+        */
+        numa_allocator() noexcept
+            : m_policy(numa_policy::first_touch), m_node(0)
+        {
+        }
+
+        /*
+        places the mappings by policy, node is the node of numa_policy::node
+        - throws invalid_argument exception if node is not a node this process may allocate on
+        */
+        explicit numa_allocator(numa_policy policy, int node = 0)
+            : m_policy(policy), m_node(node)
+        {
+            if (policy == numa_policy::node && (node < 0 || !detail::allowed_numa_nodes().test(static_cast<std::size_t>(node))))
+            {
+                throw std::invalid_argument("asd::numa_allocator node is not allowed");
+            }
+        }
+
+        template <typename U>
+        numa_allocator(const numa_allocator<U, Threshold, Pages> &other) noexcept
+            : m_policy(other.m_policy), m_node(other.m_node)
+        {
+        }
+
+        numa_policy policy() const noexcept
+        {
+            return m_policy;
+        }
+
+        int node() const noexcept
+        {
+            return m_node;
+        }
+
+        static constexpr bool is_mapped(std::size_t n) noexcept
+        {
+            return mapped_allocator::is_mapped(n);
+        }
+
+        /*
+        allocates raw memory that can hold n T items, mapped memory is placed as the policy tells
+        when its pages are touched first
+        - thows bad_alloc exception in case of allocation failure
+        */
+        T *allocate(std::size_t n)
+        {
+            T *ptr = mapped_allocator().allocate(n);
+            bind(ptr, n);
+            return ptr;
+        }
+
+        /*
+        grows or shrinks memory as asd::mmap_allocator does, the pages that are touched first after it
+        are placed as the policy tells, the pages already touched stay where they are
+        - thows bad_alloc exception in case of allocation failure, ptr stays valid in this case
+        */
+        T *reallocate(T *ptr, std::size_t old_n, std::size_t n)
+        {
+            T *new_ptr = mapped_allocator().reallocate(ptr, old_n, n);
+            bind(new_ptr, n);
+            return new_ptr;
+        }
+
+        void deallocate(T *ptr, std::size_t n) noexcept
+        {
+            mapped_allocator().deallocate(ptr, n);
+        }
+    };
+
+    template <typename T, typename U, std::size_t Threshold, huge_pages Pages>
+    bool operator==(const numa_allocator<T, Threshold, Pages> &, const numa_allocator<U, Threshold, Pages> &) noexcept
+    {
+        return true;
+    }
+
+    template <typename T, typename U, std::size_t Threshold, huge_pages Pages>
+    bool operator!=(const numa_allocator<T, Threshold, Pages> &, const numa_allocator<U, Threshold, Pages> &) noexcept
+    {
+        return false;
+    }
+}
+#endif //ifndef ASD_NUMA_ALLOCATOR_2023
@@ -0,0 +1,72 @@
+#include <iostream>
+#include <vector>
+#include <cstdint>
+#include <stdexcept>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <assert.h>
+#include "vector.hpp"
+#include "numa_allocator.hpp"
+#include "parallel.hpp"
+
+// the mempolicy mode of the mapping at ptr, as get_mempolicy(MPOL_F_ADDR) tells
+int policy_of(const void *ptr)
+{
+    int mode = -1;
+    ::syscall(SYS_get_mempolicy, &mode, nullptr, 0ul, ptr, 2ul);
+    return mode;
+}
+
+int main()
+{
+    // Test the allowed nodes and the policy checks
+    assert(asd::numa_nodes() >= 1);
+    asd::numa_allocator<int> allocator1;
+    assert(allocator1.policy() == asd::numa_policy::first_touch);
+    asd::numa_allocator<int> allocator2(asd::numa_policy::node, 0);
+    asd::numa_allocator<double> allocator3(allocator2);
+    assert(allocator3.policy() == asd::numa_policy::node && allocator3.node() == 0 && allocator1 == allocator2);
+    bool thrown = false;
+    try
+    {
+        asd::numa_allocator<int> allocator4(asd::numa_policy::node, 100000);
+    }
+    catch (const std::invalid_argument &)
+    {
+        thrown = true;
+    }
+    assert(thrown);
+
+    // Test interleaved vectors keep their policy while they grow
+    using interleaved = asd::numa_allocator<std::int64_t, 4096>;
+    asd::vector<std::int64_t, interleaved> myVec1(interleaved(asd::numa_policy::interleave));
+    for (std::int64_t i = 0; i < 2000000; ++i)
+    {
+        myVec1.push_back(i);
+    }
+    assert(interleaved::is_mapped(myVec1.capacity()) && myVec1[1999999] == 1999999);
+    assert(policy_of(myVec1.data()) == 3 && policy_of(myVec1.data() + myVec1.size() - 1) == 3);
+    asd::vector<std::int64_t, interleaved> myVec2(myVec1);
+    assert(myVec2.get_allocator().policy() == asd::numa_policy::interleave && myVec2[12345] == 12345);
+    assert(policy_of(myVec2.data()) == 3);
+    myVec1.shrink_to_fit();
+    myVec1.resize(10);
+    myVec1.shrink_to_fit();
+    assert(!interleaved::is_mapped(myVec1.capacity()) && myVec1[9] == 9);
+
+    // Test first touch vectors filled in parallel
+    asd::parallel::thread_pool pool(4);
+    asd::vector<double, asd::numa_allocator<double>> myVec3;
+    asd::parallel::resize(pool, myVec3, 1 << 22);
+    assert(myVec3.size() == (1 << 22) && myVec3[0] == 0.0 && myVec3[(1 << 22) - 1] == 0.0);
+    assert(policy_of(myVec3.data()) == 0);
+    asd::parallel::resize(pool, myVec3, 3 << 22, 2.5);
+    assert(myVec3.size() == (3 << 22) && myVec3[(1 << 22) - 1] == 0.0 && myVec3[1 << 22] == 2.5 && myVec3.back() == 2.5);
+    asd::vector<double, asd::numa_allocator<double>> myVec4(asd::numa_allocator<double>(asd::numa_policy::node, 0));
+    asd::parallel::resize(pool, myVec4, 1 << 22, 1.0);
+    assert(policy_of(myVec4.data()) == 1 && asd::parallel::reduce(pool, myVec4, 0.0) == (1 << 22));
+
+    std::cout << "numa_allocator examples done" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,694 @@
+/*
+ * Copyright (C) 2023 Sofyan Gaber <sofyanhalaby@gmail.com>
+ *
+ * This code is for demonstration and educational purposes. It
+ * implements a compressed integer vector class.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ASD_PACKED_INT_VECTOR_2023
+#define ASD_PACKED_INT_VECTOR_2023
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include "vector.hpp"
+#include "static_vector.hpp"
+#include "simd.hpp"
+
+namespace asd
+{
+    namespace detail
+    {
+        /*
+        the kernels of asd::packed_int_vector blocks, a block packs 128 values of a bit width b in 4 lanes,
+        value i is item i / 4 of lane i % 4 and the lanes are interleaved a word at a time,
+        so one 256 bit load brings the same word of every lane and 4 values are unpacked by the same shifts
+        a lane holds 32 values in (b + 1) / 2 words, a block 4 * ((b + 1) / 2) words
+        */
+        namespace packing
+        {
+            constexpr std::size_t block_size = 128;
+            constexpr std::size_t lanes = 4;
+
+            constexpr std::size_t block_words(unsigned bits) noexcept
+            {
+                return lanes * ((bits + 1) / 2);
+            }
+
+            constexpr std::uint64_t low_mask(unsigned bits) noexcept
+            {
+                return bits == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << bits) - 1;
+            }
+
+            /*
+            packs 128 values of at most bits bits to block_words(bits) words
+            */
+            inline void pack(const std::uint64_t *values, unsigned bits, std::uint64_t *words) noexcept
+            {
+                std::fill(words, words + block_words(bits), std::uint64_t(0));
+                if (bits == 0)
+                {
+                    return;
+                }
+                for (std::size_t p = 0; p < block_size / lanes; p++)
+                {
+                    std::size_t bit = p * bits;
+                    std::size_t w = bit / 64;
+                    unsigned s = static_cast<unsigned>(bit % 64);
+                    for (std::size_t j = 0; j < lanes; j++)
+                    {
+                        std::uint64_t value = values[p * lanes + j];
+                        words[w * lanes + j] |= value << s;
+                        if (s + bits > 64)
+                        {
+                            words[(w + 1) * lanes + j] |= value >> (64 - s);
+                        }
+                    }
+                }
+            }
+
+            namespace scalar
+            {
+                /*
+                decodes the 128 values of a block, delta blocks hold the differences to the previous value
+                (the first one is 0), the other ones the differences to base
+                */
+                inline void decode(const std::uint64_t *words, unsigned bits, bool delta, std::uint64_t base, std::uint64_t *out) noexcept
+                {
+                    std::uint64_t mask = low_mask(bits);
+                    for (std::size_t p = 0; p < block_size / lanes; p++)
+                    {
+                        std::size_t bit = p * bits;
+                        std::size_t w = bit / 64;
+                        unsigned s = static_cast<unsigned>(bit % 64);
+                        for (std::size_t j = 0; j < lanes; j++)
+                        {
+                            std::uint64_t value = 0;
+                            if (bits != 0)
+                            {
+                                value = words[w * lanes + j] >> s;
+                                if (s + bits > 64)
+                                {
+                                    value |= words[(w + 1) * lanes + j] << (64 - s);
+                                }
+                            }
+                            out[p * lanes + j] = value & mask;
+                        }
+                    }
+                    for (std::size_t i = 0; i < block_size; i++)
+                    {
+                        base = delta ? base + out[i] : base;
+                        out[i] = delta ? base : base + out[i];
+                    }
+                }
+
+                /*
+                writes the values common to the sorted a[i, na) and b[j, nb) to out, until one of them ends
+                i and j are left at the first values not consumed, it returns the number of values written
+                out needs room for min(na - i, nb - j) + 4 values
+                */
+                inline std::size_t intersect(const std::uint64_t *a, std::size_t &i, std::size_t na,
+                                             const std::uint64_t *b, std::size_t &j, std::size_t nb, std::uint64_t *out) noexcept
+                {
+                    std::size_t count = 0;
+                    while (i < na && j < nb)
+                    {
+                        if (a[i] < b[j])
+                        {
+                            ++i;
+                        }
+                        else if (b[j] < a[i])
+                        {
+                            ++j;
+                        }
+                        else
+                        {
+                            out[count++] = a[i];
+                            ++i;
+                            ++j;
+                        }
+                    }
+                    return count;
+                }
+            }
+        }
+    }
+}
+
+#ifdef ASD_SIMD_X86
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx2,popcnt,bmi"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("avx2,popcnt,bmi")
+#endif
+namespace asd
+{
+    namespace detail
+    {
+        namespace packing
+        {
+            namespace avx2
+            {
+                /*
+                step P unpacks values 4P to 4P + 3, the shifts are constants of the width
+                */
+                template <unsigned Bits, bool Delta, std::size_t P>
+                inline void decode_step(const std::uint64_t *words, __m256i &carry, std::uint64_t *out) noexcept
+                {
+                    constexpr std::size_t w = P * Bits / 64;
+                    constexpr unsigned s = static_cast<unsigned>(P * Bits % 64);
+                    __m256i value = _mm256_setzero_si256();
+                    if constexpr (Bits != 0)
+                    {
+                        value = _mm256_srli_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(words + w * lanes)), s);
+                        if constexpr (s + Bits > 64)
+                        {
+                            __m256i next = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(words + (w + 1) * lanes));
+                            value = _mm256_or_si256(value, _mm256_slli_epi64(next, 64 - s));
+                        }
+                        if constexpr (s + Bits != 64)
+                        {
+                            value = _mm256_and_si256(value, _mm256_set1_epi64x(static_cast<long long>(low_mask(Bits))));
+                        }
+                    }
+                    if constexpr (Delta)
+                    {
+                        // [d0, d1, d2, d3] -> [d0, d0 + d1, d1 + d2, d2 + d3] -> the prefix sums, then the carry
+                        const __m256i zero = _mm256_setzero_si256();
+                        value = _mm256_add_epi64(value, _mm256_blend_epi32(_mm256_permute4x64_epi64(value, _MM_SHUFFLE(2, 1, 0, 0)), zero, 0x03));
+                        value = _mm256_add_epi64(value, _mm256_blend_epi32(_mm256_permute4x64_epi64(value, _MM_SHUFFLE(1, 0, 0, 0)), zero, 0x0f));
+                        value = _mm256_add_epi64(value, carry);
+                        carry = _mm256_permute4x64_epi64(value, _MM_SHUFFLE(3, 3, 3, 3));
+                    }
+                    else
+                    {
+                        value = _mm256_add_epi64(value, carry);
+                    }
+                    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + P * lanes), value);
+                }
+
+                template <unsigned Bits, bool Delta, std::size_t... P>
+                inline void decode_steps(const std::uint64_t *words, std::uint64_t base, std::uint64_t *out, std::index_sequence<P...>) noexcept
+                {
+                    __m256i carry = _mm256_set1_epi64x(static_cast<long long>(base));
+                    (decode_step<Bits, Delta, P>(words, carry, out), ...);
+                }
+
+                template <unsigned Bits, bool Delta>
+                void decode_width(const std::uint64_t *words, std::uint64_t base, std::uint64_t *out) noexcept
+                {
+                    decode_steps<Bits, Delta>(words, base, out, std::make_index_sequence<block_size / lanes>());
+                }
+
+                using decoder = void (*)(const std::uint64_t *, std::uint64_t, std::uint64_t *) noexcept;
+
+                template <std::size_t... Bits>
+                constexpr auto make_decoders(std::index_sequence<Bits...>) noexcept
+                {
+                    return std::array<decoder, 2 * sizeof...(Bits)>{&decode_width<Bits, false>..., &decode_width<Bits, true>...};
+                }
+
+                /*
+                one unrolled decoder per width and kind of block, chosen by a table lookup
+                */
+                inline void decode(const std::uint64_t *words, unsigned bits, bool delta, std::uint64_t base, std::uint64_t *out) noexcept
+                {
+                    static constexpr std::array<decoder, 130> decoders = make_decoders(std::make_index_sequence<65>());
+                    decoders[(delta ? 65 : 0) + bits](words, base, out);
+                }
+
+                /*
+                the 32 bit lanes that move the 64 bit lanes set in found to the front
+                */
+                inline __m256i compress_mask(unsigned found) noexcept
+                {
+                    alignas(32) static constexpr std::int32_t lanes_of[16][8] = {
+                        {0, 1, 2, 3, 4, 5, 6, 7}, {0, 1, 2, 3, 4, 5, 6, 7}, {2, 3, 0, 1, 4, 5, 6, 7}, {0, 1, 2, 3, 4, 5, 6, 7},
+                        {4, 5, 0, 1, 2, 3, 6, 7}, {0, 1, 4, 5, 2, 3, 6, 7}, {2, 3, 4, 5, 0, 1, 6, 7}, {0, 1, 2, 3, 4, 5, 6, 7},
+                        {6, 7, 0, 1, 2, 3, 4, 5}, {0, 1, 6, 7, 2, 3, 4, 5}, {2, 3, 6, 7, 0, 1, 4, 5}, {0, 1, 2, 3, 6, 7, 4, 5},
+                        {4, 5, 6, 7, 0, 1, 2, 3}, {0, 1, 4, 5, 6, 7, 2, 3}, {2, 3, 4, 5, 6, 7, 0, 1}, {0, 1, 2, 3, 4, 5, 6, 7}};
+                    return _mm256_load_si256(reinterpret_cast<const __m256i *>(lanes_of[found]));
+                }
+
+                /*
+                compares 4 values of a with 4 values of b in all 16 pairs per step, by 4 rotations of b,
+                then moves past the 4 values that end first, so a step has no branch per value
+                */
+                inline std::size_t intersect(const std::uint64_t *a, std::size_t &i, std::size_t na,
+                                             const std::uint64_t *b, std::size_t &j, std::size_t nb, std::uint64_t *out) noexcept
+                {
+                    std::size_t count = 0;
+                    while (i + lanes <= na && j + lanes <= nb)
+                    {
+                        __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+                        __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + j));
+                        __m256i equal = _mm256_cmpeq_epi64(va, vb);
+                        equal = _mm256_or_si256(equal, _mm256_cmpeq_epi64(va, _mm256_permute4x64_epi64(vb, _MM_SHUFFLE(0, 3, 2, 1))));
+                        equal = _mm256_or_si256(equal, _mm256_cmpeq_epi64(va, _mm256_permute4x64_epi64(vb, _MM_SHUFFLE(1, 0, 3, 2))));
+                        equal = _mm256_or_si256(equal, _mm256_cmpeq_epi64(va, _mm256_permute4x64_epi64(vb, _MM_SHUFFLE(2, 1, 0, 3))));
+                        unsigned found = static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(equal)));
+                        // the matches are moved to the low lanes and stored together, out has room for 4 more
+                        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + count), _mm256_permutevar8x32_epi32(va, compress_mask(found)));
+                        count += static_cast<std::size_t>(_mm_popcnt_u32(found));
+                        std::uint64_t a_last = a[i + lanes - 1];
+                        std::uint64_t b_last = b[j + lanes - 1];
+                        i += a_last <= b_last ? lanes : 0;
+                        j += b_last <= a_last ? lanes : 0;
+                    }
+                    return count + scalar::intersect(a, i, na, b, j, nb, out + count);
+                }
+            }
+        }
+    }
+}
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+#endif //ifdef ASD_SIMD_X86
+
+namespace asd
+{
+    namespace detail
+    {
+        namespace packing
+        {
+            inline void decode(const std::uint64_t *words, unsigned bits, bool delta, std::uint64_t base, std::uint64_t *out) noexcept
+            {
+#ifdef ASD_SIMD_X86
+                simd::isa set = simd::active_isa();
+                if (set == simd::isa::avx2 || set == simd::isa::avx512)
+                {
+                    avx2::decode(words, bits, delta, base, out);
+                    return;
+                }
+#endif
+                scalar::decode(words, bits, delta, base, out);
+            }
+
+            inline std::size_t intersect(const std::uint64_t *a, std::size_t &i, std::size_t na,
+                                         const std::uint64_t *b, std::size_t &j, std::size_t nb, std::uint64_t *out) noexcept
+            {
+#ifdef ASD_SIMD_X86
+                simd::isa set = simd::active_isa();
+                if (set == simd::isa::avx2 || set == simd::isa::avx512)
+                {
+                    return avx2::intersect(a, i, na, b, j, nb, out);
+                }
+#endif
+                return scalar::intersect(a, i, na, b, j, nb, out);
+            }
+        }
+    }
+
+    /*
+    class asd::packed_int_vector is an append only vector of 64 bit integers compressed in blocks of 128 values
+    a block of sorted values keeps the differences between neighbours (delta), any other block the differences
+    to its smallest value (frame of reference), and both are bit packed to the width of their largest difference,
+    so sorted ids with small gaps take a few bits each instead of 64
+    the values of the last block stay unpacked until a value comes after it
+    operator[] jumps to the block of the item and decodes only that block, lower_bound and contains skip
+    the blocks of sorted vectors by a binary search over their first values, reader decodes the blocks
+    one after the other into an asd::vector, and asd::intersect finds the common values of two sorted lists
+    skipping the blocks that can't overlap, blocks are decoded with AVX2 where the CPU has it
+    */
+    class packed_int_vector
+    {
+    public:
+        static constexpr std::size_t block_size = detail::packing::block_size;
+
+    private:
+        struct block
+        {
+            std::uint64_t base; // the first value of a delta block, the smallest of a frame of reference one
+            std::uint64_t offset : 56; // the first word of the block
+            std::uint64_t bits : 7;
+            std::uint64_t delta : 1;
+        };
+
+        vector<block> m_blocks;
+        vector<std::uint64_t> m_words;
+        static_vector<std::uint64_t, block_size> m_tail;
+        std::uint64_t m_last; // the last value appended
+        bool m_sorted;
+        bool m_unique; // every value is greater than the previous one
+
+        void seal()
+        {
+            const std::uint64_t *values = m_tail.data();
+            bool delta = std::is_sorted(values, values + block_size);
+            std::uint64_t base = delta ? values[0] : *std::min_element(values, values + block_size);
+            std::uint64_t differences[block_size];
+            std::uint64_t any = 0;
+            for (std::size_t i = 0; i < block_size; i++)
+            {
+                differences[i] = delta ? values[i] - (i == 0 ? base : values[i - 1]) : values[i] - base;
+                any |= differences[i];
+            }
+            unsigned bits = any == 0 ? 0 : static_cast<unsigned>(64 - __builtin_clzll(any));
+            std::size_t offset = m_words.size();
+            block header{};
+            header.base = base;
+            header.offset = offset;
+            header.bits = bits;
+            header.delta = delta;
+            m_blocks.push_back(header);
+            try
+            {
+                m_words.resize_uninitialized(offset + detail::packing::block_words(bits));
+            }
+            catch (...)
+            {
+                m_blocks.pop_back();
+                throw;
+            }
+            detail::packing::pack(differences, bits, m_words.data() + offset);
+            m_tail.erase(0, m_tail.size());
+        }
+
+        /*
+        the first value of block b, the blocks are followed by the tail
+        */
+        std::uint64_t first_of(std::size_t b) const noexcept
+        {
+            return b < m_blocks.size() ? m_blocks[b].base : m_tail[0];
+        }
+
+        void check_sorted() const
+        {
+            if (!m_sorted)
+            {
+                throw std::logic_error("packed_int_vector is not sorted");
+            }
+        }
+
+    public:
+        /*
+        streams the values a block at a time, next() decodes the next block into an asd::vector that is reused
+        */
+        class reader
+        {
+            const packed_int_vector *m_items;
+            std::size_t m_block;
+
+        public:
+            explicit reader(const packed_int_vector &items) noexcept
+                : m_items(&items), m_block(0)
+            {
+            }
+
+            /*
+            replaces the items of out with the values of the next block, false after the last block
+            */
+            bool next(vector<std::uint64_t> &out)
+            {
+                if (m_block >= m_items->block_count())
+                {
+                    return false;
+                }
+                out.resize_uninitialized(m_items->block_length(m_block));
+                m_items->decode_block(m_block++, out.data());
+                return true;
+            }
+
+            /*
+            skips the blocks whose values are all less than value without decoding them,
+            the block that may have value is the next one, for sorted vectors only
+            */
+            void skip_to(std::uint64_t value) noexcept
+            {
+                while (m_block + 1 < m_items->block_count() && m_items->first_of(m_block + 1) < value)
+                {
+                    ++m_block;
+                }
+            }
+        };
+
+        packed_int_vector() noexcept
+            : m_last(0), m_sorted(true), m_unique(true)
+        {
+        }
+
+        /*
+        a full last block is packed before value is added, so when packing fails nothing changes
+        it raises the bad_alloc exception
+        */
+        void push_back(std::uint64_t value)
+        {
+            if (m_tail.full())
+            {
+                seal();
+            }
+            m_tail.push_back(value);
+            m_sorted = m_sorted && value >= m_last;
+            m_unique = m_unique && (size() == 1 || value > m_last);
+            m_last = value;
+        }
+
+        template <typename InputIt, typename = std::enable_if_t<is_iterator_v<InputIt>>>
+        void append(InputIt first, InputIt last)
+        {
+            for (; first != last; ++first)
+            {
+                push_back(static_cast<std::uint64_t>(*first));
+            }
+        }
+
+        std::size_t size() const noexcept
+        {
+            return m_blocks.size() * block_size + m_tail.size();
+        }
+
+        bool empty() const noexcept
+        {
+            return size() == 0;
+        }
+
+        /*
+        whether every value is greater than or equal to the previous one
+        */
+        bool is_sorted() const noexcept
+        {
+            return m_sorted;
+        }
+
+        /*
+        number of blocks, the unfinished last block included
+        */
+        std::size_t block_count() const noexcept
+        {
+            return m_blocks.size() + (m_tail.empty() ? 0 : 1);
+        }
+
+        std::size_t block_length(std::size_t b) const noexcept
+        {
+            return b < m_blocks.size() ? block_size : m_tail.size();
+        }
+
+        /*
+        writes the block_length(b) values of block b to out
+        */
+        void decode_block(std::size_t b, std::uint64_t *out) const noexcept
+        {
+            if (b < m_blocks.size())
+            {
+                const block &header = m_blocks[b];
+                detail::packing::decode(m_words.data() + header.offset, static_cast<unsigned>(header.bits), header.delta, header.base, out);
+            }
+            else
+            {
+                std::copy(m_tail.begin(), m_tail.end(), out);
+            }
+        }
+
+        /*
+        appends all values to out
+        it raises the bad_alloc exception
+        */
+        void decode(vector<std::uint64_t> &out) const
+        {
+            std::size_t first = out.size();
+            out.resize_uninitialized(first + size());
+            for (std::size_t b = 0; b < block_count(); b++)
+            {
+                decode_block(b, out.data() + first + b * block_size);
+            }
+        }
+
+        /*
+        the value at index i, only its block is decoded
+        */
+        std::uint64_t operator[](std::size_t i) const noexcept
+        {
+            std::size_t b = i / block_size;
+            if (b == m_blocks.size())
+            {
+                return m_tail[i % block_size];
+            }
+            std::uint64_t values[block_size];
+            decode_block(b, values);
+            return values[i % block_size];
+        }
+
+        /*
+        the index of the first value not less than value, size() when there is none
+        it raises the logic_error exception when the vector is not sorted
+        */
+        std::size_t lower_bound(std::uint64_t value) const
+        {
+            check_sorted();
+            std::size_t blocks = block_count();
+            // the last block that starts below value, the values before it are all less than value
+            std::size_t low = 0;
+            std::size_t high = blocks;
+            while (low < high)
+            {
+                std::size_t middle = low + (high - low) / 2;
+                if (first_of(middle) < value)
+                {
+                    low = middle + 1;
+                }
+                else
+                {
+                    high = middle;
+                }
+            }
+            if (low == 0)
+            {
+                return 0;
+            }
+            std::size_t b = low - 1;
+            std::uint64_t values[block_size];
+            decode_block(b, values);
+            std::size_t n = block_length(b);
+            return b * block_size + static_cast<std::size_t>(std::lower_bound(values, values + n, value) - values);
+        }
+
+        bool contains(std::uint64_t value) const
+        {
+            std::size_t i = lower_bound(value);
+            return i != size() && (*this)[i] == value;
+        }
+
+        /*
+        number of bytes of the packed words, the block headers and the unfinished block
+        */
+        std::size_t encoded_bytes() const noexcept
+        {
+            return m_words.size() * sizeof(std::uint64_t) + m_blocks.size() * sizeof(block) + m_tail.size() * sizeof(std::uint64_t);
+        }
+
+        /*
+        bytes the vector takes, its header and unfinished block plus the memory reserved for the blocks,
+        see asd::vector::memory_usage
+        */
+        std::size_t memory_usage() const noexcept
+        {
+            return sizeof(*this) - sizeof(m_words) - sizeof(m_blocks) + m_words.memory_usage() + m_blocks.memory_usage();
+        }
+
+        void shrink_to_fit()
+        {
+            m_words.shrink_to_fit();
+            m_blocks.shrink_to_fit();
+        }
+
+        friend void intersect(const packed_int_vector &a, const packed_int_vector &b, vector<std::uint64_t> &out);
+    };
+
+    /*
+    appends the values common to the sorted vectors a and b to out, once per pair of equal values
+    as std::set_intersection does, a value repeated m times in a and n times in b is there min(m, n) times
+    the AVX2 all pairs compare is used when both vectors are strictly increasing, duplicates take the merge
+    the blocks of one vector that end before the current block of the other one are skipped without decoding
+    it raises the logic_error exception when a vector is not sorted, and the bad_alloc exception
+    */
+    inline void intersect(const packed_int_vector &a, const packed_int_vector &b, vector<std::uint64_t> &out)
+    {
+        a.check_sorted();
+        b.check_sorted();
+        constexpr std::size_t n = packed_int_vector::block_size;
+        std::uint64_t a_values[n];
+        std::uint64_t b_values[n];
+        std::uint64_t common[n + 4]; // the avx2 kernel stores 4 values at a time
+        std::size_t a_block = 0;
+        std::size_t b_block = 0;
+        std::size_t a_count = 0; // values of the decoded block, 0 while it isn't decoded
+        std::size_t b_count = 0;
+        std::size_t i = 0;
+        std::size_t j = 0;
+        while (a_block < a.block_count() && b_block < b.block_count())
+        {
+            // a block has no value above the first value of the next block
+            if (a_count == 0 && a_block + 1 < a.block_count() && a.first_of(a_block + 1) < (b_count == 0 ? b.first_of(b_block) : b_values[j]))
+            {
+                ++a_block;
+                continue;
+            }
+            if (b_count == 0 && b_block + 1 < b.block_count() && b.first_of(b_block + 1) < (a_count == 0 ? a.first_of(a_block) : a_values[i]))
+            {
+                ++b_block;
+                continue;
+            }
+            if (a_count == 0)
+            {
+                a.decode_block(a_block, a_values);
+                a_count = a.block_length(a_block);
+                i = 0;
+            }
+            if (b_count == 0)
+            {
+                b.decode_block(b_block, b_values);
+                b_count = b.block_length(b_block);
+                j = 0;
+            }
+            std::size_t found = a.m_unique && b.m_unique ? detail::packing::intersect(a_values, i, a_count, b_values, j, b_count, common)
+                                                         : detail::packing::scalar::intersect(a_values, i, a_count, b_values, j, b_count, common);
+            out.insert(out.size(), common, common + found);
+            // the kernel stops a few values behind on the other side, move it up to the values that can still match
+            if (i == a_count)
+            {
+                j = static_cast<std::size_t>(std::lower_bound(b_values + j, b_values + b_count, a_values[a_count - 1]) - b_values);
+            }
+            if (j == b_count)
+            {
+                i = static_cast<std::size_t>(std::lower_bound(a_values + i, a_values + a_count, b_values[b_count - 1]) - a_values);
+            }
+            if (i == a_count)
+            {
+                ++a_block;
+                a_count = 0;
+            }
+            if (j == b_count)
+            {
+                ++b_block;
+                b_count = 0;
+            }
+        }
+    }
+}
+
+#endif //ifndef ASD_PACKED_INT_VECTOR_2023
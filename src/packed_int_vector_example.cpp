@@ -0,0 +1,184 @@
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <cstdint>
+#include <assert.h>
+#include "packed_int_vector.hpp"
+
+// sorted ids with random gaps below max_gap
+asd::vector<std::uint64_t> sorted_ids(std::size_t n, std::uint64_t max_gap, std::uint64_t seed)
+{
+    std::mt19937_64 random(seed);
+    asd::vector<std::uint64_t> ids;
+    std::uint64_t id = random() % 1000;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        id += 1 + random() % max_gap;
+        ids.push_back(id);
+    }
+    return ids;
+}
+
+void check_same(const asd::packed_int_vector &packed, const asd::vector<std::uint64_t> &plain)
+{
+    assert(packed.size() == plain.size());
+    for (std::size_t i = 0; i < plain.size(); ++i)
+    {
+        assert(packed[i] == plain[i]);
+    }
+    asd::vector<std::uint64_t> decoded;
+    decoded.push_back(7);
+    packed.decode(decoded);
+    assert(decoded.size() == plain.size() + 1 && decoded[0] == 7 && std::equal(plain.begin(), plain.end(), decoded.begin() + 1));
+}
+
+void check_intersect(const asd::vector<std::uint64_t> &plain1, const asd::vector<std::uint64_t> &plain2)
+{
+    asd::packed_int_vector packed1;
+    asd::packed_int_vector packed2;
+    packed1.append(plain1.begin(), plain1.end());
+    packed2.append(plain2.begin(), plain2.end());
+    std::vector<std::uint64_t> stdVec;
+    std::set_intersection(plain1.begin(), plain1.end(), plain2.begin(), plain2.end(), std::back_inserter(stdVec));
+    asd::vector<std::uint64_t> common;
+    asd::intersect(packed1, packed2, common);
+    assert(common.size() == stdVec.size() && std::equal(stdVec.begin(), stdVec.end(), common.begin()));
+    common.erase(0, common.size());
+    asd::intersect(packed2, packed1, common);
+    assert(common.size() == stdVec.size() && std::equal(stdVec.begin(), stdVec.end(), common.begin()));
+}
+
+int main()
+{
+    for (asd::simd::isa set : {asd::simd::isa::scalar, asd::simd::isa::avx2})
+    {
+        if (!asd::simd::is_supported(set))
+        {
+            continue;
+        }
+        asd::simd::use_isa(set);
+
+        // Test sorted ids take a few bits each and read back by index and by decode
+        asd::vector<std::uint64_t> myVec1 = sorted_ids(100000, 50, 1);
+        asd::packed_int_vector myPacked1;
+        assert(myPacked1.empty() && myPacked1.is_sorted() && myPacked1.block_count() == 0);
+        myPacked1.append(myVec1.begin(), myVec1.end());
+        assert(myPacked1.is_sorted() && myPacked1.block_count() == (100000 + 127) / 128);
+        assert(myPacked1.encoded_bytes() * 6 < myVec1.size() * sizeof(std::uint64_t));
+        assert(myPacked1.memory_usage() >= myPacked1.encoded_bytes() && myPacked1.memory_usage() * 4 < myVec1.memory_usage());
+        check_same(myPacked1, myVec1);
+
+        // Test unsorted blocks are packed against their smallest value, every width up to 64 bits
+        std::mt19937_64 random(2);
+        for (unsigned bits : {0u, 1u, 7u, 31u, 33u, 63u, 64u})
+        {
+            asd::vector<std::uint64_t> myVec2;
+            asd::packed_int_vector myPacked2;
+            for (std::size_t i = 0; i < 1000; ++i)
+            {
+                std::uint64_t value = (std::uint64_t(1) << 40) + (bits == 0 ? 0 : random() >> (64 - bits));
+                myVec2.push_back(value);
+                myPacked2.push_back(value);
+            }
+            assert(myPacked2.is_sorted() == (bits == 0));
+            check_same(myPacked2, myVec2);
+        }
+        // Test sizes that fill the last block exactly
+        for (std::size_t n : {128, 256, 257})
+        {
+            asd::vector<std::uint64_t> myVec9 = sorted_ids(n, 9, n);
+            asd::packed_int_vector myPacked7;
+            myPacked7.append(myVec9.begin(), myVec9.end());
+            assert(myPacked7.block_count() == (n + 127) / 128 && myPacked7.lower_bound(myVec9.back()) == n - 1);
+            check_same(myPacked7, myVec9);
+        }
+        asd::vector<std::uint64_t> myVec3;
+        myVec3.push_back(~std::uint64_t(0));
+        myVec3.push_back(0);
+        asd::packed_int_vector myPacked3;
+        myPacked3.append(myVec3.begin(), myVec3.end());
+        check_same(myPacked3, myVec3);
+
+        // Test the reader streams the blocks into an asd::vector and skips blocks
+        asd::packed_int_vector::reader reader(myPacked1);
+        asd::vector<std::uint64_t> myVec4;
+        asd::vector<std::uint64_t> block;
+        while (reader.next(block))
+        {
+            assert(block.size() == 128 || myVec4.size() == 99968);
+            myVec4.append(block.begin(), block.end());
+        }
+        assert(myVec4.size() == myVec1.size() && std::equal(myVec1.begin(), myVec1.end(), myVec4.begin()));
+        asd::packed_int_vector::reader skipping(myPacked1);
+        skipping.skip_to(myVec1[50000]);
+        assert(skipping.next(block) && block.front() <= myVec1[50000] && block.back() >= myVec1[50000]);
+        assert(block.front() == myVec1[50000 / 128 * 128]);
+
+        // Test lower_bound and contains
+        assert(myPacked1.lower_bound(0) == 0 && myPacked1.lower_bound(myVec1.back() + 1) == myPacked1.size());
+        for (std::size_t i = 0; i < myVec1.size(); i += 997)
+        {
+            assert(myPacked1.lower_bound(myVec1[i]) == i && myPacked1.contains(myVec1[i]));
+            assert(myPacked1.lower_bound(myVec1[i] - 1) == (myVec1[i - (i != 0)] == myVec1[i] - 1 ? i - 1 : i));
+        }
+        assert(myPacked1.lower_bound(myVec1[127] + 1) == 128 && myPacked1.lower_bound(myVec1.back()) == myVec1.size() - 1);
+        assert(!myPacked1.contains(myVec1[5] + 1) || myVec1[6] == myVec1[5] + 1);
+        bool thrown = false;
+        try
+        {
+            asd::packed_int_vector myPacked4;
+            myPacked4.append(myVec3.begin(), myVec3.end());
+            myPacked4.contains(1);
+        }
+        catch (const std::logic_error &)
+        {
+            thrown = true;
+        }
+        assert(thrown);
+
+        // Test intersect matches std::set_intersection, with dense, sparse, disjoint and empty lists
+        check_intersect(sorted_ids(20000, 4, 3), sorted_ids(30000, 6, 4));
+        check_intersect(sorted_ids(100000, 3, 5), sorted_ids(500, 600, 6));
+        check_intersect(myVec1, myVec1);
+        check_intersect(myVec1, asd::vector<std::uint64_t>());
+        asd::vector<std::uint64_t> myVec5 = sorted_ids(1000, 10, 7);
+        for (auto &id : myVec5)
+        {
+            id += myVec1.back();
+        }
+        check_intersect(myVec1, myVec5);
+        check_intersect(sorted_ids(100, 2, 8), sorted_ids(90, 2, 8));
+
+        // Test repeated values are matched once per pair, the same with every instruction set
+        asd::vector<std::uint64_t> myVec6;
+        asd::vector<std::uint64_t> myVec7;
+        myVec6.insert(0, 8, 5);
+        for (std::uint64_t value = 5; value <= 12; ++value)
+        {
+            myVec7.push_back(value);
+        }
+        check_intersect(myVec6, myVec7);
+        asd::vector<std::uint64_t> myVec8;
+        for (std::uint64_t value = 0; value < 1000; ++value)
+        {
+            myVec8.insert(myVec8.size(), 1 + value % 3, value);
+        }
+        check_intersect(myVec8, sorted_ids(500, 3, 9));
+        check_intersect(myVec8, myVec6);
+        asd::packed_int_vector myPacked5;
+        asd::packed_int_vector myPacked6;
+        myPacked5.append(myVec6.begin(), myVec6.end());
+        myPacked6.append(myVec7.begin(), myVec7.end());
+        asd::vector<std::uint64_t> common;
+        asd::intersect(myPacked5, myPacked6, common);
+        assert(common.size() == 1 && common[0] == 5);
+    }
+    asd::simd::use_isa(asd::simd::best_isa());
+
+    std::cout << "packed_int_vector examples done" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,783 @@
+/*
+ * Copyright (C) 2023 Sofyan Gaber <sofyanhalaby@gmail.com>
+ *
+ * This code is for demonstration and educational purposes. It
+ * implements parallel algorithms over vectors on a work stealing thread pool.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ASD_PARALLEL_2023
+#define ASD_PARALLEL_2023
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include "vector.hpp"
+#include "vector_view.hpp"
+
+/*
+asd::parallel runs algorithms over the items of a vector on a pool of threads
+the items are split into chunks, every thread of the pool owns a range of chunks and takes them
+from its front, a thread that runs out steals the back half of the range of another thread,
+so uneven chunks are balanced without a shared queue
+the kernels take pointer + count, or any container with data() and size() such as asd::vector,
+the overloads without a pool run on thread_pool::global()
+*/
+namespace asd
+{
+    namespace parallel
+    {
+        /*
+        class asd::parallel::thread_pool runs the chunks of a job on size() threads, the calling thread is one of them
+        jobs run one at a time, a job started from inside a chunk runs serially on the calling thread
+        an exception thrown by a chunk skips the chunks not started yet and is rethrown by run()
+        */
+        class thread_pool
+        {
+            // the chunk range of one thread, every slot has its own cache line so threads taking chunks don't contend
+            struct alignas(64) slot
+            {
+                std::mutex lock;
+                std::size_t begin = 0;
+                std::size_t end = 0;
+            };
+
+            std::size_t m_size; // number of threads including the calling thread
+            std::unique_ptr<slot[]> m_slots;
+            vector<std::thread> m_workers;
+            std::mutex m_job_lock; // held by run() so jobs run one at a time
+            std::mutex m_lock;
+            std::condition_variable m_wake;
+            std::condition_variable m_done;
+            std::size_t m_generation = 0; // number of jobs started, workers wake up when it changes
+            std::size_t m_active = 0; // number of workers still in the current job
+            bool m_stop = false;
+            void (*m_invoke)(const void *, std::size_t) = nullptr;
+            const void *m_context = nullptr;
+            std::atomic<bool> m_failed{false};
+            std::exception_ptr m_error;
+
+            /*
+            tells whether the current thread runs a chunk, a nested job then runs serially instead of waiting for itself
+            */
+            static bool &inside() noexcept
+            {
+                static thread_local bool value = false;
+                return value;
+            }
+
+            bool take(std::size_t self, std::size_t &chunk)
+            {
+                std::lock_guard<std::mutex> lock(m_slots[self].lock);
+                if (m_slots[self].begin == m_slots[self].end)
+                {
+                    return false;
+                }
+                chunk = m_slots[self].begin++;
+                return true;
+            }
+
+            /*
+            moves the back half of the range of the first thread that has chunks left to self and takes its first chunk
+            */
+            bool steal(std::size_t self, std::size_t &chunk)
+            {
+                for (std::size_t i = 1; i < m_size; ++i)
+                {
+                    slot &victim = m_slots[(self + i) % m_size];
+                    std::size_t begin;
+                    std::size_t end;
+                    {
+                        std::lock_guard<std::mutex> lock(victim.lock);
+                        if (victim.begin == victim.end)
+                        {
+                            continue;
+                        }
+                        begin = victim.begin + (victim.end - victim.begin) / 2;
+                        end = victim.end;
+                        victim.end = begin;
+                    }
+                    chunk = begin;
+                    if (begin + 1 != end)
+                    {
+                        std::lock_guard<std::mutex> lock(m_slots[self].lock);
+                        m_slots[self].begin = begin + 1;
+                        m_slots[self].end = end;
+                    }
+                    return true;
+                }
+                return false;
+            }
+
+            void work(std::size_t self)
+            {
+                bool was_inside = inside();
+                inside() = true;
+                std::size_t chunk;
+                while (take(self, chunk) || steal(self, chunk))
+                {
+                    if (m_failed.load(std::memory_order_relaxed))
+                    {
+                        continue;
+                    }
+                    try
+                    {
+                        m_invoke(m_context, chunk);
+                    }
+                    catch (...)
+                    {
+                        std::lock_guard<std::mutex> lock(m_lock);
+                        if (!m_error)
+                        {
+                            m_error = std::current_exception();
+                        }
+                        m_failed.store(true, std::memory_order_relaxed);
+                    }
+                }
+                inside() = was_inside;
+            }
+
+            void worker(std::size_t self)
+            {
+                std::size_t seen = 0;
+                for (;;)
+                {
+                    {
+                        std::unique_lock<std::mutex> lock(m_lock);
+                        m_wake.wait(lock, [&] { return m_stop || m_generation != seen; });
+                        if (m_stop)
+                        {
+                            return;
+                        }
+                        seen = m_generation;
+                    }
+                    work(self);
+                    std::lock_guard<std::mutex> lock(m_lock);
+                    if (--m_active == 0)
+                    {
+                        m_done.notify_one();
+                    }
+                }
+            }
+        public:
+            /*
+            creates a pool of threads threads, the calling thread of run() is one of them so threads - 1 are started
+            */
+            explicit thread_pool(std::size_t threads = std::thread::hardware_concurrency())
+                : m_size(threads == 0 ? 1 : threads), m_slots(new slot[m_size])
+            {
+                m_workers.reserve(m_size - 1);
+                try
+                {
+                    for (std::size_t i = 1; i < m_size; ++i)
+                    {
+                        m_workers.emplace_back([this, i] { worker(i); });
+                    }
+                }
+                catch (...)
+                {
+                    stop();
+                    throw;
+                }
+            }
+
+            thread_pool(const thread_pool &) = delete;
+            thread_pool &operator=(const thread_pool &) = delete;
+
+            ~thread_pool() noexcept
+            {
+                stop();
+            }
+
+            /*
+            the pool the overloads without a pool use, it has a thread per hardware thread
+            */
+            static thread_pool &global()
+            {
+                static thread_pool pool;
+                return pool;
+            }
+
+            std::size_t size() const noexcept
+            {
+                return m_size;
+            }
+
+            /*
+            calls fn(i) for every chunk i in [0, chunks) on the threads of the pool and returns when all are done
+            fn is called concurrently so it must be safe to call from many threads
+            it raises the first exception thrown by fn
+            */
+            template <typename F>
+            void run(std::size_t chunks, const F &fn)
+            {
+                if (chunks == 1 || m_size == 1 || inside())
+                {
+                    for (std::size_t i = 0; i < chunks; ++i)
+                    {
+                        fn(i);
+                    }
+                    return;
+                }
+                if (chunks == 0)
+                {
+                    return;
+                }
+                std::lock_guard<std::mutex> job(m_job_lock);
+                for (std::size_t i = 0; i < m_size; ++i)
+                {
+                    m_slots[i].begin = chunks * i / m_size;
+                    m_slots[i].end = chunks * (i + 1) / m_size;
+                }
+                m_invoke = [](const void *context, std::size_t chunk) { (*static_cast<const F *>(context))(chunk); };
+                m_context = &fn;
+                m_failed.store(false, std::memory_order_relaxed);
+                {
+                    std::lock_guard<std::mutex> lock(m_lock);
+                    m_error = nullptr;
+                    m_active = m_size - 1;
+                    ++m_generation;
+                }
+                m_wake.notify_all();
+                work(0);
+                std::unique_lock<std::mutex> lock(m_lock);
+                m_done.wait(lock, [&] { return m_active == 0; });
+                if (m_error)
+                {
+                    std::rethrow_exception(std::exchange(m_error, nullptr));
+                }
+            }
+        private:
+            void stop() noexcept
+            {
+                {
+                    std::lock_guard<std::mutex> lock(m_lock);
+                    m_stop = true;
+                }
+                m_wake.notify_all();
+                for (std::size_t i = 0; i < m_workers.size(); ++i)
+                {
+                    m_workers[i].join();
+                }
+                m_workers.resize(0);
+            }
+        };
+
+        namespace detail
+        {
+            inline constexpr std::size_t cache_line = 64;
+
+            // chunks smaller than this don't pay for waking up a thread
+            inline constexpr std::size_t min_chunk_bytes = std::size_t(1) << 15;
+
+            // number of chunks per thread, more chunks balance uneven work better
+            inline constexpr std::size_t chunks_per_thread = 4;
+
+            /*
+            splits n items into chunks of size items, the first chunk also takes the head items before the first
+            cache line boundary of the output, so no two chunks write to the same cache line
+            */
+            struct chunking
+            {
+                std::size_t n;
+                std::size_t head;
+                std::size_t size;
+                std::size_t count;
+
+                std::size_t begin(std::size_t i) const noexcept
+                {
+                    return i == 0 ? 0 : std::min(n, head + i * size);
+                }
+
+                std::size_t end(std::size_t i) const noexcept
+                {
+                    return std::min(n, head + (i + 1) * size);
+                }
+            };
+
+            /*
+            chunks for n items of T written to output (nullptr for read only kernels) by threads threads,
+            a chunk is at least min_chunk_bytes and a multiple of a cache line, n fitting one chunk runs serially
+            */
+            template <typename T>
+            chunking split(const T *output, std::size_t n, std::size_t threads)
+            {
+                std::size_t line = cache_line % sizeof(T) == 0 ? cache_line / sizeof(T) : 1;
+                std::size_t parts = threads * chunks_per_thread;
+                std::size_t size = std::max<std::size_t>(min_chunk_bytes / sizeof(T), (n + parts - 1) / parts);
+                size = (size + line - 1) / line * line;
+                std::size_t head = 0;
+                std::size_t misalignment = reinterpret_cast<std::uintptr_t>(output) % cache_line;
+                if (output != nullptr && line > 1 && misalignment != 0 && misalignment % sizeof(T) == 0)
+                {
+                    head = std::min(n, (cache_line - misalignment) / sizeof(T));
+                }
+                std::size_t count = n == 0 ? 0 : (n <= head + size ? 1 : 1 + (n - head - 1) / size);
+                return chunking{n, head, size, count};
+            }
+
+            /*
+            number of items taken from a among the first diagonal items of merge(a, b), found by a binary search
+            on the merge path, so one merge can be split into independent parts
+            */
+            template <typename T, typename Compare>
+            std::size_t merge_split(const T *a, std::size_t na, const T *b, std::size_t nb, std::size_t diagonal, Compare &comp)
+            {
+                std::size_t lo = diagonal > nb ? diagonal - nb : 0;
+                std::size_t hi = std::min(diagonal, na);
+                while (lo < hi)
+                {
+                    std::size_t i = lo + (hi - lo) / 2;
+                    if (comp(b[diagonal - i - 1], a[i]))
+                    {
+                        hi = i;
+                    }
+                    else
+                    {
+                        lo = i + 1;
+                    }
+                }
+                return lo;
+            }
+
+            /*
+            merges a and b like std::merge into uninitialized memory at output by move constructing the items,
+            constructed is the number of items built, also when comp or a constructor throws
+            */
+            template <typename T, typename Compare>
+            void merge_construct(T *a, T *a_last, T *b, T *b_last, T *output, Compare &comp, std::size_t &constructed)
+            {
+                T *next = output;
+                try
+                {
+                    for (; a != a_last && b != b_last; ++next)
+                    {
+                        if (comp(*b, *a))
+                        {
+                            ::new (static_cast<void *>(next)) T(std::move(*b++));
+                        }
+                        else
+                        {
+                            ::new (static_cast<void *>(next)) T(std::move(*a++));
+                        }
+                    }
+                    for (; a != a_last; ++a, ++next)
+                    {
+                        ::new (static_cast<void *>(next)) T(std::move(*a));
+                    }
+                    for (; b != b_last; ++b, ++next)
+                    {
+                        ::new (static_cast<void *>(next)) T(std::move(*b));
+                    }
+                }
+                catch (...)
+                {
+                    constructed = static_cast<std::size_t>(next - output);
+                    throw;
+                }
+                constructed = static_cast<std::size_t>(next - output);
+            }
+
+            // a partial result of reduce, on its own cache line
+            template <typename T>
+            struct alignas(cache_line) partial
+            {
+                std::optional<T> value;
+            };
+        }
+
+        /*
+        calls fn(item) for n items
+        */
+        template <typename T, typename F>
+        void for_each(thread_pool &pool, T *data, std::size_t n, F fn)
+        {
+            detail::chunking chunks = detail::split<T>(data, n, pool.size());
+            pool.run(chunks.count, [&](std::size_t i) {
+                std::for_each(data + chunks.begin(i), data + chunks.end(i), fn);
+            });
+        }
+
+        /*
+        output[i] = fn(input[i]) for n items, output has room for n items, it may be input
+        */
+        template <typename T, typename U, typename F>
+        void transform(thread_pool &pool, const T *input, std::size_t n, U *output, F fn)
+        {
+            detail::chunking chunks = detail::split<U>(output, n, pool.size());
+            pool.run(chunks.count, [&](std::size_t i) {
+                std::transform(input + chunks.begin(i), input + chunks.end(i), output + chunks.begin(i), fn);
+            });
+        }
+
+        /*
+        copies n items from input to output, the ranges must not overlap
+        trivially copyable items are copied by memcpy per chunk
+        */
+        template <typename T>
+        void copy(thread_pool &pool, const T *input, std::size_t n, T *output)
+        {
+            detail::chunking chunks = detail::split<T>(output, n, pool.size());
+            pool.run(chunks.count, [&](std::size_t i) {
+                if constexpr (std::is_trivially_copyable_v<T>)
+                {
+                    std::memcpy(static_cast<void *>(output + chunks.begin(i)), static_cast<const void *>(input + chunks.begin(i)),
+                                (chunks.end(i) - chunks.begin(i)) * sizeof(T));
+                }
+                else
+                {
+                    std::copy(input + chunks.begin(i), input + chunks.end(i), output + chunks.begin(i));
+                }
+            });
+        }
+
+        /*
+        combines init and n items by op, op must be associative, the items are combined in their order
+        so op doesn't have to be commutative, the result is init if n is 0
+        */
+        template <typename T, typename U, typename BinaryOp = std::plus<>>
+        U reduce(thread_pool &pool, const T *data, std::size_t n, U init, BinaryOp op = BinaryOp())
+        {
+            detail::chunking chunks = detail::split<T>(nullptr, n, pool.size());
+            std::unique_ptr<detail::partial<U>[]> partials(new detail::partial<U>[chunks.count]);
+            pool.run(chunks.count, [&](std::size_t i) {
+                const T *first = data + chunks.begin(i);
+                const T *last = data + chunks.end(i);
+                U value = *first;
+                for (++first; first != last; ++first)
+                {
+                    value = op(std::move(value), *first);
+                }
+                partials[i].value = std::move(value);
+            });
+            for (std::size_t i = 0; i < chunks.count; ++i)
+            {
+                init = op(std::move(init), std::move(*partials[i].value));
+            }
+            return init;
+        }
+
+        /*
+        sorts n items by comp, it is not stable
+        chunks are sorted by std::sort, then merged pairwise, every merge is split into equal parts on its merge path
+        so all threads stay busy to the last pass, it needs a buffer of n items
+        the buffer is not default constructed, the first pass move constructs the items into it
+        if comp or a move throws only the basic guarantee holds, data keeps n valid items but their values
+        are unspecified, items moved out to the buffer or to a temporary are lost and left moved-from
+        */
+        template <typename T, typename Compare = std::less<>>
+        void sort(thread_pool &pool, T *data, std::size_t n, Compare comp = Compare())
+        {
+            std::size_t run = detail::split<T>(nullptr, n, pool.size()).size;
+            if (n <= run || pool.size() == 1)
+            {
+                std::sort(data, data + n, comp);
+                return;
+            }
+            pool.run((n + run - 1) / run, [&](std::size_t i) {
+                std::sort(data + i * run, data + std::min(n, (i + 1) * run), comp);
+            });
+            constexpr bool trivial = std::is_trivially_default_constructible_v<T> && std::is_trivially_destructible_v<T>;
+            vector<T> buffer;
+            buffer.reserve(n);
+            if constexpr (trivial)
+            {
+                buffer.resize_uninitialized(n);
+            }
+            T *from = data;
+            T *to = buffer.data();
+            vector<std::size_t> splits;
+            vector<std::size_t> constructed; // items every task of the first pass built in the buffer
+            for (std::size_t width = run; width < n; width *= 2)
+            {
+                bool construct = !trivial && width == run;
+                // task t merges the output items [t % parts * run, (t % parts + 1) * run) of the pair t / parts
+                std::size_t parts = (2 * width + run - 1) / run;
+                std::size_t tasks = (n + 2 * width - 1) / (2 * width) * parts;
+                auto bounds = [&](std::size_t task, std::size_t &start, std::size_t &middle, std::size_t &length, std::size_t &first) {
+                    start = task / parts * 2 * width;
+                    middle = std::min(n, start + width);
+                    length = std::min(n, start + 2 * width) - start;
+                    first = std::min(length, task % parts * run);
+                };
+                // the splits are found before any item is moved, every task reads items other tasks merge
+                splits.resize_uninitialized(tasks);
+                pool.run(tasks, [&](std::size_t task) {
+                    std::size_t start, middle, length, first;
+                    bounds(task, start, middle, length, first);
+                    splits[task] = detail::merge_split(from + start, middle - start, from + middle, length - (middle - start), first, comp);
+                });
+                auto merge = [&](std::size_t task) {
+                    std::size_t start, middle, length, first;
+                    bounds(task, start, middle, length, first);
+                    std::size_t last = std::min(length, first + run);
+                    if (first == last)
+                    {
+                        return;
+                    }
+                    std::size_t a_first = splits[task];
+                    std::size_t a_last = last == length ? middle - start : splits[task + 1];
+                    if (construct)
+                    {
+                        detail::merge_construct(from + start + a_first, from + start + a_last, from + middle + first - a_first,
+                                                from + middle + last - a_last, to + start + first, comp, constructed[task]);
+                    }
+                    else
+                    {
+                        std::merge(std::make_move_iterator(from + start + a_first), std::make_move_iterator(from + start + a_last),
+                                   std::make_move_iterator(from + middle + first - a_first), std::make_move_iterator(from + middle + last - a_last),
+                                   to + start + first, comp);
+                    }
+                };
+                if (construct)
+                {
+                    constructed.resize(tasks);
+                    try
+                    {
+                        pool.run(tasks, merge);
+                    }
+                    catch (...)
+                    {
+                        // tasks that didn't start built nothing, the others built a prefix of their part,
+                        // the items in the buffer are destroyed, their sources in data stay moved-from
+                        for (std::size_t task = 0; task < tasks; ++task)
+                        {
+                            std::size_t start, middle, length, first;
+                            bounds(task, start, middle, length, first);
+                            std::destroy_n(to + start + first, constructed[task]);
+                        }
+                        throw;
+                    }
+                    // the buffer is fully built, it destroys its items from now on
+                    std::size_t capacity = buffer.capacity();
+                    buffer.adopt(buffer.release(), n, capacity);
+                }
+                else
+                {
+                    pool.run(tasks, merge);
+                }
+                std::swap(from, to);
+            }
+            if (from != data)
+            {
+                detail::chunking chunks = detail::split<T>(data, n, pool.size());
+                pool.run(chunks.count, [&](std::size_t i) {
+                    std::move(from + chunks.begin(i), from + chunks.end(i), data + chunks.begin(i));
+                });
+            }
+        }
+
+        namespace detail
+        {
+            /*
+            constructs n items at first by construct(first, last) per chunk, if a chunk throws
+            the items of the chunks that are done are destroyed again
+            */
+            template <typename T, typename Construct>
+            void construct_chunks(thread_pool &pool, T *first, std::size_t n, const Construct &construct)
+            {
+                chunking chunks = split<T>(first, n, pool.size());
+                vector<unsigned char> done;
+                done.resize(chunks.count);
+                try
+                {
+                    pool.run(chunks.count, [&](std::size_t i) {
+                        construct(first + chunks.begin(i), first + chunks.end(i));
+                        done[i] = 1;
+                    });
+                }
+                catch (...)
+                {
+                    for (std::size_t i = 0; i < chunks.count; ++i)
+                    {
+                        if (done[i] != 0)
+                        {
+                            std::destroy(first + chunks.begin(i), first + chunks.end(i));
+                        }
+                    }
+                    throw;
+                }
+            }
+        }
+
+        /*
+        resizes items to n, the new items are value initialized by the threads of the pool
+        for mapped memory the first write places a page on the NUMA node of the writing thread, a later
+        for_each or transform over the same items on the same pool hands every thread the same chunks,
+        so each thread mostly reads pages local to it, see asd::numa_policy::first_touch
+        */
+        template <typename T, typename Alloc, typename GrowthPolicy, typename SizeType>
+        void resize(thread_pool &pool, vector<T, Alloc, GrowthPolicy, SizeType> &items, std::size_t n)
+        {
+            items.resize_with(n, [&](T *first, std::size_t count) {
+                detail::construct_chunks(pool, first, count, [](T *begin, T *end) { std::uninitialized_value_construct(begin, end); });
+            });
+        }
+
+        /*
+        resizes items to n, the new items are copies of value made by the threads of the pool
+        */
+        template <typename T, typename Alloc, typename GrowthPolicy, typename SizeType>
+        void resize(thread_pool &pool, vector<T, Alloc, GrowthPolicy, SizeType> &items, std::size_t n, const T &value)
+        {
+            // value may be an item that moves when items grows
+            T value_copy(value);
+            items.resize_with(n, [&](T *first, std::size_t count) {
+                detail::construct_chunks(pool, first, count, [&](T *begin, T *end) { std::uninitialized_fill(begin, end, value_copy); });
+            });
+        }
+
+        template <typename T, typename Alloc, typename GrowthPolicy, typename SizeType>
+        void resize(vector<T, Alloc, GrowthPolicy, SizeType> &items, std::size_t n)
+        {
+            parallel::resize(thread_pool::global(), items, n);
+        }
+
+        template <typename T, typename Alloc, typename GrowthPolicy, typename SizeType>
+        void resize(vector<T, Alloc, GrowthPolicy, SizeType> &items, std::size_t n, const T &value)
+        {
+            parallel::resize(thread_pool::global(), items, n, value);
+        }
+
+        /*
+        overloads for contiguous containers such as asd::vector and asd::vector_view, they run on data() and size()
+        transform and copy write to the first items of output, it must have at least as many items as input
+        */
+        template <typename Container, typename F>
+        auto for_each(thread_pool &pool, Container &&items, F fn) -> decltype(void(items.data()), void(items.size()))
+        {
+            parallel::for_each(pool, items.data(), items.size(), fn);
+        }
+
+        template <typename Container, typename F>
+        auto for_each(Container &&items, F fn) -> decltype(void(items.data()), void(items.size()))
+        {
+            parallel::for_each(thread_pool::global(), items.data(), items.size(), fn);
+        }
+
+        template <typename Input, typename Output, typename F>
+        auto transform(thread_pool &pool, const Input &input, Output &&output, F fn) -> decltype(void(input.data()), void(output.data()))
+        {
+            parallel::transform(pool, input.data(), input.size(), output.data(), fn);
+        }
+
+        template <typename Input, typename Output, typename F>
+        auto transform(const Input &input, Output &&output, F fn) -> decltype(void(input.data()), void(output.data()))
+        {
+            parallel::transform(thread_pool::global(), input.data(), input.size(), output.data(), fn);
+        }
+
+        template <typename Input, typename Output>
+        auto copy(thread_pool &pool, const Input &input, Output &&output) -> decltype(void(input.data()), void(output.data()))
+        {
+            parallel::copy(pool, input.data(), input.size(), output.data());
+        }
+
+        template <typename Input, typename Output>
+        auto copy(const Input &input, Output &&output) -> decltype(void(input.data()), void(output.data()))
+        {
+            parallel::copy(thread_pool::global(), input.data(), input.size(), output.data());
+        }
+
+        template <typename Container, typename U, typename BinaryOp = std::plus<>>
+        auto reduce(thread_pool &pool, const Container &items, U init, BinaryOp op = BinaryOp()) -> decltype(void(items.data()), U())
+        {
+            return parallel::reduce(pool, items.data(), items.size(), std::move(init), op);
+        }
+
+        template <typename Container, typename U, typename BinaryOp = std::plus<>>
+        auto reduce(const Container &items, U init, BinaryOp op = BinaryOp()) -> decltype(void(items.data()), U())
+        {
+            return parallel::reduce(thread_pool::global(), items.data(), items.size(), std::move(init), op);
+        }
+
+        template <typename Container, typename Compare = std::less<>>
+        auto sort(thread_pool &pool, Container &&items, Compare comp = Compare()) -> decltype(void(items.data()), void(items.size()))
+        {
+            parallel::sort(pool, items.data(), items.size(), comp);
+        }
+
+        template <typename Container, typename Compare = std::less<>>
+        auto sort(Container &&items, Compare comp = Compare()) -> decltype(void(items.data()), void(items.size()))
+        {
+            parallel::sort(thread_pool::global(), items.data(), items.size(), comp);
+        }
+
+        /*
+        calls fn(item) for the items of a strided view
+        */
+        template <typename T, typename F>
+        void for_each(thread_pool &pool, strided_view<T> items, F fn)
+        {
+            detail::chunking chunks = detail::split<T>(nullptr, items.size(), pool.size());
+            pool.run(chunks.count, [&](std::size_t i) {
+                std::for_each(items.begin() + static_cast<std::ptrdiff_t>(chunks.begin(i)), items.begin() + static_cast<std::ptrdiff_t>(chunks.end(i)), fn);
+            });
+        }
+
+        template <typename T, typename F>
+        void for_each(strided_view<T> items, F fn)
+        {
+            parallel::for_each(thread_pool::global(), items, fn);
+        }
+
+        /*
+        combines init and the items of a strided view by op in their order, op must be associative
+        */
+        template <typename T, typename U, typename BinaryOp = std::plus<>>
+        U reduce(thread_pool &pool, strided_view<T> items, U init, BinaryOp op = BinaryOp())
+        {
+            detail::chunking chunks = detail::split<T>(nullptr, items.size(), pool.size());
+            std::unique_ptr<detail::partial<U>[]> partials(new detail::partial<U>[chunks.count]);
+            pool.run(chunks.count, [&](std::size_t i) {
+                U value = items[chunks.begin(i)];
+                for (std::size_t j = chunks.begin(i) + 1; j < chunks.end(i); ++j)
+                {
+                    value = op(std::move(value), items[j]);
+                }
+                partials[i].value = std::move(value);
+            });
+            for (std::size_t i = 0; i < chunks.count; ++i)
+            {
+                init = op(std::move(init), std::move(*partials[i].value));
+            }
+            return init;
+        }
+
+        template <typename T, typename U, typename BinaryOp = std::plus<>>
+        U reduce(strided_view<T> items, U init, BinaryOp op = BinaryOp())
+        {
+            return parallel::reduce(thread_pool::global(), items, std::move(init), op);
+        }
+    }
+}
+#endif //ifndef ASD_PARALLEL_2023
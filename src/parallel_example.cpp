@@ -0,0 +1,260 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <atomic>
+#include <stdexcept>
+#include <cstdint>
+#include <assert.h>
+#include "parallel.hpp"
+
+// an item whose construction may fail, live counts the constructed items
+struct counted
+{
+    static std::atomic<int> live;
+    int value;
+
+    counted()
+        : value(0)
+    {
+        ++live;
+    }
+
+    counted(const counted &other)
+        : value(other.value)
+    {
+        if (other.value < 0)
+        {
+            throw std::runtime_error("negative");
+        }
+        ++live;
+    }
+
+    ~counted()
+    {
+        --live;
+    }
+};
+
+std::atomic<int> counted::live{0};
+
+// an item without a default constructor, live counts the constructed items
+struct ticket
+{
+    static std::atomic<int> live;
+    std::string name;
+
+    explicit ticket(int value)
+        : name(std::to_string(value))
+    {
+        ++live;
+    }
+
+    ticket(ticket &&other) noexcept
+        : name(std::move(other.name))
+    {
+        ++live;
+    }
+
+    ticket &operator=(ticket &&other) noexcept
+    {
+        name = std::move(other.name);
+        return *this;
+    }
+
+    ~ticket()
+    {
+        --live;
+    }
+};
+
+std::atomic<int> ticket::live{0};
+
+int main()
+{
+    asd::parallel::thread_pool pool(4);
+    assert(pool.size() == 4 && asd::parallel::thread_pool::global().size() >= 1);
+
+    // Test for_each and transform visit every item once
+    asd::vector<std::uint64_t> myVec1;
+    myVec1.resize(1 << 20);
+    std::iota(myVec1.begin(), myVec1.end(), 0);
+    asd::parallel::for_each(pool, myVec1, [](std::uint64_t &item) { item *= 3; });
+    for (std::size_t i = 0; i < myVec1.size(); ++i)
+    {
+        assert(myVec1[i] == 3 * i);
+    }
+    asd::vector<double> myVec2;
+    myVec2.resize(myVec1.size() - 5);
+    asd::parallel::transform(pool, myVec1.data() + 5, myVec2.size(), myVec2.data(), [](std::uint64_t item) { return item / 2.0; });
+    for (std::size_t i = 0; i < myVec2.size(); ++i)
+    {
+        assert(myVec2[i] == (3 * (i + 5)) / 2.0);
+    }
+    asd::parallel::transform(myVec1, myVec1, [](std::uint64_t item) { return item + 1; });
+    assert(myVec1[0] == 1 && myVec1[1000] == 3001);
+
+    // Test reduce keeps the order of the items
+    assert(asd::parallel::reduce(pool, myVec1, std::uint64_t(0)) == std::accumulate(myVec1.begin(), myVec1.end(), std::uint64_t(0)));
+    asd::vector<std::string> myVec3;
+    for (int i = 0; i < 100000; ++i)
+    {
+        myVec3.push_back(std::string(1, static_cast<char>('a' + i % 26)));
+    }
+    std::string joined = asd::parallel::reduce(pool, myVec3, std::string(">"));
+    assert(joined.size() == 100001 && joined == std::accumulate(myVec3.begin(), myVec3.end(), std::string(">")));
+    asd::vector<int> myVec4;
+    assert(asd::parallel::reduce(pool, myVec4, 7) == 7);
+
+    // Test copy
+    asd::vector<std::string> myVec5;
+    myVec5.resize(myVec3.size());
+    asd::parallel::copy(pool, myVec3, myVec5);
+    assert(std::equal(myVec3.begin(), myVec3.end(), myVec5.begin()));
+    asd::vector<std::uint64_t> myVec6;
+    myVec6.resize(myVec1.size());
+    asd::parallel::copy(myVec1, myVec6);
+    assert(std::equal(myVec1.begin(), myVec1.end(), myVec6.begin()));
+
+    // Test sort against std::sort, large inputs take the parallel merge path
+    std::mt19937 random(42);
+    for (std::size_t n : {0, 1, 100, 10000, 100003, 1 << 20})
+    {
+        asd::vector<std::int32_t> myVec7;
+        std::vector<std::int32_t> stdVec1;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            std::int32_t item = static_cast<std::int32_t>(random() % 1000);
+            myVec7.push_back(item);
+            stdVec1.push_back(item);
+        }
+        asd::parallel::sort(pool, myVec7);
+        std::sort(stdVec1.begin(), stdVec1.end());
+        assert(std::equal(stdVec1.begin(), stdVec1.end(), myVec7.begin()));
+    }
+    asd::parallel::sort(pool, myVec3, std::greater<>());
+    assert(std::is_sorted(myVec3.begin(), myVec3.end(), std::greater<>()) && myVec3.front() == "z" && myVec3.back() == "a");
+    asd::parallel::sort(myVec1, std::greater<>());
+    assert(std::is_sorted(myVec1.begin(), myVec1.end(), std::greater<>()));
+
+    // Test nested jobs run serially and exceptions reach the caller
+    std::atomic<std::size_t> visited{0};
+    asd::parallel::for_each(pool, myVec2, [&](double &) {
+        if (visited.fetch_add(1) % 100000 == 0)
+        {
+            asd::parallel::for_each(pool, myVec4, [](int &) {});
+        }
+    });
+    assert(visited == myVec2.size());
+    bool thrown = false;
+    try
+    {
+        asd::parallel::for_each(pool, myVec1, [](std::uint64_t &item) {
+            if (item == 12346)
+            {
+                throw std::runtime_error("bad item");
+            }
+        });
+    }
+    catch (const std::runtime_error &)
+    {
+        thrown = true;
+    }
+    assert(thrown);
+    asd::parallel::for_each(pool, myVec1, [](std::uint64_t &item) { item = 0; });
+    assert(asd::parallel::reduce(pool, myVec1, std::uint64_t(0)) == 0);
+
+    // Test resize constructs the new items in parallel, a failed construction leaves the old items only
+    asd::vector<std::uint64_t> myVec8;
+    myVec8.push_back(9);
+    asd::parallel::resize(pool, myVec8, 1 << 20);
+    assert(myVec8.size() == (1 << 20) && myVec8[0] == 9 && asd::parallel::reduce(pool, myVec8, std::uint64_t(0)) == 9);
+    asd::parallel::resize(pool, myVec8, 2 << 20, myVec8[0]);
+    assert(myVec8.size() == (2 << 20) && myVec8[(1 << 20) - 1] == 0 && myVec8.back() == 9);
+    asd::parallel::resize(myVec8, 5);
+    assert(myVec8.size() == 5 && myVec8[0] == 9);
+    {
+        asd::vector<counted> myVec9;
+        myVec9.resize(10);
+        asd::parallel::resize(pool, myVec9, 1 << 18);
+        assert(counted::live == (1 << 18));
+        counted bad;
+        bad.value = -1;
+        thrown = false;
+        try
+        {
+            asd::parallel::resize(pool, myVec9, 1 << 20, bad);
+        }
+        catch (const std::runtime_error &)
+        {
+            thrown = true;
+        }
+        assert(thrown && myVec9.size() == (1 << 18) && counted::live == (1 << 18) + 1);
+    }
+    assert(counted::live == 0);
+
+    // Test sort of items without a default constructor, a throwing comparison leaves valid items behind,
+    // each one of the input values or moved-from, and no value more often than in the input
+    {
+        std::atomic<std::size_t> comparisons{0};
+        std::size_t limit = static_cast<std::size_t>(-1);
+        auto byName = [&](const ticket &a, const ticket &b) {
+            if (++comparisons > limit)
+            {
+                throw std::runtime_error("comparison");
+            }
+            return a.name < b.name;
+        };
+        asd::vector<ticket> myVec10;
+        auto fill = [&]() {
+            std::mt19937 names(7);
+            myVec10.erase(0, myVec10.size());
+            for (int i = 0; i < (1 << 16); ++i)
+            {
+                myVec10.emplace_back(static_cast<int>(names() % 100000));
+            }
+        };
+        fill();
+        asd::parallel::sort(pool, myVec10, byName);
+        assert(std::is_sorted(myVec10.begin(), myVec10.end(), byName) && ticket::live == (1 << 16));
+        std::size_t total = comparisons;
+        std::vector<std::string> names;
+        for (const ticket &item : myVec10)
+        {
+            names.push_back(item.name);
+        }
+        for (std::size_t part = 1; part < 8; ++part)
+        {
+            fill();
+            comparisons = 0;
+            limit = total * part / 8;
+            thrown = false;
+            try
+            {
+                asd::parallel::sort(pool, myVec10, byName);
+            }
+            catch (const std::runtime_error &)
+            {
+                thrown = true;
+            }
+            assert(thrown && myVec10.size() == (1 << 16) && ticket::live == (1 << 16));
+            std::vector<std::string> left;
+            for (const ticket &item : myVec10)
+            {
+                if (!item.name.empty())
+                {
+                    left.push_back(item.name);
+                }
+            }
+            std::sort(left.begin(), left.end());
+            assert(std::includes(names.begin(), names.end(), left.begin(), left.end()));
+        }
+    }
+    assert(ticket::live == 0);
+
+    std::cout << "parallel examples done" << std::endl;
+
+    return 0;
+}
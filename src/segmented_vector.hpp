@@ -0,0 +1,665 @@
+/*
+ * Copyright (C) 2023 Sofyan Gaber <sofyanhalaby@gmail.com>
+ *
+ * This code is for demonstration and educational purposes. It
+ * implements a vector class that never relocates its items.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ASD_SEGMENTED_VECTOR_2023
+#define ASD_SEGMENTED_VECTOR_2023
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include "vector.hpp"
+
+namespace asd
+{
+    /*
+    the largest power of two number of T items that fits in a 4 KiB page, at least 1
+    */
+    template <typename T>
+    constexpr std::size_t page_segment_size() noexcept
+    {
+        std::size_t items = 4096 / sizeof(T);
+        std::size_t result = 1;
+        while (result * 2 <= items)
+        {
+            result *= 2;
+        }
+        return result;
+    }
+
+    /*
+    class asd::segmented_vector<T, SegmentSize, Alloc> keeps its items in fixed segments of SegmentSize items
+    listed in a segment table, growth allocates one more segment and never moves an item so
+    pointers and references stay valid until the item is removed, and T doesn't need to be movable
+    operator[] is two pointer hops (table, segment), segments() gives the contiguous spans for inner loops
+    SegmentSize is a power of two, a page worth of items by default
+    */
+    template <typename T, std::size_t SegmentSize = page_segment_size<T>(), typename Alloc = allocator<T>>
+    class segmented_vector
+    {
+        static_assert(SegmentSize > 0 && (SegmentSize & (SegmentSize - 1)) == 0, "SegmentSize must be a power of two");
+
+        using alloc_traits = std::allocator_traits<Alloc>;
+        using table_allocator = typename alloc_traits::template rebind_alloc<T *>;
+
+        vector<T *, table_allocator> m_segments; // allocated segments, the last ones may be empty
+        std::size_t m_count;
+        ASD_NO_UNIQUE_ADDRESS Alloc m_allocator;
+
+        T *slot(std::size_t i) const noexcept
+        {
+            return m_segments[i / SegmentSize] + i % SegmentSize;
+        }
+
+        void add_segment()
+        {
+            T *segment = alloc_traits::allocate(m_allocator, SegmentSize);
+            try
+            {
+                m_segments.push_back(segment);
+            }
+            catch (...)
+            {
+                alloc_traits::deallocate(m_allocator, segment, SegmentSize);
+                throw;
+            }
+        }
+
+        /*
+        makes sure the slot of item m_count exists
+        */
+        T *next_slot()
+        {
+            if (m_count == m_segments.size() * SegmentSize)
+            {
+                add_segment();
+            }
+            return slot(m_count);
+        }
+
+        void destroy_items(std::size_t first) noexcept
+        {
+            if constexpr (!std::is_trivially_destructible_v<T>)
+            {
+                for (std::size_t i = first; i < m_count; ++i)
+                {
+                    alloc_traits::destroy(m_allocator, slot(i));
+                }
+            }
+            m_count = first;
+        }
+
+        void release_segments(std::size_t keep) noexcept
+        {
+            while (m_segments.size() > keep)
+            {
+                alloc_traits::deallocate(m_allocator, m_segments.back(), SegmentSize);
+                m_segments.resize(m_segments.size() - 1);
+            }
+        }
+
+        /*
+        frees this container and takes the segment table of other, the caller settles the allocators
+        */
+        void take(segmented_vector &other)
+        {
+            destroy_items(0);
+            release_segments(0);
+            m_segments = std::move(other.m_segments);
+            m_count = other.m_count;
+            other.m_count = 0;
+        }
+
+    public:
+        using value_type = T;
+        using allocator_type = Alloc;
+        static constexpr std::size_t segment_size = SegmentSize;
+
+        /*
+        random access iterator, it goes through the segment table on every dereference
+        */
+        template <typename Value>
+        class basic_iterator
+        {
+            template <typename>
+            friend class basic_iterator;
+
+            T *const *m_segments;
+            std::size_t m_index;
+
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = std::remove_const_t<Value>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = Value *;
+            using reference = Value &;
+
+            basic_iterator() noexcept
+                : m_segments(nullptr), m_index(0)
+            {
+            }
+
+            basic_iterator(T *const *segments, std::size_t index) noexcept
+                : m_segments(segments), m_index(index)
+            {
+            }
+
+            // iterator converts to const_iterator
+            template <typename Other, typename = std::enable_if_t<std::is_same_v<Value, const Other>>>
+            basic_iterator(const basic_iterator<Other> &other) noexcept
+                : m_segments(other.m_segments), m_index(other.m_index)
+            {
+            }
+
+            reference operator*() const noexcept
+            {
+                return m_segments[m_index / SegmentSize][m_index % SegmentSize];
+            }
+
+            pointer operator->() const noexcept
+            {
+                return &**this;
+            }
+
+            reference operator[](difference_type n) const noexcept
+            {
+                return *(*this + n);
+            }
+
+            basic_iterator &operator++() noexcept
+            {
+                ++m_index;
+                return *this;
+            }
+
+            basic_iterator operator++(int) noexcept
+            {
+                basic_iterator result = *this;
+                ++m_index;
+                return result;
+            }
+
+            basic_iterator &operator--() noexcept
+            {
+                --m_index;
+                return *this;
+            }
+
+            basic_iterator operator--(int) noexcept
+            {
+                basic_iterator result = *this;
+                --m_index;
+                return result;
+            }
+
+            basic_iterator &operator+=(difference_type n) noexcept
+            {
+                m_index += n;
+                return *this;
+            }
+
+            basic_iterator &operator-=(difference_type n) noexcept
+            {
+                m_index -= n;
+                return *this;
+            }
+
+            basic_iterator operator+(difference_type n) const noexcept
+            {
+                return basic_iterator(m_segments, m_index + n);
+            }
+
+            friend basic_iterator operator+(difference_type n, const basic_iterator &it) noexcept
+            {
+                return it + n;
+            }
+
+            basic_iterator operator-(difference_type n) const noexcept
+            {
+                return basic_iterator(m_segments, m_index - n);
+            }
+
+            difference_type operator-(const basic_iterator &other) const noexcept
+            {
+                return static_cast<difference_type>(m_index) - static_cast<difference_type>(other.m_index);
+            }
+
+            bool operator==(const basic_iterator &other) const noexcept
+            {
+                return m_index == other.m_index;
+            }
+
+            bool operator!=(const basic_iterator &other) const noexcept
+            {
+                return m_index != other.m_index;
+            }
+
+            bool operator<(const basic_iterator &other) const noexcept
+            {
+                return m_index < other.m_index;
+            }
+
+            bool operator>(const basic_iterator &other) const noexcept
+            {
+                return m_index > other.m_index;
+            }
+
+            bool operator<=(const basic_iterator &other) const noexcept
+            {
+                return m_index <= other.m_index;
+            }
+
+            bool operator>=(const basic_iterator &other) const noexcept
+            {
+                return m_index >= other.m_index;
+            }
+        };
+
+        using iterator = basic_iterator<T>;
+        using const_iterator = basic_iterator<const T>;
+
+        /*
+        contiguous items of one segment
+        */
+        template <typename Value>
+        struct basic_span
+        {
+            Value *first;
+            Value *last;
+
+            Value *begin() const noexcept
+            {
+                return first;
+            }
+
+            Value *end() const noexcept
+            {
+                return last;
+            }
+
+            Value *data() const noexcept
+            {
+                return first;
+            }
+
+            std::size_t size() const noexcept
+            {
+                return static_cast<std::size_t>(last - first);
+            }
+        };
+
+        /*
+        the segments as a range of spans, loop over the spans then over their contiguous items:
+          for (auto span : items.segments()) for (T &item : span) ...
+        */
+        template <typename Value>
+        class basic_segment_range
+        {
+            T *const *m_segments;
+            std::size_t m_count;
+
+        public:
+            class iterator
+            {
+                T *const *m_segments;
+                std::size_t m_segment;
+                std::size_t m_count;
+
+            public:
+                using iterator_category = std::forward_iterator_tag;
+                using value_type = basic_span<Value>;
+                using difference_type = std::ptrdiff_t;
+                using pointer = const basic_span<Value> *;
+                using reference = basic_span<Value>;
+
+                iterator(T *const *segments, std::size_t segment, std::size_t count) noexcept
+                    : m_segments(segments), m_segment(segment), m_count(count)
+                {
+                }
+
+                basic_span<Value> operator*() const noexcept
+                {
+                    std::size_t first = m_segment * SegmentSize;
+                    std::size_t items = m_count - first < SegmentSize ? m_count - first : SegmentSize;
+                    return basic_span<Value>{m_segments[m_segment], m_segments[m_segment] + items};
+                }
+
+                iterator &operator++() noexcept
+                {
+                    ++m_segment;
+                    return *this;
+                }
+
+                iterator operator++(int) noexcept
+                {
+                    iterator result = *this;
+                    ++m_segment;
+                    return result;
+                }
+
+                bool operator==(const iterator &other) const noexcept
+                {
+                    return m_segment == other.m_segment;
+                }
+
+                bool operator!=(const iterator &other) const noexcept
+                {
+                    return m_segment != other.m_segment;
+                }
+            };
+
+            basic_segment_range(T *const *segments, std::size_t count) noexcept
+                : m_segments(segments), m_count(count)
+            {
+            }
+
+            iterator begin() const noexcept
+            {
+                return iterator(m_segments, 0, m_count);
+            }
+
+            iterator end() const noexcept
+            {
+                return iterator(m_segments, (m_count + SegmentSize - 1) / SegmentSize, m_count);
+            }
+        };
+
+        using span = basic_span<T>;
+        using const_span = basic_span<const T>;
+        using segment_range = basic_segment_range<T>;
+        using const_segment_range = basic_segment_range<const T>;
+
+        segmented_vector() noexcept(noexcept(Alloc()))
+            : segmented_vector(Alloc())
+        {
+        }
+
+        explicit segmented_vector(const Alloc &alloc) noexcept
+            : m_segments(table_allocator(alloc)), m_count(0), m_allocator(alloc)
+        {
+        }
+
+        segmented_vector(const segmented_vector &other)
+            : segmented_vector(alloc_traits::select_on_container_copy_construction(other.m_allocator))
+        {
+            try
+            {
+                for (const T &item : other)
+                {
+                    push_back(item);
+                }
+            }
+            catch (...)
+            {
+                clear();
+                release_segments(0);
+                throw;
+            }
+        }
+
+        /*
+        takes the segment table of other, no item is moved
+        */
+        segmented_vector(segmented_vector &&other) noexcept
+            : m_segments(std::move(other.m_segments)), m_count(other.m_count), m_allocator(std::move(other.m_allocator))
+        {
+            other.m_count = 0;
+        }
+
+        /*
+        the allocator is copied if propagate_on_container_copy_assignment is set
+        */
+        segmented_vector &operator=(const segmented_vector &other)
+        {
+            if (this != &other)
+            {
+                segmented_vector copy(alloc_traits::propagate_on_container_copy_assignment::value ? other.m_allocator : m_allocator);
+                for (const T &item : other)
+                {
+                    copy.push_back(item);
+                }
+                take(copy);
+                if constexpr (alloc_traits::propagate_on_container_copy_assignment::value)
+                {
+                    m_allocator = other.m_allocator;
+                }
+            }
+            return *this;
+        }
+
+        /*
+        the segment table of other is taken if the allocator propagates or both allocators are equal,
+        otherwise items are moved one by one into segments from this container allocator
+        */
+        segmented_vector &operator=(segmented_vector &&other) noexcept(alloc_traits::propagate_on_container_move_assignment::value ||
+                                                                      alloc_traits::is_always_equal::value)
+        {
+            if (this == &other)
+            {
+                return *this;
+            }
+            if constexpr (!alloc_traits::propagate_on_container_move_assignment::value && !alloc_traits::is_always_equal::value)
+            {
+                if (m_allocator != other.m_allocator)
+                {
+                    segmented_vector moved(m_allocator);
+                    for (T &item : other)
+                    {
+                        moved.push_back(std::move(item));
+                    }
+                    other.clear();
+                    take(moved);
+                    return *this;
+                }
+            }
+            take(other);
+            if constexpr (alloc_traits::propagate_on_container_move_assignment::value)
+            {
+                m_allocator = std::move(other.m_allocator);
+            }
+            return *this;
+        }
+
+        ~segmented_vector()
+        {
+            clear();
+            release_segments(0);
+        }
+
+        /*
+        exchanges the segment tables, no item is moved
+        the allocators are swapped if propagate_on_container_swap is set, otherwise they must be equal
+        */
+        void swap(segmented_vector &other) noexcept
+        {
+            using std::swap;
+            m_segments.swap(other.m_segments);
+            swap(m_count, other.m_count);
+            if constexpr (alloc_traits::propagate_on_container_swap::value)
+            {
+                swap(m_allocator, other.m_allocator);
+            }
+        }
+
+        allocator_type get_allocator() const noexcept
+        {
+            return m_allocator;
+        }
+
+        /*
+        add new item, no item is moved and no pointer is invalidated
+        */
+        template <class U>
+        void push_back(U &&item)
+        {
+            alloc_traits::construct(m_allocator, next_slot(), std::forward<U>(item));
+            ++m_count;
+        }
+
+        template <typename... Args>
+        T &emplace_back(Args &&...args)
+        {
+            T *ptr = next_slot();
+            alloc_traits::construct(m_allocator, ptr, std::forward<Args>(args)...);
+            ++m_count;
+            return *ptr;
+        }
+
+        /*
+        removes the last item, its segment is kept for the next push_back
+        */
+        void pop_back() noexcept
+        {
+            destroy_items(m_count - 1);
+        }
+
+        /*
+        destroys the items and keeps the segments
+        */
+        void clear() noexcept
+        {
+            destroy_items(0);
+        }
+
+        /*
+        changes the number of items to n, new items are value initialized
+        */
+        void resize(std::size_t n)
+        {
+            while (m_count < n)
+            {
+                emplace_back();
+            }
+            destroy_items(n < m_count ? n : m_count);
+        }
+
+        /*
+        allocates the segments for n items
+        */
+        void reserve(std::size_t n)
+        {
+            std::size_t segments = (n + SegmentSize - 1) / SegmentSize;
+            m_segments.reserve(segments);
+            while (m_segments.size() < segments)
+            {
+                add_segment();
+            }
+        }
+
+        /*
+        releases the segments holding no item
+        */
+        void shrink_to_fit() noexcept
+        {
+            release_segments((m_count + SegmentSize - 1) / SegmentSize);
+        }
+
+        T &operator[](std::size_t i) noexcept
+        {
+            return *slot(i);
+        }
+
+        const T &operator[](std::size_t i) const noexcept
+        {
+            return *slot(i);
+        }
+
+        std::size_t size() const noexcept
+        {
+            return m_count;
+        }
+
+        std::size_t capacity() const noexcept
+        {
+            return m_segments.size() * SegmentSize;
+        }
+
+        bool empty() const noexcept
+        {
+            return m_count == 0;
+        }
+
+        T &front() noexcept
+        {
+            return *slot(0);
+        }
+
+        const T &front() const noexcept
+        {
+            return *slot(0);
+        }
+
+        T &back() noexcept
+        {
+            return *slot(m_count - 1);
+        }
+
+        const T &back() const noexcept
+        {
+            return *slot(m_count - 1);
+        }
+
+        iterator begin() noexcept
+        {
+            return iterator(m_segments.data(), 0);
+        }
+
+        const_iterator begin() const noexcept
+        {
+            return const_iterator(m_segments.data(), 0);
+        }
+
+        iterator end() noexcept
+        {
+            return iterator(m_segments.data(), m_count);
+        }
+
+        const_iterator end() const noexcept
+        {
+            return const_iterator(m_segments.data(), m_count);
+        }
+
+        const_iterator cbegin() const noexcept
+        {
+            return begin();
+        }
+
+        const_iterator cend() const noexcept
+        {
+            return end();
+        }
+
+        segment_range segments() noexcept
+        {
+            return segment_range(m_segments.data(), m_count);
+        }
+
+        const_segment_range segments() const noexcept
+        {
+            return const_segment_range(m_segments.data(), m_count);
+        }
+    };
+}
+#endif //ifndef ASD_SEGMENTED_VECTOR_2023
@@ -0,0 +1,108 @@
+
+#include <iostream>
+#include <string>
+#include <memory_resource>
+#include <mutex>
+#include <algorithm>
+#include <numeric>
+#include <assert.h>
+#include "segmented_vector.hpp"
+
+// a type that can be neither copied nor moved
+struct pinned
+{
+    std::mutex mutex;
+    int value;
+
+    explicit pinned(int v)
+        : value(v)
+    {
+    }
+};
+
+int main()
+{
+    // Test pointers stay valid while the container grows
+    asd::segmented_vector<std::string> myVec1;
+    static_assert(asd::segmented_vector<std::string>::segment_size == 128);
+    myVec1.push_back("first string that is long enough to go to heap");
+    std::string *first = &myVec1[0];
+    for (int i = 1; i < 10000; ++i)
+    {
+        myVec1.push_back("segmented string " + std::to_string(i));
+    }
+    assert(first == &myVec1.front() && *first == "first string that is long enough to go to heap");
+    assert(myVec1.size() == 10000 && myVec1.back() == "segmented string 9999");
+
+    // Test items that can't be moved
+    asd::segmented_vector<pinned, 4> myVec2;
+    for (int i = 0; i < 100; ++i)
+    {
+        myVec2.emplace_back(i).value *= 2;
+    }
+    assert(myVec2[99].value == 198 && myVec2.capacity() == 100);
+
+    // Test iterators with std algorithms
+    asd::segmented_vector<int, 8> myVec3;
+    for (int i = 0; i < 1000; ++i)
+    {
+        myVec3.push_back(999 - i);
+    }
+    std::sort(myVec3.begin(), myVec3.end());
+    assert(std::is_sorted(myVec3.cbegin(), myVec3.cend()) && myVec3[0] == 0);
+    asd::segmented_vector<int, 8>::const_iterator it = myVec3.begin() + 10;
+    assert(*it == 10 && myVec3.cend() - it == 990);
+
+    // Test contiguous segments
+    long total = 0;
+    std::size_t segments = 0;
+    for (auto span : myVec3.segments())
+    {
+        total += std::accumulate(span.begin(), span.end(), 0L);
+        assert(span.size() <= 8);
+        ++segments;
+    }
+    assert(total == 999 * 1000 / 2 && segments == 125);
+
+    // Test copy, move, pop_back, resize and shrinking
+    asd::segmented_vector<std::string> myVec4(myVec1);
+    assert(myVec4.size() == 10000 && myVec4[5000] == myVec1[5000] && &myVec4[0] != &myVec1[0]);
+    asd::segmented_vector<std::string> myVec5(std::move(myVec4));
+    assert(myVec5.size() == 10000 && myVec4.empty());
+    myVec5.pop_back();
+    myVec5.resize(10);
+    myVec5.resize(20);
+    assert(myVec5.size() == 20 && myVec5[9] == "segmented string 9" && myVec5[19].empty());
+    myVec5.shrink_to_fit();
+    assert(myVec5.capacity() == 128);
+    myVec4 = myVec5;
+    myVec5.clear();
+    assert(myVec4.size() == 20 && myVec5.empty());
+
+    // Test std::pmr allocators stay with their container on swap and assignment
+    std::pmr::monotonic_buffer_resource resource1;
+    std::pmr::monotonic_buffer_resource resource2;
+    using pmr_segmented_vector = asd::segmented_vector<std::pmr::string, 16, std::pmr::polymorphic_allocator<std::pmr::string>>;
+    pmr_segmented_vector myVec6{std::pmr::polymorphic_allocator<std::pmr::string>(&resource1)};
+    pmr_segmented_vector myVec7{std::pmr::polymorphic_allocator<std::pmr::string>(&resource1)};
+    pmr_segmented_vector myVec8{std::pmr::polymorphic_allocator<std::pmr::string>(&resource2)};
+    for (int i = 0; i < 40; ++i)
+    {
+        myVec6.push_back(std::pmr::string("pmr segmented string ") + std::pmr::string(std::to_string(i).c_str()));
+    }
+    myVec6.swap(myVec7);
+    assert(myVec6.empty() && myVec7.size() == 40 && myVec7.get_allocator().resource() == &resource1);
+    myVec8 = myVec7;
+    assert(myVec8.size() == 40 && myVec8[39] == myVec7[39] && myVec8.get_allocator().resource() == &resource2);
+    assert(myVec8[39].get_allocator().resource() == &resource2);
+    myVec6.push_back("left over");
+    myVec6 = std::move(myVec8);
+    assert(myVec6.size() == 40 && myVec6[20] == myVec7[20] && myVec6.get_allocator().resource() == &resource1);
+    assert(myVec6[20].get_allocator().resource() == &resource1 && myVec8.empty());
+    myVec7 = std::move(myVec6);
+    assert(myVec7.size() == 40 && myVec6.empty() && myVec7[0] == "pmr segmented string 0");
+
+    std::cout << "segmented_vector examples done" << std::endl;
+
+    return 0;
+}
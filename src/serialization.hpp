@@ -0,0 +1,517 @@
+/*
+ * Copyright (C) 2023 Sofyan Gaber <sofyanhalaby@gmail.com>
+ *
+ * This code is for demonstration and educational purposes. It
+ * implements binary serialization of the vector class.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ASD_SERIALIZATION_2023
+#define ASD_SERIALIZATION_2023
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ios>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include "vector.hpp"
+
+namespace asd
+{
+    /*
+    the header in front of every serialized vector, the items follow it in native byte order
+    payload_bytes lets a reader take exactly one message from a socket or a pipe
+    */
+    struct wire_header
+    {
+        std::uint32_t magic;
+        std::uint16_t version;
+        std::uint16_t flags; // wire_header::bitwise if the payload is the raw items
+        std::uint32_t item_size; // sizeof(T) of bitwise payloads, 0 for encoded ones
+        std::uint32_t reserved;
+        std::uint64_t count; // number of items
+        std::uint64_t payload_bytes; // bytes after the header
+
+        static constexpr std::uint32_t wire_magic = 0x31445341; // "ASD1" little endian, a swapped value means foreign byte order
+        static constexpr std::uint16_t wire_version = 1;
+        static constexpr std::uint16_t bitwise = 1;
+    };
+
+    /*
+    where codecs encode items to, it appends to a byte buffer
+    */
+    class wire_sink
+    {
+        vector<char> &m_buffer;
+
+    public:
+        explicit wire_sink(vector<char> &buffer) noexcept
+            : m_buffer(buffer)
+        {
+        }
+
+        void write(const void *data, std::size_t bytes)
+        {
+            const char *first = static_cast<const char *>(data);
+            m_buffer.append(first, first + bytes);
+        }
+
+        template <typename U>
+        void write_value(const U &value)
+        {
+            static_assert(std::is_trivially_copyable_v<U>);
+            write(&value, sizeof(U));
+        }
+    };
+
+    /*
+    where codecs decode items from, it reads a byte buffer
+    - throws std::runtime_error if the payload ends before the item
+    */
+    class wire_source
+    {
+        const char *m_ptr;
+        const char *m_end;
+
+    public:
+        wire_source(const char *data, std::size_t bytes) noexcept
+            : m_ptr(data), m_end(data + bytes)
+        {
+        }
+
+        void read(void *data, std::size_t bytes)
+        {
+            if (static_cast<std::size_t>(m_end - m_ptr) < bytes)
+            {
+                throw std::runtime_error("read_from: truncated payload");
+            }
+            std::memcpy(data, m_ptr, bytes);
+            m_ptr += bytes;
+        }
+
+        template <typename U>
+        U read_value()
+        {
+            static_assert(std::is_trivially_copyable_v<U>);
+            U value;
+            read(&value, sizeof(U));
+            return value;
+        }
+
+        std::size_t remaining() const noexcept
+        {
+            return static_cast<std::size_t>(m_end - m_ptr);
+        }
+    };
+
+    /*
+    asd::codec<T> encodes one item, specialize it for your own types:
+      static void encode(wire_sink &sink, const T &item);
+      static T decode(wire_source &source);
+    codecs that define `static constexpr bool bitwise = true` have the whole vector written
+    and read as one block of raw bytes instead, it is the default for trivially copyable T
+    */
+    template <typename T, typename = void>
+    struct codec
+    {
+    };
+
+    template <typename T>
+    struct codec<T, std::enable_if_t<std::is_trivially_copyable_v<T>>>
+    {
+        static constexpr bool bitwise = true;
+
+        static void encode(wire_sink &sink, const T &item)
+        {
+            sink.write_value(item);
+        }
+
+        static T decode(wire_source &source)
+        {
+            return source.template read_value<T>();
+        }
+    };
+
+    /*
+    strings are their length followed by their characters
+    */
+    template <typename Char, typename Traits, typename Alloc>
+    struct codec<std::basic_string<Char, Traits, Alloc>>
+    {
+        static void encode(wire_sink &sink, const std::basic_string<Char, Traits, Alloc> &item)
+        {
+            sink.write_value(static_cast<std::uint64_t>(item.size()));
+            sink.write(item.data(), item.size() * sizeof(Char));
+        }
+
+        static std::basic_string<Char, Traits, Alloc> decode(wire_source &source)
+        {
+            std::uint64_t size = source.template read_value<std::uint64_t>();
+            if (size > source.remaining() / sizeof(Char))
+            {
+                throw std::runtime_error("read_from: truncated payload");
+            }
+            std::basic_string<Char, Traits, Alloc> item(static_cast<std::size_t>(size), Char());
+            source.read(&item[0], item.size() * sizeof(Char));
+            return item;
+        }
+    };
+
+    template <typename Codec, typename = void>
+    struct is_bitwise_codec : std::false_type
+    {
+    };
+
+    template <typename Codec>
+    struct is_bitwise_codec<Codec, std::enable_if_t<Codec::bitwise>> : std::true_type
+    {
+    };
+
+    template <typename Codec>
+    inline constexpr bool is_bitwise_codec_v = is_bitwise_codec<Codec>::value;
+
+    namespace detail
+    {
+        [[noreturn]] inline void throw_errno(const char *what)
+        {
+            throw std::system_error(errno, std::generic_category(), what);
+        }
+
+        /*
+        writes every iovec, continuing after partial writes and signals
+        */
+        inline void write_all(int fd, iovec *parts, int count)
+        {
+            while (count > 0)
+            {
+                ssize_t written = ::writev(fd, parts, count);
+                if (written < 0)
+                {
+                    if (errno == EINTR)
+                    {
+                        continue;
+                    }
+                    throw_errno("write_to: writev");
+                }
+                std::size_t left = static_cast<std::size_t>(written);
+                while (count > 0 && left >= parts->iov_len)
+                {
+                    left -= parts->iov_len;
+                    ++parts;
+                    --count;
+                }
+                if (count > 0)
+                {
+                    parts->iov_base = static_cast<char *>(parts->iov_base) + left;
+                    parts->iov_len -= left;
+                }
+            }
+        }
+
+        inline void read_all(int fd, void *data, std::size_t bytes)
+        {
+            char *ptr = static_cast<char *>(data);
+            while (bytes > 0)
+            {
+                ssize_t got = ::read(fd, ptr, bytes);
+                if (got < 0)
+                {
+                    if (errno == EINTR)
+                    {
+                        continue;
+                    }
+                    throw_errno("read_from: read");
+                }
+                if (got == 0)
+                {
+                    throw std::runtime_error("read_from: unexpected end of file");
+                }
+                ptr += got;
+                bytes -= static_cast<std::size_t>(got);
+            }
+        }
+
+        inline void read_all(std::istream &in, void *data, std::size_t bytes)
+        {
+            if (!in.read(static_cast<char *>(data), static_cast<std::streamsize>(bytes)))
+            {
+                throw std::runtime_error("read_from: unexpected end of stream");
+            }
+        }
+
+        /*
+        the header and, when the items are not bitwise, their encoded bytes
+        */
+        template <typename Codec, typename T, typename Alloc, typename GrowthPolicy, typename SizeType>
+        wire_header encode(const vector<T, Alloc, GrowthPolicy, SizeType> &items, vector<char> &payload)
+        {
+            wire_header header{wire_header::wire_magic, wire_header::wire_version, 0, 0, 0, items.size(), 0};
+            if constexpr (is_bitwise_codec_v<Codec>)
+            {
+                header.flags = wire_header::bitwise;
+                header.item_size = sizeof(T);
+                header.payload_bytes = items.size() * sizeof(T);
+            }
+            else
+            {
+                wire_sink sink(payload);
+                for (const T &item : items)
+                {
+                    Codec::encode(sink, item);
+                }
+                header.payload_bytes = payload.size();
+            }
+            return header;
+        }
+
+        template <typename Codec, typename T>
+        void check(const wire_header &header)
+        {
+            if (header.magic != wire_header::wire_magic || header.version != wire_header::wire_version)
+            {
+                throw std::runtime_error("read_from: not a serialized vector, unsupported version or foreign byte order");
+            }
+            bool bitwise = (header.flags & wire_header::bitwise) != 0;
+            if (bitwise != is_bitwise_codec_v<Codec> || (bitwise && (header.item_size != sizeof(T) || header.payload_bytes != header.count * sizeof(T))))
+            {
+                throw std::runtime_error("read_from: payload doesn't match the item type");
+            }
+        }
+
+        /*
+        the header is untrusted, when the source can't tell how many bytes are left (a pipe, a socket)
+        payloads bigger than read_chunk are allocated as their bytes arrive, so a forged payload_bytes
+        can't make the reader allocate much more than the input really holds
+        */
+        inline constexpr std::size_t read_chunk = std::size_t(1) << 20;
+        inline constexpr std::size_t unknown_size = static_cast<std::size_t>(-1);
+
+        /*
+        the bytes left in a regular file, unknown_size for pipes, sockets and devices
+        */
+        inline std::size_t remaining_bytes(int fd) noexcept
+        {
+            struct stat info;
+            if (::fstat(fd, &info) != 0 || !S_ISREG(info.st_mode))
+            {
+                return unknown_size;
+            }
+            off_t at = ::lseek(fd, 0, SEEK_CUR);
+            if (at < 0)
+            {
+                return unknown_size;
+            }
+            return at < info.st_size ? static_cast<std::size_t>(info.st_size - at) : 0;
+        }
+
+        /*
+        the bytes left in a seekable stream, unknown_size for streams that can't seek
+        */
+        inline std::size_t remaining_bytes(std::istream &in)
+        {
+            std::istream::pos_type at = in.tellg();
+            if (at == std::istream::pos_type(-1))
+            {
+                return unknown_size;
+            }
+            in.seekg(0, std::ios_base::end);
+            std::istream::pos_type end = in.tellg();
+            if (!in || end == std::istream::pos_type(-1))
+            {
+                in.clear();
+                in.seekg(at);
+                return unknown_size;
+            }
+            in.seekg(at);
+            return end > at ? static_cast<std::size_t>(end - at) : 0;
+        }
+
+        /*
+        reads the payload of header from in into items, bitwise items are read straight into
+        memory of the vector allocator which the vector then adopts, so they are never copied
+        unless a big message comes from a source of unknown size and has to be read in chunks
+        */
+        template <typename Codec, typename Source, typename T, typename Alloc, typename GrowthPolicy, typename SizeType>
+        void decode(Source &in, const wire_header &header, vector<T, Alloc, GrowthPolicy, SizeType> &items)
+        {
+            check<Codec, T>(header);
+            std::size_t count = static_cast<std::size_t>(header.count);
+            if (header.count > items.max_size())
+            {
+                throw std::length_error("asd::read_from count exceeds max_size()");
+            }
+            std::size_t left = remaining_bytes(in);
+            if (header.payload_bytes > left)
+            {
+                throw std::runtime_error("read_from: the message is longer than the input");
+            }
+            std::size_t bytes = static_cast<std::size_t>(header.payload_bytes);
+            bool chunked = left == unknown_size && bytes > read_chunk;
+            if constexpr (is_bitwise_codec_v<Codec>)
+            {
+                using alloc_traits = std::allocator_traits<Alloc>;
+                Alloc alloc = items.get_allocator();
+                std::size_t capacity = chunked ? std::max<std::size_t>(1, read_chunk / sizeof(T)) : count;
+                T *data_ptr = count == 0 ? nullptr : alloc_traits::allocate(alloc, capacity);
+                std::size_t done = 0;
+                try
+                {
+                    while (done < count)
+                    {
+                        if (done == capacity)
+                        {
+                            std::size_t grown = capacity < count - capacity ? 2 * capacity : count;
+                            T *grown_ptr = alloc_traits::allocate(alloc, grown);
+                            std::memcpy(static_cast<void *>(grown_ptr), data_ptr, done * sizeof(T));
+                            alloc_traits::deallocate(alloc, data_ptr, capacity);
+                            data_ptr = grown_ptr;
+                            capacity = grown;
+                        }
+                        read_all(in, data_ptr + done, (capacity - done) * sizeof(T));
+                        done = capacity;
+                    }
+                }
+                catch (...)
+                {
+                    if (data_ptr != nullptr)
+                    {
+                        alloc_traits::deallocate(alloc, data_ptr, capacity);
+                    }
+                    throw;
+                }
+                items.adopt(data_ptr, count, capacity);
+            }
+            else
+            {
+                vector<char> payload;
+                std::size_t step = chunked ? read_chunk : bytes;
+                while (payload.size() < bytes)
+                {
+                    std::size_t done = payload.size();
+                    payload.resize_uninitialized(done + std::min(step, bytes - done));
+                    read_all(in, payload.data() + done, payload.size() - done);
+                }
+                wire_source source(payload.data(), payload.size());
+                items.erase(0, items.size());
+                items.reserve(std::min(count, bytes));
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    items.push_back(Codec::decode(source));
+                }
+            }
+        }
+    }
+
+    /*
+    writes items to the file descriptor fd (a file, pipe or socket) as one message,
+    header and items go out by a single writev, items that are not bitwise are encoded by Codec first
+    - throws std::system_error if the write fails
+    */
+    template <typename T, typename Alloc, typename GrowthPolicy, typename SizeType, typename Codec = codec<T>>
+    void write_to(int fd, const vector<T, Alloc, GrowthPolicy, SizeType> &items, Codec = Codec())
+    {
+        vector<char> payload;
+        wire_header header = detail::encode<Codec>(items, payload);
+        const void *payload_ptr = is_bitwise_codec_v<Codec> ? static_cast<const void *>(items.data()) : payload.data();
+        iovec parts[2] = {{&header, sizeof(header)}, {const_cast<void *>(payload_ptr), static_cast<std::size_t>(header.payload_bytes)}};
+        detail::write_all(fd, parts, 2);
+    }
+
+    /*
+    writes items to the stream out as one message
+    - throws std::ios_base::failure if the stream fails
+    */
+    template <typename T, typename Alloc, typename GrowthPolicy, typename SizeType, typename Codec = codec<T>>
+    void write_to(std::ostream &out, const vector<T, Alloc, GrowthPolicy, SizeType> &items, Codec = Codec())
+    {
+        vector<char> payload;
+        wire_header header = detail::encode<Codec>(items, payload);
+        const char *payload_ptr = is_bitwise_codec_v<Codec> ? reinterpret_cast<const char *>(items.data()) : payload.data();
+        out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        out.write(payload_ptr, static_cast<std::streamsize>(header.payload_bytes));
+        if (!out)
+        {
+            throw std::ios_base::failure("write_to: stream failed");
+        }
+    }
+
+    /*
+    reads one message written by write_to from fd, it replaces the items
+    it reads exactly the message bytes so the next message stays in the socket or pipe
+    - throws std::system_error if the read fails
+    - throws std::runtime_error if the message is cut or doesn't hold T items
+    */
+    template <typename T, typename Alloc, typename GrowthPolicy, typename SizeType, typename Codec = codec<T>>
+    void read_from(int fd, vector<T, Alloc, GrowthPolicy, SizeType> &items, Codec = Codec())
+    {
+        wire_header header;
+        detail::read_all(fd, &header, sizeof(header));
+        detail::decode<Codec>(fd, header, items);
+    }
+
+    /*
+    reads one message written by write_to from the stream in, it replaces the items
+    - throws std::runtime_error if the message is cut or doesn't hold T items
+    */
+    template <typename T, typename Alloc, typename GrowthPolicy, typename SizeType, typename Codec = codec<T>>
+    void read_from(std::istream &in, vector<T, Alloc, GrowthPolicy, SizeType> &items, Codec = Codec())
+    {
+        wire_header header;
+        detail::read_all(in, &header, sizeof(header));
+        detail::decode<Codec>(in, header, items);
+    }
+
+    /*
+    reads up to max_bytes from fd straight into the tail of buffer, the new tail is not zeroed first
+    and the buffer grows by its growth policy, so repeated reads into a receive buffer are amortized
+    returns the number of bytes read, 0 at end of file
+    - throws std::system_error if the read fails (EAGAIN included for non-blocking fds)
+    */
+    template <typename T, typename Alloc, typename GrowthPolicy, typename SizeType>
+    std::size_t append_from_fd(int fd, vector<T, Alloc, GrowthPolicy, SizeType> &buffer, std::size_t max_bytes)
+    {
+        static_assert(sizeof(T) == 1, "append_from_fd reads into byte buffers");
+        std::size_t old_size = buffer.size();
+        buffer.resize_uninitialized(old_size + max_bytes);
+        ssize_t got;
+        do
+        {
+            got = ::read(fd, buffer.data() + old_size, max_bytes);
+        } while (got < 0 && errno == EINTR);
+        if (got < 0)
+        {
+            buffer.resize_uninitialized(old_size);
+            detail::throw_errno("append_from_fd: read");
+        }
+        buffer.resize_uninitialized(old_size + static_cast<std::size_t>(got));
+        return static_cast<std::size_t>(got);
+    }
+}
+#endif //ifndef ASD_SERIALIZATION_2023
@@ -0,0 +1,217 @@
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <cstdint>
+#include <stdexcept>
+#include <assert.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "vector.hpp"
+#include "serialization.hpp"
+
+struct order
+{
+    std::string symbol;
+    std::int64_t quantity;
+};
+
+// codec of a user type, it reuses the string codec
+namespace asd
+{
+    template <>
+    struct codec<order>
+    {
+        static void encode(wire_sink &sink, const order &item)
+        {
+            codec<std::string>::encode(sink, item.symbol);
+            sink.write_value(item.quantity);
+        }
+
+        static order decode(wire_source &source)
+        {
+            order item;
+            item.symbol = codec<std::string>::decode(source);
+            item.quantity = source.read_value<std::int64_t>();
+            return item;
+        }
+    };
+}
+
+// a user type without a default constructor
+struct level
+{
+    explicit level(std::int64_t value) : price(value)
+    {
+    }
+
+    std::int64_t price;
+};
+
+namespace asd
+{
+    template <>
+    struct codec<level>
+    {
+        static void encode(wire_sink &sink, const level &item)
+        {
+            sink.write_value(item.price);
+        }
+
+        static level decode(wire_source &source)
+        {
+            return level(source.read_value<std::int64_t>());
+        }
+    };
+}
+
+int main()
+{
+    int fds[2];
+    int result = ::socketpair(AF_UNIX, SOCK_STREAM, 0, fds);
+    assert(result == 0);
+    (void)result;
+
+    // Test bitwise items over a socket, two messages back to back stay apart
+    asd::vector<double> myVec1;
+    for (int i = 0; i < 1000; ++i)
+    {
+        myVec1.push_back(i * 0.5);
+    }
+    asd::vector<int> myVec2{};
+    myVec2.append({1, 2, 3});
+    asd::write_to(fds[0], myVec1);
+    asd::write_to(fds[0], myVec2);
+    asd::vector<double> myVec3;
+    myVec3.append({42.0});
+    asd::read_from(fds[1], myVec3);
+    assert(myVec3.size() == 1000 && myVec3.capacity() == 1000 && myVec3[999] == 999 * 0.5);
+    asd::vector<int> myVec4;
+    asd::read_from(fds[1], myVec4);
+    assert(myVec4.size() == 3 && myVec4[2] == 3);
+
+    // Test empty vectors
+    asd::vector<int> myVec5;
+    asd::write_to(fds[0], myVec5);
+    asd::read_from(fds[1], myVec4);
+    assert(myVec4.empty());
+
+    // Test strings and user codecs through streams
+    asd::vector<std::string> myVec6;
+    for (int i = 0; i < 100; ++i)
+    {
+        myVec6.push_back("serialized string that is long enough to go to heap " + std::to_string(i));
+    }
+    myVec6.push_back("");
+    asd::vector<order> myVec7;
+    myVec7.push_back(order{"ASD", 10});
+    myVec7.push_back(order{"VEC", -5});
+    std::stringstream stream;
+    asd::write_to(stream, myVec6);
+    asd::write_to(stream, myVec7);
+    asd::vector<std::string> myVec8;
+    asd::read_from(stream, myVec8);
+    assert(myVec8.size() == 101 && myVec8[42] == myVec6[42] && myVec8[100].empty());
+    asd::vector<order> myVec9;
+    asd::read_from(stream, myVec9);
+    assert(myVec9.size() == 2 && myVec9[1].symbol == "VEC" && myVec9[1].quantity == -5);
+
+    // Test encoded items over a socket
+    asd::write_to(fds[0], myVec6);
+    asd::read_from(fds[1], myVec8);
+    assert(myVec8.size() == 101 && myVec8[99] == myVec6[99]);
+
+    // Test messages of another type and cut messages are refused
+    std::stringstream otherStream;
+    asd::write_to(otherStream, myVec2);
+    bool thrown = false;
+    try
+    {
+        asd::read_from(otherStream, myVec1);
+    }
+    catch (const std::runtime_error &)
+    {
+        thrown = true;
+    }
+    assert(thrown);
+    std::string bytes = stream.str();
+    std::stringstream cutStream(bytes.substr(0, bytes.size() / 2));
+    thrown = false;
+    try
+    {
+        asd::read_from(cutStream, myVec8);
+        asd::read_from(cutStream, myVec9);
+    }
+    catch (const std::runtime_error &)
+    {
+        thrown = true;
+    }
+    assert(thrown);
+
+    // Test items without a default constructor
+    asd::vector<level> myVec11;
+    myVec11.push_back(level(7));
+    myVec11.push_back(level(-3));
+    std::stringstream levelStream;
+    asd::write_to(levelStream, myVec11);
+    asd::vector<level> myVec12;
+    myVec12.push_back(level(1));
+    asd::read_from(levelStream, myVec12);
+    assert(myVec12.size() == 2 && myVec12[0].price == 7 && myVec12[1].price == -3);
+
+    // Test forged headers claiming more bytes than the input holds are refused before allocating
+    asd::wire_header forged{asd::wire_header::wire_magic, asd::wire_header::wire_version, 0, 0, 0, std::uint64_t(1) << 40, std::uint64_t(1) << 44};
+    std::stringstream forgedStream;
+    forgedStream.write(reinterpret_cast<const char *>(&forged), sizeof(forged));
+    forgedStream.write("abcd", 4);
+    thrown = false;
+    try
+    {
+        asd::read_from(forgedStream, myVec8);
+    }
+    catch (const std::runtime_error &)
+    {
+        thrown = true;
+    }
+    assert(thrown && myVec8.size() == 101);
+    forged.flags = asd::wire_header::bitwise;
+    forged.item_size = sizeof(std::uint64_t);
+    forged.payload_bytes = forged.count * sizeof(std::uint64_t);
+    int pipeFds[2];
+    result = ::pipe(pipeFds);
+    assert(result == 0);
+    ssize_t written = ::write(pipeFds[1], &forged, sizeof(forged));
+    assert(written == static_cast<ssize_t>(sizeof(forged)));
+    ::close(pipeFds[1]);
+    asd::vector<std::uint64_t> myVec13;
+    thrown = false;
+    try
+    {
+        asd::read_from(pipeFds[0], myVec13);
+    }
+    catch (const std::runtime_error &)
+    {
+        thrown = true;
+    }
+    assert(thrown && myVec13.empty());
+    ::close(pipeFds[0]);
+
+    // Test receive buffers read straight into their tail
+    const char text[] = "0123456789";
+    written = ::write(fds[0], text, 10);
+    assert(written == 10);
+    (void)written;
+    asd::vector<char> myVec10;
+    myVec10.push_back('>');
+    std::size_t got = asd::append_from_fd(fds[1], myVec10, 4096);
+    assert(got == 10 && myVec10.size() == 11 && myVec10[0] == '>' && myVec10[10] == '9');
+    ::close(fds[0]);
+    got = asd::append_from_fd(fds[1], myVec10, 4096);
+    assert(got == 0 && myVec10.size() == 11);
+    (void)got;
+    ::close(fds[1]);
+
+    std::cout << "serialization examples done" << std::endl;
+
+    return 0;
+}
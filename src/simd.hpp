@@ -0,0 +1,1419 @@
+/*
+ * Copyright (C) 2023 Sofyan Gaber <sofyanhalaby@gmail.com>
+ *
+ * This code is for demonstration and educational purposes. It 
+ * implements explicitly vectorized kernels with runtime dispatch.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ASD_SIMD_2023
+#define ASD_SIMD_2023
+#include <atomic>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define ASD_SIMD_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define ASD_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+/*
+asd::simd provides explicitly vectorized kernels over contiguous float, double and int32_t items:
+sum, min, max, dot, axpy, clamp and count_if over compare predicates,
+plus popcount and find_nonzero over the 64 bit words of bit sets such as asd::bit_vector
+every kernel is compiled for SSE2, AVX2 and AVX-512 on x86, or NEON on aarch64, plus a scalar fallback,
+the best instruction set the CPU supports is picked at run time
+the kernels take pointer + count, or any container with data() and size() such as asd::vector
+floating point sums are computed in a different order than a plain loop, so they may differ in the last bits,
+int32_t sums and products wrap around like unsigned arithmetic
+*/
+namespace asd
+{
+    namespace simd
+    {
+        enum class isa
+        {
+            scalar,
+            sse2,
+            avx2,
+            avx512,
+            neon
+        };
+
+        /*
+        compare predicates of count_if, an item is counted if (item Op value)
+        */
+        enum class cmp
+        {
+            equal,
+            not_equal,
+            less,
+            less_equal,
+            greater,
+            greater_equal
+        };
+
+        inline const char *isa_name(isa set) noexcept
+        {
+            switch (set)
+            {
+            case isa::sse2:
+                return "sse2";
+            case isa::avx2:
+                return "avx2";
+            case isa::avx512:
+                return "avx512";
+            case isa::neon:
+                return "neon";
+            default:
+                return "scalar";
+            }
+        }
+
+        /*
+        tells whether the CPU and the compiler support the instruction set
+        */
+        inline bool is_supported(isa set) noexcept
+        {
+            switch (set)
+            {
+            case isa::scalar:
+                return true;
+#ifdef ASD_SIMD_X86
+            case isa::sse2:
+                return __builtin_cpu_supports("sse2");
+            case isa::avx2:
+                return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma") && __builtin_cpu_supports("popcnt") &&
+                       __builtin_cpu_supports("bmi");
+            case isa::avx512:
+                return __builtin_cpu_supports("avx512f") && is_supported(isa::avx2);
+#endif
+#ifdef ASD_SIMD_NEON
+            case isa::neon:
+                return true;
+#endif
+            default:
+                return false;
+            }
+        }
+
+        /*
+        the best instruction set supported on this machine
+        */
+        inline isa best_isa() noexcept
+        {
+            for (isa set : {isa::avx512, isa::avx2, isa::sse2, isa::neon})
+            {
+                if (is_supported(set))
+                {
+                    return set;
+                }
+            }
+            return isa::scalar;
+        }
+
+        namespace detail
+        {
+            inline std::atomic<isa> &active() noexcept
+            {
+                static std::atomic<isa> active_isa{best_isa()};
+                return active_isa;
+            }
+
+            template <typename T>
+            inline constexpr bool is_supported_type_v = std::is_same_v<T, float> || std::is_same_v<T, double> || std::is_same_v<T, std::int32_t>;
+
+            template <typename T>
+            T wrapping_add(T a, T b) noexcept
+            {
+                if constexpr (std::is_integral_v<T>)
+                {
+                    using U = std::make_unsigned_t<T>;
+                    return static_cast<T>(static_cast<U>(a) + static_cast<U>(b));
+                }
+                else
+                {
+                    return a + b;
+                }
+            }
+
+            template <typename T>
+            T wrapping_mul(T a, T b) noexcept
+            {
+                if constexpr (std::is_integral_v<T>)
+                {
+                    using U = std::make_unsigned_t<T>;
+                    return static_cast<T>(static_cast<U>(a) * static_cast<U>(b));
+                }
+                else
+                {
+                    return a * b;
+                }
+            }
+
+            template <typename T>
+            constexpr T min_identity() noexcept
+            {
+                return std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity() : std::numeric_limits<T>::max();
+            }
+
+            template <typename T>
+            constexpr T max_identity() noexcept
+            {
+                return std::numeric_limits<T>::has_infinity ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::lowest();
+            }
+
+            template <cmp Op, typename T>
+            bool compare(T a, T b) noexcept
+            {
+                if constexpr (Op == cmp::equal)
+                {
+                    return a == b;
+                }
+                else if constexpr (Op == cmp::not_equal)
+                {
+                    return a != b;
+                }
+                else if constexpr (Op == cmp::less)
+                {
+                    return a < b;
+                }
+                else if constexpr (Op == cmp::less_equal)
+                {
+                    return a <= b;
+                }
+                else if constexpr (Op == cmp::greater)
+                {
+                    return a > b;
+                }
+                else
+                {
+                    return a >= b;
+                }
+            }
+
+            /*
+            reduces the lanes of a register stored to memory
+            */
+            template <typename T, std::size_t W>
+            struct lanes
+            {
+                T items[W];
+
+                T add() const noexcept
+                {
+                    T result = items[0];
+                    for (std::size_t i = 1; i < W; i++)
+                    {
+                        result = wrapping_add(result, items[i]);
+                    }
+                    return result;
+                }
+
+                T min() const noexcept
+                {
+                    T result = items[0];
+                    for (std::size_t i = 1; i < W; i++)
+                    {
+                        result = items[i] < result ? items[i] : result;
+                    }
+                    return result;
+                }
+
+                T max() const noexcept
+                {
+                    T result = items[0];
+                    for (std::size_t i = 1; i < W; i++)
+                    {
+                        result = items[i] > result ? items[i] : result;
+                    }
+                    return result;
+                }
+            };
+
+            /*
+            scalar fallback, a register holds a single item
+            */
+            namespace scalar
+            {
+                template <typename T>
+                struct ops
+                {
+                    using reg = T;
+                    static constexpr std::size_t width = 1;
+
+                    static reg zero() noexcept { return T(0); }
+                    static reg broadcast(T value) noexcept { return value; }
+                    static reg load(const T *ptr) noexcept { return *ptr; }
+                    static void store(T *ptr, reg r) noexcept { *ptr = r; }
+                    static reg add(reg a, reg b) noexcept { return wrapping_add(a, b); }
+                    static reg mul(reg a, reg b) noexcept { return wrapping_mul(a, b); }
+                    static reg mul_add(reg a, reg b, reg c) noexcept { return wrapping_add(wrapping_mul(a, b), c); }
+                    static reg min(reg a, reg b) noexcept { return a < b ? a : b; }
+                    static reg max(reg a, reg b) noexcept { return a > b ? a : b; }
+                    static T reduce_add(reg r) noexcept { return r; }
+                    static T reduce_min(reg r) noexcept { return r; }
+                    static T reduce_max(reg r) noexcept { return r; }
+
+                    template <cmp Op>
+                    static std::size_t count(reg a, reg b) noexcept
+                    {
+                        return compare<Op>(a, b) ? 1 : 0;
+                    }
+                };
+
+#include "simd_kernels.hpp"
+
+                /*
+                kernels over 64 bit words of bit sets, they are not templates of ops<T> as their
+                fast forms need instructions of their own (popcnt, tzcnt and the test instructions)
+                */
+                inline std::size_t popcount(const std::uint64_t *words, std::size_t n) noexcept
+                {
+                    std::size_t count = 0;
+                    for (std::size_t i = 0; i < n; i++)
+                    {
+                        count += static_cast<std::size_t>(__builtin_popcountll(words[i]));
+                    }
+                    return count;
+                }
+
+                inline std::size_t find_nonzero(const std::uint64_t *words, std::size_t n) noexcept
+                {
+                    for (std::size_t i = 0; i < n; i++)
+                    {
+                        if (words[i] != 0)
+                        {
+                            return i;
+                        }
+                    }
+                    return n;
+                }
+            }
+        }
+    }
+}
+
+#ifdef ASD_SIMD_X86
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("sse2"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+namespace asd
+{
+    namespace simd
+    {
+        namespace detail
+        {
+            namespace sse2
+            {
+                template <typename T>
+                struct ops;
+
+                template <>
+                struct ops<float>
+                {
+                    using reg = __m128;
+                    static constexpr std::size_t width = 4;
+
+                    static reg zero() noexcept { return _mm_setzero_ps(); }
+                    static reg broadcast(float value) noexcept { return _mm_set1_ps(value); }
+                    static reg load(const float *ptr) noexcept { return _mm_loadu_ps(ptr); }
+                    static void store(float *ptr, reg r) noexcept { _mm_storeu_ps(ptr, r); }
+                    static reg add(reg a, reg b) noexcept { return _mm_add_ps(a, b); }
+                    static reg mul(reg a, reg b) noexcept { return _mm_mul_ps(a, b); }
+                    static reg mul_add(reg a, reg b, reg c) noexcept { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+                    static reg min(reg a, reg b) noexcept { return _mm_min_ps(a, b); }
+                    static reg max(reg a, reg b) noexcept { return _mm_max_ps(a, b); }
+
+                    static lanes<float, width> spill(reg r) noexcept
+                    {
+                        lanes<float, width> result;
+                        _mm_storeu_ps(result.items, r);
+                        return result;
+                    }
+
+                    static float reduce_add(reg r) noexcept { return spill(r).add(); }
+                    static float reduce_min(reg r) noexcept { return spill(r).min(); }
+                    static float reduce_max(reg r) noexcept { return spill(r).max(); }
+
+                    template <cmp Op>
+                    static std::size_t count(reg a, reg b) noexcept
+                    {
+                        reg mask;
+                        if constexpr (Op == cmp::equal)
+                        {
+                            mask = _mm_cmpeq_ps(a, b);
+                        }
+                        else if constexpr (Op == cmp::not_equal)
+                        {
+                            mask = _mm_cmpneq_ps(a, b);
+                        }
+                        else if constexpr (Op == cmp::less)
+                        {
+                            mask = _mm_cmplt_ps(a, b);
+                        }
+                        else if constexpr (Op == cmp::less_equal)
+                        {
+                            mask = _mm_cmple_ps(a, b);
+                        }
+                        else if constexpr (Op == cmp::greater)
+                        {
+                            mask = _mm_cmpgt_ps(a, b);
+                        }
+                        else
+                        {
+                            mask = _mm_cmpge_ps(a, b);
+                        }
+                        return static_cast<std::size_t>(__builtin_popcount(_mm_movemask_ps(mask)));
+                    }
+                };
+
+                template <>
+                struct ops<double>
+                {
+                    using reg = __m128d;
+                    static constexpr std::size_t width = 2;
+
+                    static reg zero() noexcept { return _mm_setzero_pd(); }
+                    static reg broadcast(double value) noexcept { return _mm_set1_pd(value); }
+                    static reg load(const double *ptr) noexcept { return _mm_loadu_pd(ptr); }
+                    static void store(double *ptr, reg r) noexcept { _mm_storeu_pd(ptr, r); }
+                    static reg add(reg a, reg b) noexcept { return _mm_add_pd(a, b); }
+                    static reg mul(reg a, reg b) noexcept { return _mm_mul_pd(a, b); }
+                    static reg mul_add(reg a, reg b, reg c) noexcept { return _mm_add_pd(_mm_mul_pd(a, b), c); }
+                    static reg min(reg a, reg b) noexcept { return _mm_min_pd(a, b); }
+                    static reg max(reg a, reg b) noexcept { return _mm_max_pd(a, b); }
+
+                    static lanes<double, width> spill(reg r) noexcept
+                    {
+                        lanes<double, width> result;
+                        _mm_storeu_pd(result.items, r);
+                        return result;
+                    }
+
+                    static double reduce_add(reg r) noexcept { return spill(r).add(); }
+                    static double reduce_min(reg r) noexcept { return spill(r).min(); }
+                    static double reduce_max(reg r) noexcept { return spill(r).max(); }
+
+                    template <cmp Op>
+                    static std::size_t count(reg a, reg b) noexcept
+                    {
+                        reg mask;
+                        if constexpr (Op == cmp::equal)
+                        {
+                            mask = _mm_cmpeq_pd(a, b);
+                        }
+                        else if constexpr (Op == cmp::not_equal)
+                        {
+                            mask = _mm_cmpneq_pd(a, b);
+                        }
+                        else if constexpr (Op == cmp::less)
+                        {
+                            mask = _mm_cmplt_pd(a, b);
+                        }
+                        else if constexpr (Op == cmp::less_equal)
+                        {
+                            mask = _mm_cmple_pd(a, b);
+                        }
+                        else if constexpr (Op == cmp::greater)
+                        {
+                            mask = _mm_cmpgt_pd(a, b);
+                        }
+                        else
+                        {
+                            mask = _mm_cmpge_pd(a, b);
+                        }
+                        return static_cast<std::size_t>(__builtin_popcount(_mm_movemask_pd(mask)));
+                    }
+                };
+
+                template <>
+                struct ops<std::int32_t>
+                {
+                    using reg = __m128i;
+                    static constexpr std::size_t width = 4;
+
+                    static reg zero() noexcept { return _mm_setzero_si128(); }
+                    static reg broadcast(std::int32_t value) noexcept { return _mm_set1_epi32(value); }
+                    static reg load(const std::int32_t *ptr) noexcept { return _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr)); }
+                    static void store(std::int32_t *ptr, reg r) noexcept { _mm_storeu_si128(reinterpret_cast<__m128i *>(ptr), r); }
+                    static reg add(reg a, reg b) noexcept { return _mm_add_epi32(a, b); }
+
+                    // SSE2 has no 32 bit multiply, multiply the even and odd lanes as 64 bit and keep the low halves
+                    static reg mul(reg a, reg b) noexcept
+                    {
+                        reg even = _mm_mul_epu32(a, b);
+                        reg odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+                        return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+                    }
+
+                    static reg mul_add(reg a, reg b, reg c) noexcept { return _mm_add_epi32(mul(a, b), c); }
+
+                    // SSE2 has no 32 bit min / max, select by the compare mask
+                    static reg min(reg a, reg b) noexcept
+                    {
+                        reg mask = _mm_cmplt_epi32(a, b);
+                        return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+                    }
+
+                    static reg max(reg a, reg b) noexcept
+                    {
+                        reg mask = _mm_cmpgt_epi32(a, b);
+                        return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+                    }
+
+                    static lanes<std::int32_t, width> spill(reg r) noexcept
+                    {
+                        lanes<std::int32_t, width> result;
+                        store(result.items, r);
+                        return result;
+                    }
+
+                    static std::int32_t reduce_add(reg r) noexcept { return spill(r).add(); }
+                    static std::int32_t reduce_min(reg r) noexcept { return spill(r).min(); }
+                    static std::int32_t reduce_max(reg r) noexcept { return spill(r).max(); }
+
+                    static std::size_t count_mask(reg mask) noexcept
+                    {
+                        return static_cast<std::size_t>(__builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(mask))));
+                    }
+
+                    // integers are totally ordered, so the negated predicates count the remaining lanes
+                    template <cmp Op>
+                    static std::size_t count(reg a, reg b) noexcept
+                    {
+                        if constexpr (Op == cmp::equal)
+                        {
+                            return count_mask(_mm_cmpeq_epi32(a, b));
+                        }
+                        else if constexpr (Op == cmp::not_equal)
+                        {
+                            return width - count_mask(_mm_cmpeq_epi32(a, b));
+                        }
+                        else if constexpr (Op == cmp::less)
+                        {
+                            return count_mask(_mm_cmplt_epi32(a, b));
+                        }
+                        else if constexpr (Op == cmp::less_equal)
+                        {
+                            return width - count_mask(_mm_cmpgt_epi32(a, b));
+                        }
+                        else if constexpr (Op == cmp::greater)
+                        {
+                            return count_mask(_mm_cmpgt_epi32(a, b));
+                        }
+                        else
+                        {
+                            return width - count_mask(_mm_cmplt_epi32(a, b));
+                        }
+                    }
+                };
+
+#include "simd_kernels.hpp"
+
+                // popcnt is not part of SSE2, the word kernels stay scalar
+                using scalar::find_nonzero;
+                using scalar::popcount;
+            }
+        }
+    }
+}
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx2,fma,popcnt,bmi"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("avx2,fma,popcnt,bmi")
+#endif
+namespace asd
+{
+    namespace simd
+    {
+        namespace detail
+        {
+            namespace avx2
+            {
+                template <typename T>
+                struct ops;
+
+                template <>
+                struct ops<float>
+                {
+                    using reg = __m256;
+                    static constexpr std::size_t width = 8;
+
+                    static reg zero() noexcept { return _mm256_setzero_ps(); }
+                    static reg broadcast(float value) noexcept { return _mm256_set1_ps(value); }
+                    static reg load(const float *ptr) noexcept { return _mm256_loadu_ps(ptr); }
+                    static void store(float *ptr, reg r) noexcept { _mm256_storeu_ps(ptr, r); }
+                    static reg add(reg a, reg b) noexcept { return _mm256_add_ps(a, b); }
+                    static reg mul(reg a, reg b) noexcept { return _mm256_mul_ps(a, b); }
+                    static reg mul_add(reg a, reg b, reg c) noexcept { return _mm256_fmadd_ps(a, b, c); }
+                    static reg min(reg a, reg b) noexcept { return _mm256_min_ps(a, b); }
+                    static reg max(reg a, reg b) noexcept { return _mm256_max_ps(a, b); }
+
+                    static lanes<float, width> spill(reg r) noexcept
+                    {
+                        lanes<float, width> result;
+                        _mm256_storeu_ps(result.items, r);
+                        return result;
+                    }
+
+                    static float reduce_add(reg r) noexcept { return spill(r).add(); }
+                    static float reduce_min(reg r) noexcept { return spill(r).min(); }
+                    static float reduce_max(reg r) noexcept { return spill(r).max(); }
+
+                    template <cmp Op>
+                    static std::size_t count(reg a, reg b) noexcept
+                    {
+                        reg mask;
+                        if constexpr (Op == cmp::equal)
+                        {
+                            mask = _mm256_cmp_ps(a, b, _CMP_EQ_OQ);
+                        }
+                        else if constexpr (Op == cmp::not_equal)
+                        {
+                            mask = _mm256_cmp_ps(a, b, _CMP_NEQ_UQ);
+                        }
+                        else if constexpr (Op == cmp::less)
+                        {
+                            mask = _mm256_cmp_ps(a, b, _CMP_LT_OQ);
+                        }
+                        else if constexpr (Op == cmp::less_equal)
+                        {
+                            mask = _mm256_cmp_ps(a, b, _CMP_LE_OQ);
+                        }
+                        else if constexpr (Op == cmp::greater)
+                        {
+                            mask = _mm256_cmp_ps(a, b, _CMP_GT_OQ);
+                        }
+                        else
+                        {
+                            mask = _mm256_cmp_ps(a, b, _CMP_GE_OQ);
+                        }
+                        return static_cast<std::size_t>(__builtin_popcount(_mm256_movemask_ps(mask)));
+                    }
+                };
+
+                template <>
+                struct ops<double>
+                {
+                    using reg = __m256d;
+                    static constexpr std::size_t width = 4;
+
+                    static reg zero() noexcept { return _mm256_setzero_pd(); }
+                    static reg broadcast(double value) noexcept { return _mm256_set1_pd(value); }
+                    static reg load(const double *ptr) noexcept { return _mm256_loadu_pd(ptr); }
+                    static void store(double *ptr, reg r) noexcept { _mm256_storeu_pd(ptr, r); }
+                    static reg add(reg a, reg b) noexcept { return _mm256_add_pd(a, b); }
+                    static reg mul(reg a, reg b) noexcept { return _mm256_mul_pd(a, b); }
+                    static reg mul_add(reg a, reg b, reg c) noexcept { return _mm256_fmadd_pd(a, b, c); }
+                    static reg min(reg a, reg b) noexcept { return _mm256_min_pd(a, b); }
+                    static reg max(reg a, reg b) noexcept { return _mm256_max_pd(a, b); }
+
+                    static lanes<double, width> spill(reg r) noexcept
+                    {
+                        lanes<double, width> result;
+                        _mm256_storeu_pd(result.items, r);
+                        return result;
+                    }
+
+                    static double reduce_add(reg r) noexcept { return spill(r).add(); }
+                    static double reduce_min(reg r) noexcept { return spill(r).min(); }
+                    static double reduce_max(reg r) noexcept { return spill(r).max(); }
+
+                    template <cmp Op>
+                    static std::size_t count(reg a, reg b) noexcept
+                    {
+                        reg mask;
+                        if constexpr (Op == cmp::equal)
+                        {
+                            mask = _mm256_cmp_pd(a, b, _CMP_EQ_OQ);
+                        }
+                        else if constexpr (Op == cmp::not_equal)
+                        {
+                            mask = _mm256_cmp_pd(a, b, _CMP_NEQ_UQ);
+                        }
+                        else if constexpr (Op == cmp::less)
+                        {
+                            mask = _mm256_cmp_pd(a, b, _CMP_LT_OQ);
+                        }
+                        else if constexpr (Op == cmp::less_equal)
+                        {
+                            mask = _mm256_cmp_pd(a, b, _CMP_LE_OQ);
+                        }
+                        else if constexpr (Op == cmp::greater)
+                        {
+                            mask = _mm256_cmp_pd(a, b, _CMP_GT_OQ);
+                        }
+                        else
+                        {
+                            mask = _mm256_cmp_pd(a, b, _CMP_GE_OQ);
+                        }
+                        return static_cast<std::size_t>(__builtin_popcount(_mm256_movemask_pd(mask)));
+                    }
+                };
+
+                template <>
+                struct ops<std::int32_t>
+                {
+                    using reg = __m256i;
+                    static constexpr std::size_t width = 8;
+
+                    static reg zero() noexcept { return _mm256_setzero_si256(); }
+                    static reg broadcast(std::int32_t value) noexcept { return _mm256_set1_epi32(value); }
+                    static reg load(const std::int32_t *ptr) noexcept { return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(ptr)); }
+                    static void store(std::int32_t *ptr, reg r) noexcept { _mm256_storeu_si256(reinterpret_cast<__m256i *>(ptr), r); }
+                    static reg add(reg a, reg b) noexcept { return _mm256_add_epi32(a, b); }
+                    static reg mul(reg a, reg b) noexcept { return _mm256_mullo_epi32(a, b); }
+                    static reg mul_add(reg a, reg b, reg c) noexcept { return _mm256_add_epi32(_mm256_mullo_epi32(a, b), c); }
+                    static reg min(reg a, reg b) noexcept { return _mm256_min_epi32(a, b); }
+                    static reg max(reg a, reg b) noexcept { return _mm256_max_epi32(a, b); }
+
+                    static lanes<std::int32_t, width> spill(reg r) noexcept
+                    {
+                        lanes<std::int32_t, width> result;
+                        store(result.items, r);
+                        return result;
+                    }
+
+                    static std::int32_t reduce_add(reg r) noexcept { return spill(r).add(); }
+                    static std::int32_t reduce_min(reg r) noexcept { return spill(r).min(); }
+                    static std::int32_t reduce_max(reg r) noexcept { return spill(r).max(); }
+
+                    static std::size_t count_mask(reg mask) noexcept
+                    {
+                        return static_cast<std::size_t>(__builtin_popcount(_mm256_movemask_ps(_mm256_castsi256_ps(mask))));
+                    }
+
+                    // integers are totally ordered, so the negated predicates count the remaining lanes
+                    template <cmp Op>
+                    static std::size_t count(reg a, reg b) noexcept
+                    {
+                        if constexpr (Op == cmp::equal)
+                        {
+                            return count_mask(_mm256_cmpeq_epi32(a, b));
+                        }
+                        else if constexpr (Op == cmp::not_equal)
+                        {
+                            return width - count_mask(_mm256_cmpeq_epi32(a, b));
+                        }
+                        else if constexpr (Op == cmp::less)
+                        {
+                            return count_mask(_mm256_cmpgt_epi32(b, a));
+                        }
+                        else if constexpr (Op == cmp::less_equal)
+                        {
+                            return width - count_mask(_mm256_cmpgt_epi32(a, b));
+                        }
+                        else if constexpr (Op == cmp::greater)
+                        {
+                            return count_mask(_mm256_cmpgt_epi32(a, b));
+                        }
+                        else
+                        {
+                            return width - count_mask(_mm256_cmpgt_epi32(b, a));
+                        }
+                    }
+                };
+
+#include "simd_kernels.hpp"
+
+                /*
+                four independent chains of popcnt (the target makes __builtin_popcountll one instruction),
+                so its false dependency on the output register on older Intel cores does not serialize them
+                */
+                inline std::size_t popcount(const std::uint64_t *words, std::size_t n) noexcept
+                {
+                    std::uint64_t counts[4] = {0, 0, 0, 0};
+                    std::size_t i = 0;
+                    for (; i + 4 <= n; i += 4)
+                    {
+                        counts[0] += static_cast<std::uint64_t>(__builtin_popcountll(words[i]));
+                        counts[1] += static_cast<std::uint64_t>(__builtin_popcountll(words[i + 1]));
+                        counts[2] += static_cast<std::uint64_t>(__builtin_popcountll(words[i + 2]));
+                        counts[3] += static_cast<std::uint64_t>(__builtin_popcountll(words[i + 3]));
+                    }
+                    for (; i < n; i++)
+                    {
+                        counts[0] += static_cast<std::uint64_t>(__builtin_popcountll(words[i]));
+                    }
+                    return static_cast<std::size_t>(counts[0] + counts[1] + counts[2] + counts[3]);
+                }
+
+                /*
+                tests 8 words (a cache line) per step, the zero words are skipped without a branch per word
+                */
+                inline std::size_t find_nonzero(const std::uint64_t *words, std::size_t n) noexcept
+                {
+                    std::size_t i = 0;
+                    for (; i + 8 <= n; i += 8)
+                    {
+                        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(words + i));
+                        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(words + i + 4));
+                        __m256i any = _mm256_or_si256(a, b);
+                        if (!_mm256_testz_si256(any, any))
+                        {
+                            break;
+                        }
+                    }
+                    for (; i < n; i++)
+                    {
+                        if (words[i] != 0)
+                        {
+                            return i;
+                        }
+                    }
+                    return n;
+                }
+            }
+        }
+    }
+}
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx512f,avx2,popcnt,bmi"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("avx512f,avx2,popcnt,bmi")
+#endif
+namespace asd
+{
+    namespace simd
+    {
+        namespace detail
+        {
+            namespace avx512
+            {
+                // min / max are the masked forms with every lane set, the plain forms trip
+                // -Wmaybe-uninitialized in the GCC 12 headers
+                template <typename T>
+                struct ops;
+
+                template <>
+                struct ops<float>
+                {
+                    using reg = __m512;
+                    static constexpr std::size_t width = 16;
+
+                    static reg zero() noexcept { return _mm512_setzero_ps(); }
+                    static reg broadcast(float value) noexcept { return _mm512_set1_ps(value); }
+                    static reg load(const float *ptr) noexcept { return _mm512_loadu_ps(ptr); }
+                    static void store(float *ptr, reg r) noexcept { _mm512_storeu_ps(ptr, r); }
+                    static reg add(reg a, reg b) noexcept { return _mm512_add_ps(a, b); }
+                    static reg mul(reg a, reg b) noexcept { return _mm512_mul_ps(a, b); }
+                    static reg mul_add(reg a, reg b, reg c) noexcept { return _mm512_fmadd_ps(a, b, c); }
+                    static reg min(reg a, reg b) noexcept { return _mm512_mask_min_ps(a, 0xFFFF, a, b); }
+                    static reg max(reg a, reg b) noexcept { return _mm512_mask_max_ps(a, 0xFFFF, a, b); }
+
+                    static lanes<float, width> spill(reg r) noexcept
+                    {
+                        lanes<float, width> result;
+                        _mm512_storeu_ps(result.items, r);
+                        return result;
+                    }
+
+                    static float reduce_add(reg r) noexcept { return spill(r).add(); }
+                    static float reduce_min(reg r) noexcept { return spill(r).min(); }
+                    static float reduce_max(reg r) noexcept { return spill(r).max(); }
+
+                    template <cmp Op>
+                    static std::size_t count(reg a, reg b) noexcept
+                    {
+                        __mmask16 mask;
+                        if constexpr (Op == cmp::equal)
+                        {
+                            mask = _mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ);
+                        }
+                        else if constexpr (Op == cmp::not_equal)
+                        {
+                            mask = _mm512_cmp_ps_mask(a, b, _CMP_NEQ_UQ);
+                        }
+                        else if constexpr (Op == cmp::less)
+                        {
+                            mask = _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ);
+                        }
+                        else if constexpr (Op == cmp::less_equal)
+                        {
+                            mask = _mm512_cmp_ps_mask(a, b, _CMP_LE_OQ);
+                        }
+                        else if constexpr (Op == cmp::greater)
+                        {
+                            mask = _mm512_cmp_ps_mask(a, b, _CMP_GT_OQ);
+                        }
+                        else
+                        {
+                            mask = _mm512_cmp_ps_mask(a, b, _CMP_GE_OQ);
+                        }
+                        return static_cast<std::size_t>(__builtin_popcount(mask));
+                    }
+                };
+
+                template <>
+                struct ops<double>
+                {
+                    using reg = __m512d;
+                    static constexpr std::size_t width = 8;
+
+                    static reg zero() noexcept { return _mm512_setzero_pd(); }
+                    static reg broadcast(double value) noexcept { return _mm512_set1_pd(value); }
+                    static reg load(const double *ptr) noexcept { return _mm512_loadu_pd(ptr); }
+                    static void store(double *ptr, reg r) noexcept { _mm512_storeu_pd(ptr, r); }
+                    static reg add(reg a, reg b) noexcept { return _mm512_add_pd(a, b); }
+                    static reg mul(reg a, reg b) noexcept { return _mm512_mul_pd(a, b); }
+                    static reg mul_add(reg a, reg b, reg c) noexcept { return _mm512_fmadd_pd(a, b, c); }
+                    static reg min(reg a, reg b) noexcept { return _mm512_mask_min_pd(a, 0xFF, a, b); }
+                    static reg max(reg a, reg b) noexcept { return _mm512_mask_max_pd(a, 0xFF, a, b); }
+
+                    static lanes<double, width> spill(reg r) noexcept
+                    {
+                        lanes<double, width> result;
+                        _mm512_storeu_pd(result.items, r);
+                        return result;
+                    }
+
+                    static double reduce_add(reg r) noexcept { return spill(r).add(); }
+                    static double reduce_min(reg r) noexcept { return spill(r).min(); }
+                    static double reduce_max(reg r) noexcept { return spill(r).max(); }
+
+                    template <cmp Op>
+                    static std::size_t count(reg a, reg b) noexcept
+                    {
+                        __mmask8 mask;
+                        if constexpr (Op == cmp::equal)
+                        {
+                            mask = _mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ);
+                        }
+                        else if constexpr (Op == cmp::not_equal)
+                        {
+                            mask = _mm512_cmp_pd_mask(a, b, _CMP_NEQ_UQ);
+                        }
+                        else if constexpr (Op == cmp::less)
+                        {
+                            mask = _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ);
+                        }
+                        else if constexpr (Op == cmp::less_equal)
+                        {
+                            mask = _mm512_cmp_pd_mask(a, b, _CMP_LE_OQ);
+                        }
+                        else if constexpr (Op == cmp::greater)
+                        {
+                            mask = _mm512_cmp_pd_mask(a, b, _CMP_GT_OQ);
+                        }
+                        else
+                        {
+                            mask = _mm512_cmp_pd_mask(a, b, _CMP_GE_OQ);
+                        }
+                        return static_cast<std::size_t>(__builtin_popcount(mask));
+                    }
+                };
+
+                template <>
+                struct ops<std::int32_t>
+                {
+                    using reg = __m512i;
+                    static constexpr std::size_t width = 16;
+
+                    static reg zero() noexcept { return _mm512_setzero_si512(); }
+                    static reg broadcast(std::int32_t value) noexcept { return _mm512_set1_epi32(value); }
+                    static reg load(const std::int32_t *ptr) noexcept { return _mm512_loadu_si512(ptr); }
+                    static void store(std::int32_t *ptr, reg r) noexcept { _mm512_storeu_si512(ptr, r); }
+                    static reg add(reg a, reg b) noexcept { return _mm512_add_epi32(a, b); }
+                    static reg mul(reg a, reg b) noexcept { return _mm512_mullo_epi32(a, b); }
+                    static reg mul_add(reg a, reg b, reg c) noexcept { return _mm512_add_epi32(_mm512_mullo_epi32(a, b), c); }
+                    static reg min(reg a, reg b) noexcept { return _mm512_mask_min_epi32(a, 0xFFFF, a, b); }
+                    static reg max(reg a, reg b) noexcept { return _mm512_mask_max_epi32(a, 0xFFFF, a, b); }
+
+                    static lanes<std::int32_t, width> spill(reg r) noexcept
+                    {
+                        lanes<std::int32_t, width> result;
+                        store(result.items, r);
+                        return result;
+                    }
+
+                    static std::int32_t reduce_add(reg r) noexcept { return spill(r).add(); }
+                    static std::int32_t reduce_min(reg r) noexcept { return spill(r).min(); }
+                    static std::int32_t reduce_max(reg r) noexcept { return spill(r).max(); }
+
+                    template <cmp Op>
+                    static std::size_t count(reg a, reg b) noexcept
+                    {
+                        __mmask16 mask;
+                        if constexpr (Op == cmp::equal)
+                        {
+                            mask = _mm512_cmp_epi32_mask(a, b, _MM_CMPINT_EQ);
+                        }
+                        else if constexpr (Op == cmp::not_equal)
+                        {
+                            mask = _mm512_cmp_epi32_mask(a, b, _MM_CMPINT_NE);
+                        }
+                        else if constexpr (Op == cmp::less)
+                        {
+                            mask = _mm512_cmp_epi32_mask(a, b, _MM_CMPINT_LT);
+                        }
+                        else if constexpr (Op == cmp::less_equal)
+                        {
+                            mask = _mm512_cmp_epi32_mask(a, b, _MM_CMPINT_LE);
+                        }
+                        else if constexpr (Op == cmp::greater)
+                        {
+                            mask = _mm512_cmp_epi32_mask(a, b, _MM_CMPINT_NLE);
+                        }
+                        else
+                        {
+                            mask = _mm512_cmp_epi32_mask(a, b, _MM_CMPINT_NLT);
+                        }
+                        return static_cast<std::size_t>(__builtin_popcount(mask));
+                    }
+                };
+
+#include "simd_kernels.hpp"
+
+                using avx2::popcount;
+
+                /*
+                tests 8 words (a cache line) per step, the mask of the nonzero words gives the index by tzcnt
+                */
+                inline std::size_t find_nonzero(const std::uint64_t *words, std::size_t n) noexcept
+                {
+                    std::size_t i = 0;
+                    for (; i + 8 <= n; i += 8)
+                    {
+                        __m512i a = _mm512_loadu_si512(words + i);
+                        __mmask8 nonzero = _mm512_test_epi64_mask(a, a);
+                        if (nonzero != 0)
+                        {
+                            return i + static_cast<std::size_t>(_tzcnt_u32(nonzero));
+                        }
+                    }
+                    for (; i < n; i++)
+                    {
+                        if (words[i] != 0)
+                        {
+                            return i;
+                        }
+                    }
+                    return n;
+                }
+            }
+        }
+    }
+}
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+#endif //ifdef ASD_SIMD_X86
+
+#ifdef ASD_SIMD_NEON
+namespace asd
+{
+    namespace simd
+    {
+        namespace detail
+        {
+            namespace neon
+            {
+                template <typename T>
+                struct ops;
+
+                template <>
+                struct ops<float>
+                {
+                    using reg = float32x4_t;
+                    static constexpr std::size_t width = 4;
+
+                    static reg zero() noexcept { return vdupq_n_f32(0.0f); }
+                    static reg broadcast(float value) noexcept { return vdupq_n_f32(value); }
+                    static reg load(const float *ptr) noexcept { return vld1q_f32(ptr); }
+                    static void store(float *ptr, reg r) noexcept { vst1q_f32(ptr, r); }
+                    static reg add(reg a, reg b) noexcept { return vaddq_f32(a, b); }
+                    static reg mul(reg a, reg b) noexcept { return vmulq_f32(a, b); }
+                    static reg mul_add(reg a, reg b, reg c) noexcept { return vfmaq_f32(c, a, b); }
+                    static reg min(reg a, reg b) noexcept { return vminq_f32(a, b); }
+                    static reg max(reg a, reg b) noexcept { return vmaxq_f32(a, b); }
+                    static float reduce_add(reg r) noexcept { return vaddvq_f32(r); }
+                    static float reduce_min(reg r) noexcept { return vminvq_f32(r); }
+                    static float reduce_max(reg r) noexcept { return vmaxvq_f32(r); }
+
+                    static std::size_t count_mask(uint32x4_t mask) noexcept
+                    {
+                        return vaddvq_u32(vshrq_n_u32(mask, 31));
+                    }
+
+                    template <cmp Op>
+                    static std::size_t count(reg a, reg b) noexcept
+                    {
+                        if constexpr (Op == cmp::equal)
+                        {
+                            return count_mask(vceqq_f32(a, b));
+                        }
+                        else if constexpr (Op == cmp::not_equal)
+                        {
+                            // unordered lanes are not equal, as with scalar !=
+                            return width - count_mask(vceqq_f32(a, b));
+                        }
+                        else if constexpr (Op == cmp::less)
+                        {
+                            return count_mask(vcltq_f32(a, b));
+                        }
+                        else if constexpr (Op == cmp::less_equal)
+                        {
+                            return count_mask(vcleq_f32(a, b));
+                        }
+                        else if constexpr (Op == cmp::greater)
+                        {
+                            return count_mask(vcgtq_f32(a, b));
+                        }
+                        else
+                        {
+                            return count_mask(vcgeq_f32(a, b));
+                        }
+                    }
+                };
+
+                template <>
+                struct ops<double>
+                {
+                    using reg = float64x2_t;
+                    static constexpr std::size_t width = 2;
+
+                    static reg zero() noexcept { return vdupq_n_f64(0.0); }
+                    static reg broadcast(double value) noexcept { return vdupq_n_f64(value); }
+                    static reg load(const double *ptr) noexcept { return vld1q_f64(ptr); }
+                    static void store(double *ptr, reg r) noexcept { vst1q_f64(ptr, r); }
+                    static reg add(reg a, reg b) noexcept { return vaddq_f64(a, b); }
+                    static reg mul(reg a, reg b) noexcept { return vmulq_f64(a, b); }
+                    static reg mul_add(reg a, reg b, reg c) noexcept { return vfmaq_f64(c, a, b); }
+                    static reg min(reg a, reg b) noexcept { return vminq_f64(a, b); }
+                    static reg max(reg a, reg b) noexcept { return vmaxq_f64(a, b); }
+                    static double reduce_add(reg r) noexcept { return vaddvq_f64(r); }
+                    static double reduce_min(reg r) noexcept { return vminvq_f64(r); }
+                    static double reduce_max(reg r) noexcept { return vmaxvq_f64(r); }
+
+                    static std::size_t count_mask(uint64x2_t mask) noexcept
+                    {
+                        return static_cast<std::size_t>(vaddvq_u64(vshrq_n_u64(mask, 63)));
+                    }
+
+                    template <cmp Op>
+                    static std::size_t count(reg a, reg b) noexcept
+                    {
+                        if constexpr (Op == cmp::equal)
+                        {
+                            return count_mask(vceqq_f64(a, b));
+                        }
+                        else if constexpr (Op == cmp::not_equal)
+                        {
+                            return width - count_mask(vceqq_f64(a, b));
+                        }
+                        else if constexpr (Op == cmp::less)
+                        {
+                            return count_mask(vcltq_f64(a, b));
+                        }
+                        else if constexpr (Op == cmp::less_equal)
+                        {
+                            return count_mask(vcleq_f64(a, b));
+                        }
+                        else if constexpr (Op == cmp::greater)
+                        {
+                            return count_mask(vcgtq_f64(a, b));
+                        }
+                        else
+                        {
+                            return count_mask(vcgeq_f64(a, b));
+                        }
+                    }
+                };
+
+                template <>
+                struct ops<std::int32_t>
+                {
+                    using reg = int32x4_t;
+                    static constexpr std::size_t width = 4;
+
+                    static reg zero() noexcept { return vdupq_n_s32(0); }
+                    static reg broadcast(std::int32_t value) noexcept { return vdupq_n_s32(value); }
+                    static reg load(const std::int32_t *ptr) noexcept { return vld1q_s32(ptr); }
+                    static void store(std::int32_t *ptr, reg r) noexcept { vst1q_s32(ptr, r); }
+                    static reg add(reg a, reg b) noexcept { return vaddq_s32(a, b); }
+                    static reg mul(reg a, reg b) noexcept { return vmulq_s32(a, b); }
+                    static reg mul_add(reg a, reg b, reg c) noexcept { return vmlaq_s32(c, a, b); }
+                    static reg min(reg a, reg b) noexcept { return vminq_s32(a, b); }
+                    static reg max(reg a, reg b) noexcept { return vmaxq_s32(a, b); }
+                    static std::int32_t reduce_add(reg r) noexcept { return vaddvq_s32(r); }
+                    static std::int32_t reduce_min(reg r) noexcept { return vminvq_s32(r); }
+                    static std::int32_t reduce_max(reg r) noexcept { return vmaxvq_s32(r); }
+
+                    static std::size_t count_mask(uint32x4_t mask) noexcept
+                    {
+                        return vaddvq_u32(vshrq_n_u32(mask, 31));
+                    }
+
+                    template <cmp Op>
+                    static std::size_t count(reg a, reg b) noexcept
+                    {
+                        if constexpr (Op == cmp::equal)
+                        {
+                            return count_mask(vceqq_s32(a, b));
+                        }
+                        else if constexpr (Op == cmp::not_equal)
+                        {
+                            return width - count_mask(vceqq_s32(a, b));
+                        }
+                        else if constexpr (Op == cmp::less)
+                        {
+                            return count_mask(vcltq_s32(a, b));
+                        }
+                        else if constexpr (Op == cmp::less_equal)
+                        {
+                            return count_mask(vcleq_s32(a, b));
+                        }
+                        else if constexpr (Op == cmp::greater)
+                        {
+                            return count_mask(vcgtq_s32(a, b));
+                        }
+                        else
+                        {
+                            return count_mask(vcgeq_s32(a, b));
+                        }
+                    }
+                };
+
+#include "simd_kernels.hpp"
+
+                // __builtin_popcountll is the cnt instruction on aarch64 already
+                using scalar::find_nonzero;
+                using scalar::popcount;
+            }
+        }
+    }
+}
+#endif //ifdef ASD_SIMD_NEON
+
+namespace asd
+{
+    namespace simd
+    {
+        /*
+        the instruction set the kernels run with, the best supported one by default
+        */
+        inline isa active_isa() noexcept
+        {
+            return detail::active().load(std::memory_order_relaxed);
+        }
+
+        /*
+        makes the kernels run with set if it is supported, e.g. to compare instruction sets in benchmarks
+        returns the instruction set in use after the call
+        */
+        inline isa use_isa(isa set) noexcept
+        {
+            if (is_supported(set))
+            {
+                detail::active().store(set, std::memory_order_relaxed);
+            }
+            return active_isa();
+        }
+
+#ifdef ASD_SIMD_X86
+#define ASD_SIMD_DISPATCH_X86(kernel, ...)                  \
+    case isa::avx512:                                       \
+        return detail::avx512::kernel(__VA_ARGS__);         \
+    case isa::avx2:                                         \
+        return detail::avx2::kernel(__VA_ARGS__);           \
+    case isa::sse2:                                         \
+        return detail::sse2::kernel(__VA_ARGS__);
+#else
+#define ASD_SIMD_DISPATCH_X86(kernel, ...)
+#endif
+#ifdef ASD_SIMD_NEON
+#define ASD_SIMD_DISPATCH_NEON(kernel, ...)                 \
+    case isa::neon:                                         \
+        return detail::neon::kernel(__VA_ARGS__);
+#else
+#define ASD_SIMD_DISPATCH_NEON(kernel, ...)
+#endif
+#define ASD_SIMD_DISPATCH_ANY(kernel, ...)                  \
+    switch (active_isa())                                   \
+    {                                                       \
+        ASD_SIMD_DISPATCH_X86(kernel, __VA_ARGS__)          \
+        ASD_SIMD_DISPATCH_NEON(kernel, __VA_ARGS__)         \
+    default:                                                \
+        return detail::scalar::kernel(__VA_ARGS__);         \
+    }
+#define ASD_SIMD_DISPATCH(kernel, ...)                      \
+    static_assert(detail::is_supported_type_v<T>, "asd::simd supports float, double and int32_t items"); \
+    ASD_SIMD_DISPATCH_ANY(kernel, __VA_ARGS__)
+
+        /*
+        sum of n items, 0 if n is 0
+        */
+        template <typename T>
+        T sum(const T *data, std::size_t n)
+        {
+            ASD_SIMD_DISPATCH(sum, data, n)
+        }
+
+        /*
+        smallest of n items, +infinity (or the largest value for integers) if n is 0
+        the result is unspecified if the items have NaN
+        */
+        template <typename T>
+        T min(const T *data, std::size_t n)
+        {
+            ASD_SIMD_DISPATCH(min, data, n)
+        }
+
+        /*
+        largest of n items, -infinity (or the lowest value for integers) if n is 0
+        the result is unspecified if the items have NaN
+        */
+        template <typename T>
+        T max(const T *data, std::size_t n)
+        {
+            ASD_SIMD_DISPATCH(max, data, n)
+        }
+
+        /*
+        sum of x[i] * y[i] of n items
+        */
+        template <typename T>
+        T dot(const T *x, const T *y, std::size_t n)
+        {
+            ASD_SIMD_DISPATCH(dot, x, y, n)
+        }
+
+        /*
+        y[i] = a * x[i] + y[i] for n items, it is fused multiply add where the CPU has it
+        */
+        template <typename T>
+        void axpy(T a, const T *x, T *y, std::size_t n)
+        {
+            ASD_SIMD_DISPATCH(axpy, a, x, y, n)
+        }
+
+        /*
+        limits n items to [lo, hi] in place, NaN items are kept as std::clamp does
+        */
+        template <typename T>
+        void clamp(T *data, std::size_t n, T lo, T hi)
+        {
+            ASD_SIMD_DISPATCH(clamp, data, n, lo, hi)
+        }
+
+        /*
+        number of items where (item op value) holds
+        */
+        template <typename T>
+        std::size_t count_if(const T *data, std::size_t n, cmp op, T value)
+        {
+            ASD_SIMD_DISPATCH(count_if, data, n, op, value)
+        }
+
+        /*
+        number of set bits of n 64 bit words
+        */
+        inline std::size_t popcount(const std::uint64_t *words, std::size_t n)
+        {
+            ASD_SIMD_DISPATCH_ANY(popcount, words, n)
+        }
+
+        /*
+        index of the first nonzero word of n 64 bit words, n if they are all zero
+        */
+        inline std::size_t find_nonzero(const std::uint64_t *words, std::size_t n)
+        {
+            ASD_SIMD_DISPATCH_ANY(find_nonzero, words, n)
+        }
+
+#undef ASD_SIMD_DISPATCH
+#undef ASD_SIMD_DISPATCH_ANY
+#undef ASD_SIMD_DISPATCH_NEON
+#undef ASD_SIMD_DISPATCH_X86
+
+        /*
+        overloads for contiguous containers such as asd::vector and asd::vector_view, they run on data() and size()
+        kernels of two containers use the items of the shortest one
+        */
+        template <typename Container>
+        auto sum(const Container &items) -> decltype(sum(items.data(), items.size()))
+        {
+            return sum(items.data(), items.size());
+        }
+
+        template <typename Container>
+        auto min(const Container &items) -> decltype(min(items.data(), items.size()))
+        {
+            return min(items.data(), items.size());
+        }
+
+        template <typename Container>
+        auto max(const Container &items) -> decltype(max(items.data(), items.size()))
+        {
+            return max(items.data(), items.size());
+        }
+
+        template <typename X, typename Y>
+        auto dot(const X &x, const Y &y) -> decltype(dot(x.data(), y.data(), x.size()))
+        {
+            return dot(x.data(), y.data(), std::min(x.size(), y.size()));
+        }
+
+        template <typename T, typename X, typename Y>
+        auto axpy(T a, const X &x, Y &&y) -> decltype(axpy(a, x.data(), y.data(), x.size()))
+        {
+            axpy(a, x.data(), y.data(), std::min(x.size(), y.size()));
+        }
+
+        template <typename T, typename Container>
+        auto clamp(Container &&items, T lo, T hi) -> decltype(clamp(items.data(), items.size(), lo, hi))
+        {
+            clamp(items.data(), items.size(), lo, hi);
+        }
+
+        template <typename T, typename Container>
+        auto count_if(const Container &items, cmp op, T value) -> decltype(count_if(items.data(), items.size(), op, value))
+        {
+            return count_if(items.data(), items.size(), op, value);
+        }
+    }
+}
+#endif //ifndef ASD_SIMD_2023
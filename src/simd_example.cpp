@@ -0,0 +1,103 @@
+
+#include <iostream>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <assert.h>
+#include "vector.hpp"
+#include "simd.hpp"
+
+namespace
+{
+    // checks every kernel against a scalar loop with the active instruction set
+    template <typename T>
+    void checkKernels(std::size_t n)
+    {
+        asd::vector<T> x;
+        asd::vector<T> y;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            x.push_back(static_cast<T>(static_cast<int>(i % 17) - 8));
+            y.push_back(static_cast<T>(static_cast<int>(i % 5)));
+        }
+
+        T expectedSum = 0;
+        T expectedDot = 0;
+        T expectedMin = asd::simd::detail::min_identity<T>();
+        T expectedMax = asd::simd::detail::max_identity<T>();
+        std::size_t expectedLess = 0;
+        std::size_t expectedNotEqual = 0;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            expectedSum += x[i];
+            expectedDot += x[i] * y[i];
+            expectedMin = std::min(expectedMin, x[i]);
+            expectedMax = std::max(expectedMax, x[i]);
+            expectedLess += x[i] < T(0) ? 1 : 0;
+            expectedNotEqual += x[i] != T(3) ? 1 : 0;
+        }
+        // the items are small integers, so floating point results are exact in any order
+        assert(asd::simd::sum(x) == expectedSum);
+        assert(asd::simd::dot(x, y) == expectedDot);
+        assert(asd::simd::min(x) == expectedMin);
+        assert(asd::simd::max(x) == expectedMax);
+        assert(asd::simd::count_if(x, asd::simd::cmp::less, T(0)) == expectedLess);
+        assert(asd::simd::count_if(x, asd::simd::cmp::not_equal, T(3)) == expectedNotEqual);
+        assert(asd::simd::count_if(x, asd::simd::cmp::greater_equal, T(0)) == n - expectedLess);
+        assert(asd::simd::count_if(x, asd::simd::cmp::less_equal, T(-9)) == 0);
+
+        asd::vector<T> z(y);
+        asd::simd::axpy(T(2), x, z);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            assert(z[i] == T(2) * x[i] + y[i]);
+        }
+
+        asd::simd::clamp(x, T(-2), T(2));
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            assert(x[i] >= T(-2) && x[i] <= T(2));
+        }
+    }
+}
+
+int main()
+{
+    for (asd::simd::isa set : {asd::simd::isa::scalar, asd::simd::isa::sse2, asd::simd::isa::avx2, asd::simd::isa::avx512, asd::simd::isa::neon})
+    {
+        if (!asd::simd::is_supported(set))
+        {
+            continue;
+        }
+        assert(asd::simd::use_isa(set) == set);
+        std::cout << "checking " << asd::simd::isa_name(set) << std::endl;
+        for (std::size_t n : {0, 1, 7, 16, 33, 100, 1029})
+        {
+            checkKernels<float>(n);
+            checkKernels<double>(n);
+            checkKernels<std::int32_t>(n);
+        }
+
+        // Test NaN items are kept by clamp and counted by not_equal only
+        float items[9] = {1, std::numeric_limits<float>::quiet_NaN(), 5, -5, 0, 0, 0, 0, 9};
+        asd::simd::clamp(items, 9, -1.0f, 1.0f);
+        assert(std::isnan(items[1]) && items[2] == 1.0f && items[3] == -1.0f && items[8] == 1.0f);
+        assert(asd::simd::count_if(items, 9, asd::simd::cmp::not_equal, 0.0f) == 5);
+        assert(asd::simd::count_if(items, 9, asd::simd::cmp::less_equal, 1.0f) == 8);
+
+        // Test the word kernels find every nonzero word and count every bit
+        std::uint64_t words[37] = {};
+        assert(asd::simd::popcount(words, 37) == 0 && asd::simd::find_nonzero(words, 37) == 37);
+        for (std::size_t i : {36, 20, 8, 7, 0})
+        {
+            words[i] = ~std::uint64_t(0) >> i;
+            assert(asd::simd::find_nonzero(words, 37) == i && asd::simd::find_nonzero(words + 1, 36) == (i == 0 ? 6 : i - 1));
+        }
+        assert(asd::simd::popcount(words, 37) == 64 * 5 - 36 - 20 - 8 - 7 && asd::simd::popcount(words, 8) == 64 + 57);
+    }
+    asd::simd::use_isa(asd::simd::best_isa());
+
+    std::cout << "simd examples done" << std::endl;
+
+    return 0;
+}
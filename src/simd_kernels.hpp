@@ -0,0 +1,219 @@
+/*
+ * Copyright (C) 2023 Sofyan Gaber <sofyanhalaby@gmail.com>
+ *
+ * This code is for demonstration and educational purposes. It 
+ * implements the asd::simd kernels once for every instruction set.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+this file has no include guard on purpose, simd.hpp includes it once per instruction set
+inside namespace asd::simd::detail::<isa>, where ops<T> wraps the intrinsics of that instruction set
+and the functions are compiled for that instruction set
+ops<T> provides
+    reg, width, zero, broadcast, load, store, add, mul, mul_add (a * b + c), min, max,
+    reduce_add, reduce_min, reduce_max, count<cmp Op>(a, b) (number of lanes where a Op b)
+min(a, b) / max(a, b) return b when a and b are unordered
+*/
+
+template <typename T>
+T sum(const T *data, std::size_t n)
+{
+    using o = ops<T>;
+    constexpr std::size_t w = o::width;
+    // four accumulators hide the latency of the add instruction
+    typename o::reg acc0 = o::zero();
+    typename o::reg acc1 = o::zero();
+    typename o::reg acc2 = o::zero();
+    typename o::reg acc3 = o::zero();
+    std::size_t i = 0;
+    for (; i + 4 * w <= n; i += 4 * w)
+    {
+        acc0 = o::add(acc0, o::load(data + i));
+        acc1 = o::add(acc1, o::load(data + i + w));
+        acc2 = o::add(acc2, o::load(data + i + 2 * w));
+        acc3 = o::add(acc3, o::load(data + i + 3 * w));
+    }
+    for (; i + w <= n; i += w)
+    {
+        acc0 = o::add(acc0, o::load(data + i));
+    }
+    T result = o::reduce_add(o::add(o::add(acc0, acc1), o::add(acc2, acc3)));
+    for (; i < n; i++)
+    {
+        result = ::asd::simd::detail::wrapping_add(result, data[i]);
+    }
+    return result;
+}
+
+template <typename T>
+T min(const T *data, std::size_t n)
+{
+    using o = ops<T>;
+    constexpr std::size_t w = o::width;
+    typename o::reg acc0 = o::broadcast(::asd::simd::detail::min_identity<T>());
+    typename o::reg acc1 = acc0;
+    std::size_t i = 0;
+    for (; i + 2 * w <= n; i += 2 * w)
+    {
+        acc0 = o::min(acc0, o::load(data + i));
+        acc1 = o::min(acc1, o::load(data + i + w));
+    }
+    for (; i + w <= n; i += w)
+    {
+        acc0 = o::min(acc0, o::load(data + i));
+    }
+    T result = o::reduce_min(o::min(acc0, acc1));
+    for (; i < n; i++)
+    {
+        result = data[i] < result ? data[i] : result;
+    }
+    return result;
+}
+
+template <typename T>
+T max(const T *data, std::size_t n)
+{
+    using o = ops<T>;
+    constexpr std::size_t w = o::width;
+    typename o::reg acc0 = o::broadcast(::asd::simd::detail::max_identity<T>());
+    typename o::reg acc1 = acc0;
+    std::size_t i = 0;
+    for (; i + 2 * w <= n; i += 2 * w)
+    {
+        acc0 = o::max(acc0, o::load(data + i));
+        acc1 = o::max(acc1, o::load(data + i + w));
+    }
+    for (; i + w <= n; i += w)
+    {
+        acc0 = o::max(acc0, o::load(data + i));
+    }
+    T result = o::reduce_max(o::max(acc0, acc1));
+    for (; i < n; i++)
+    {
+        result = data[i] > result ? data[i] : result;
+    }
+    return result;
+}
+
+template <typename T>
+T dot(const T *x, const T *y, std::size_t n)
+{
+    using o = ops<T>;
+    constexpr std::size_t w = o::width;
+    typename o::reg acc0 = o::zero();
+    typename o::reg acc1 = o::zero();
+    typename o::reg acc2 = o::zero();
+    typename o::reg acc3 = o::zero();
+    std::size_t i = 0;
+    for (; i + 4 * w <= n; i += 4 * w)
+    {
+        acc0 = o::mul_add(o::load(x + i), o::load(y + i), acc0);
+        acc1 = o::mul_add(o::load(x + i + w), o::load(y + i + w), acc1);
+        acc2 = o::mul_add(o::load(x + i + 2 * w), o::load(y + i + 2 * w), acc2);
+        acc3 = o::mul_add(o::load(x + i + 3 * w), o::load(y + i + 3 * w), acc3);
+    }
+    for (; i + w <= n; i += w)
+    {
+        acc0 = o::mul_add(o::load(x + i), o::load(y + i), acc0);
+    }
+    T result = o::reduce_add(o::add(o::add(acc0, acc1), o::add(acc2, acc3)));
+    for (; i < n; i++)
+    {
+        result = ::asd::simd::detail::wrapping_add(result, ::asd::simd::detail::wrapping_mul(x[i], y[i]));
+    }
+    return result;
+}
+
+template <typename T>
+void axpy(T a, const T *x, T *y, std::size_t n)
+{
+    using o = ops<T>;
+    constexpr std::size_t w = o::width;
+    typename o::reg va = o::broadcast(a);
+    std::size_t i = 0;
+    for (; i + w <= n; i += w)
+    {
+        o::store(y + i, o::mul_add(va, o::load(x + i), o::load(y + i)));
+    }
+    for (; i < n; i++)
+    {
+        y[i] = ::asd::simd::detail::wrapping_add(::asd::simd::detail::wrapping_mul(a, x[i]), y[i]);
+    }
+}
+
+template <typename T>
+void clamp(T *data, std::size_t n, T lo, T hi)
+{
+    using o = ops<T>;
+    constexpr std::size_t w = o::width;
+    typename o::reg vlo = o::broadcast(lo);
+    typename o::reg vhi = o::broadcast(hi);
+    std::size_t i = 0;
+    for (; i + w <= n; i += w)
+    {
+        // the item is the second operand, so NaN items are kept as std::clamp does
+        o::store(data + i, o::min(vhi, o::max(vlo, o::load(data + i))));
+    }
+    for (; i < n; i++)
+    {
+        data[i] = data[i] < lo ? lo : (hi < data[i] ? hi : data[i]);
+    }
+}
+
+template <cmp Op, typename T>
+std::size_t count_compare(const T *data, std::size_t n, T value)
+{
+    using o = ops<T>;
+    constexpr std::size_t w = o::width;
+    typename o::reg vvalue = o::broadcast(value);
+    std::size_t count = 0;
+    std::size_t i = 0;
+    for (; i + w <= n; i += w)
+    {
+        count += o::template count<Op>(o::load(data + i), vvalue);
+    }
+    for (; i < n; i++)
+    {
+        count += ::asd::simd::detail::compare<Op>(data[i], value) ? 1 : 0;
+    }
+    return count;
+}
+
+template <typename T>
+std::size_t count_if(const T *data, std::size_t n, cmp op, T value)
+{
+    switch (op)
+    {
+    case cmp::equal:
+        return count_compare<cmp::equal>(data, n, value);
+    case cmp::not_equal:
+        return count_compare<cmp::not_equal>(data, n, value);
+    case cmp::less:
+        return count_compare<cmp::less>(data, n, value);
+    case cmp::less_equal:
+        return count_compare<cmp::less_equal>(data, n, value);
+    case cmp::greater:
+        return count_compare<cmp::greater>(data, n, value);
+    case cmp::greater_equal:
+        return count_compare<cmp::greater_equal>(data, n, value);
+    }
+    return 0;
+}
@@ -0,0 +1,1202 @@
+/*
+ * Copyright (C) 2023 Sofyan Gaber <sofyanhalaby@gmail.com>
+ *
+ * This code is for demonstration and educational purposes. It 
+ * implements a vector that keeps its first items in an inline buffer.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ASD_SMALL_VECTOR_2023
+#define ASD_SMALL_VECTOR_2023
+#include "vector.hpp"
+
+namespace asd
+{
+    /*
+    class asd::small_vector provides the asd::vector functionality, but keeps up to N items in an inline buffer
+    so small containers don't touch the allocator at all, the memory is allocated only when it grows past N items
+    it converts to and from asd::vector by move, the heap memory is handed over without copying the items
+    */
+    template <typename T, std::size_t N, typename Alloc = allocator<T>, typename GrowthPolicy = growth::doubling>
+    class small_vector
+    {
+        static_assert(N > 0, "small_vector needs inline room for at least one item");
+
+        using alloc_traits = std::allocator_traits<Alloc>;
+        static_assert(std::is_same_v<typename alloc_traits::value_type, T>, "allocator value_type must be T");
+        static_assert(std::is_same_v<typename alloc_traits::pointer, T *>, "fancy pointers are not supported");
+
+        std::size_t m_count; // number of items in the container
+        std::size_t m_capacity; // N while the items are inline, otherwise number of items of the allocated memory
+        T *m_data_ptr; // points to the inline buffer or to the allocated memory
+        ASD_NO_UNIQUE_ADDRESS Alloc m_allocator;
+        alignas(T) unsigned char m_inline[N * sizeof(T)]; // inline buffer, it is not initialized
+
+        T *inline_data() noexcept
+        {
+            return reinterpret_cast<T *>(m_inline);
+        }
+
+        void reset() noexcept
+        {
+            init(N, 0, inline_data());
+        }
+
+        void init(std::size_t capacity, std::size_t count, T *data_ptr) noexcept
+        {
+            m_count = count;
+            m_capacity = capacity;
+            m_data_ptr = data_ptr;
+        }
+
+        template <typename... Args>
+        void construct(T *ptr, Args &&...args)
+        {
+            alloc_traits::construct(m_allocator, ptr, std::forward<Args>(args)...);
+        }
+
+        /*
+        copy_items, move_items and construct_range destroy the items they built when a constructor throws
+        */
+        void copy_items(const T *input, std::size_t count, T *output)
+        {
+            if constexpr (std::is_trivially_copyable_v<T>)
+            {
+                asd::copy(input, count, output);
+            }
+            else
+            {
+                std::size_t i = 0;
+                try
+                {
+                    for (; i < count; i++)
+                    {
+                        construct(output + i, input[i]);
+                    }
+                }
+                catch (...)
+                {
+                    destroy_items(output, output + i);
+                    throw;
+                }
+            }
+        }
+
+        void move_items(T *input, std::size_t count, T *output)
+        {
+            if constexpr (std::is_trivially_copyable_v<T>)
+            {
+                asd::move(input, count, output);
+            }
+            else
+            {
+                std::size_t i = 0;
+                try
+                {
+                    for (; i < count; i++)
+                    {
+                        construct(output + i, std::move(input[i]));
+                    }
+                }
+                catch (...)
+                {
+                    destroy_items(output, output + i);
+                    throw;
+                }
+            }
+        }
+
+        void relocate_items(T *input, std::size_t count, T *output)
+        {
+            if constexpr (is_trivially_relocatable_v<T>)
+            {
+                asd::relocate(input, count, output);
+            }
+            else
+            {
+                move_items(input, count, output);
+                destroy_items(input, input + count);
+            }
+        }
+
+        /*
+        pointers to T are copied by copy_items, so trivially copyable items are copied in bulk by memcpy
+        */
+        template <typename It>
+        static constexpr bool is_item_pointer_v = std::is_pointer_v<It> && std::is_same_v<std::remove_cv_t<std::remove_pointer_t<It>>, T>;
+
+        template <typename It>
+        void construct_range(It first, std::size_t count, T *output)
+        {
+            if constexpr (is_item_pointer_v<It>)
+            {
+                copy_items(first, count, output);
+            }
+            else
+            {
+                std::size_t i = 0;
+                try
+                {
+                    for (; i < count; i++, ++first)
+                    {
+                        construct(output + i, *first);
+                    }
+                }
+                catch (...)
+                {
+                    destroy_items(output, output + i);
+                    throw;
+                }
+            }
+        }
+
+        /*
+        tells whether ptr points to an item of this container, then it may dangle after reallocation
+        */
+        bool owns(const T *ptr) const noexcept
+        {
+            return std::less_equal<const T *>()(m_data_ptr, ptr) && std::less<const T *>()(ptr, m_data_ptr + m_count);
+        }
+
+        /*
+        moves the items [pos, size()) n places forward to leave room for n items at pos, it reallocates once
+        if the capacity is not enough, the gap is not initialized and size() is not changed
+        */
+        void open_gap(std::size_t pos, std::size_t n)
+        {
+            if (m_count + n > m_capacity)
+            {
+                // relocate both sides of the gap straight into the new memory, so the items move only once
+                std::size_t new_capacity = GrowthPolicy::next_capacity(m_capacity, m_count + n, sizeof(T));
+                ASD_INSTRUMENT_CONTAINER_REALLOCATE(sizeof(T), m_count, m_capacity, new_capacity);
+                T *new_data_ptr = alloc_traits::allocate(m_allocator, new_capacity);
+                relocate_items(m_data_ptr, pos, new_data_ptr);
+                relocate_items(m_data_ptr + pos, m_count - pos, new_data_ptr + pos + n);
+                deallocate();
+                init(new_capacity, m_count, new_data_ptr);
+                return;
+            }
+            if constexpr (is_trivially_relocatable_v<T>)
+            {
+                if (m_count != pos)
+                {
+                    std::memmove(static_cast<void *>(m_data_ptr + pos + n), static_cast<const void *>(m_data_ptr + pos), (m_count - pos) * sizeof(T));
+                }
+            }
+            else
+            {
+                for (std::size_t i = m_count; i-- > pos;)
+                {
+                    construct(m_data_ptr + i + n, std::move(m_data_ptr[i]));
+                    alloc_traits::destroy(m_allocator, m_data_ptr + i);
+                }
+            }
+        }
+
+        /*
+        moves the trivially relocatable items [first, last) back to pos over items that are already destroyed
+        */
+        void close_gap(std::size_t pos, std::size_t first, std::size_t last) noexcept
+        {
+            if (pos != first && first != last)
+            {
+                std::memmove(static_cast<void *>(m_data_ptr + pos), static_cast<const void *>(m_data_ptr + first), (last - first) * sizeof(T));
+            }
+        }
+
+        void fill_items(std::size_t first, std::size_t last, const T &value)
+        {
+            for (std::size_t i = first; i < last; i++)
+            {
+                construct(m_data_ptr + i, value);
+            }
+        }
+
+        void destroy_items(T *first, T *last) noexcept
+        {
+            if constexpr (!std::is_trivially_destructible_v<T>)
+            {
+                for (; first != last; ++first)
+                {
+                    alloc_traits::destroy(m_allocator, first);
+                }
+            }
+        }
+
+        void destroy_items(std::size_t first = 0) noexcept
+        {
+            destroy_items(m_data_ptr + first, m_data_ptr + m_count);
+        }
+
+        void deallocate() noexcept
+        {
+            if (!is_inline())
+            {
+                alloc_traits::deallocate(m_allocator, m_data_ptr, m_capacity);
+            }
+        }
+
+        /*
+        the bytes the allocator reserved for the heap memory, see asd::has_usable_size
+        */
+        std::size_t heap_bytes() const noexcept
+        {
+            if (is_inline())
+            {
+                return 0;
+            }
+            if constexpr (has_usable_size_v<Alloc>)
+            {
+                return m_allocator.usable_size(m_data_ptr, m_capacity);
+            }
+            else
+            {
+                return m_capacity * sizeof(T);
+            }
+        }
+
+        void destroy() noexcept
+        {
+            destroy_items();
+            deallocate();
+        }
+
+        /*
+        moves the items to memory of new_capacity items, back to the inline buffer if they fit in it
+        trivially relocatable items on the heap are reallocated by the allocator reallocate extension when it exists
+        new_capacity must not be less than the number of items
+        */
+        void reallocate(std::size_t new_capacity)
+        {
+            if (new_capacity <= N)
+            {
+                if (!is_inline())
+                {
+                    T *old_data_ptr = m_data_ptr;
+                    std::size_t old_capacity = m_capacity;
+                    relocate_items(old_data_ptr, m_count, inline_data());
+                    alloc_traits::deallocate(m_allocator, old_data_ptr, old_capacity);
+                    init(N, m_count, inline_data());
+                }
+                return;
+            }
+            ASD_INSTRUMENT_CONTAINER_REALLOCATE(sizeof(T), m_count, m_capacity, new_capacity);
+            T *new_data_ptr;
+            if constexpr (is_trivially_relocatable_v<T> && has_reallocate_v<Alloc>)
+            {
+                if (!is_inline())
+                {
+                    new_data_ptr = m_allocator.reallocate(m_data_ptr, m_capacity, new_capacity);
+                    init(new_capacity, m_count, new_data_ptr);
+                    return;
+                }
+            }
+            new_data_ptr = alloc_traits::allocate(m_allocator, new_capacity);
+            relocate_items(m_data_ptr, m_count, new_data_ptr);
+            deallocate();
+            init(new_capacity, m_count, new_data_ptr);
+        }
+
+        /*
+        makes room for required items, the new capacity is decided by the growth policy
+        */
+        void grow(std::size_t required)
+        {
+            reallocate(GrowthPolicy::next_capacity(m_capacity, required, sizeof(T)));
+        }
+
+        /*
+        tells whether any of args is an item of this container or a part of one
+        */
+        template <typename... Args>
+        bool owns_any(const Args &...args) const noexcept
+        {
+            const char *first = reinterpret_cast<const char *>(m_data_ptr);
+            const char *last = reinterpret_cast<const char *>(m_data_ptr + m_count);
+            return (... || (std::less_equal<const char *>()(first, reinterpret_cast<const char *>(std::addressof(args))) &&
+                            std::less<const char *>()(reinterpret_cast<const char *>(std::addressof(args)), last)));
+        }
+
+        /*
+        appends an item made of args when the container is full, args may refer to an item,
+        which growing relocates, so then the new item is made before growing
+        */
+        template <typename... Args>
+        void grow_emplace_back(Args &&...args)
+        {
+            if (owns_any(args...))
+            {
+                T item(std::forward<Args>(args)...);
+                grow(m_count + 1);
+                construct(m_data_ptr + m_count, std::move(item));
+            }
+            else
+            {
+                grow(m_count + 1);
+                construct(m_data_ptr + m_count, std::forward<Args>(args)...);
+            }
+            ++m_count;
+        }
+
+        /*
+        takes the items of other, heap memory is taken as is and inline items are relocated
+        to the inline buffer of this container, this container must be empty with no heap memory
+        */
+        void steal(small_vector &other) noexcept
+        {
+            if (other.is_inline())
+            {
+                relocate_items(other.m_data_ptr, other.m_count, inline_data());
+                init(N, other.m_count, inline_data());
+            }
+            else
+            {
+                init(other.m_capacity, other.m_count, other.m_data_ptr);
+            }
+            other.reset();
+        }
+
+    public:
+        using value_type = T;
+        using allocator_type = Alloc;
+        using growth_policy = GrowthPolicy;
+        using iterator = T *;
+        using const_iterator = const T *;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+        using vector_type = vector<T, Alloc, GrowthPolicy>;
+
+        static constexpr std::size_t inline_capacity = N;
+
+        /*
+        non-prameterized consructor, it doesn't allocate
+        */
+        small_vector() noexcept(noexcept(Alloc()))
+            : m_allocator()
+        {
+            reset();
+        }
+
+        /*
+        creates an empty container that allocates its memory by alloc when it grows past N items
+        */
+        explicit small_vector(const Alloc &alloc) noexcept
+            : m_allocator(alloc)
+        {
+            reset();
+        }
+
+        /*
+        copy consructor
+        the allocator is copied as its select_on_container_copy_construction tells
+        */
+        small_vector(const small_vector &other)
+            : m_allocator(alloc_traits::select_on_container_copy_construction(other.m_allocator))
+        {
+            reset();
+            reserve(other.m_count);
+            copy_items(other.m_data_ptr, other.m_count, m_data_ptr);
+            m_count = other.m_count;
+        }
+
+        /*
+        move constructor
+        inline items are relocated, heap memory is taken without moving the items
+        */
+        small_vector(small_vector &&other) noexcept(std::is_nothrow_move_constructible_v<T>)
+            : m_allocator(std::move(other.m_allocator))
+        {
+            steal(other);
+        }
+
+        /*
+        takes the items of an asd::vector, its memory is taken without moving the items
+        if it holds more than N items, otherwise the items are relocated to the inline buffer
+        */
+        small_vector(vector_type &&other) noexcept(std::is_nothrow_move_constructible_v<T>)
+            : m_allocator(other.get_allocator())
+        {
+            reset();
+            std::size_t count = other.size();
+            std::size_t capacity = other.capacity();
+            T *data_ptr = other.release();
+            if (capacity > N)
+            {
+                init(capacity, count, data_ptr);
+            }
+            else if (data_ptr != nullptr)
+            {
+                relocate_items(data_ptr, count, inline_data());
+                m_count = count;
+                alloc_traits::deallocate(m_allocator, data_ptr, capacity);
+            }
+        }
+
+        /*
+        copy assignment operator
+        the allocator is copied if propagate_on_container_copy_assignment is set
+        */
+        small_vector &operator=(const small_vector &other)
+        {
+            if (this == &other)
+            {
+                return *this;
+            }
+            destroy_items();
+            m_count = 0;
+            if constexpr (alloc_traits::propagate_on_container_copy_assignment::value)
+            {
+                if (!alloc_traits::is_always_equal::value && m_allocator != other.m_allocator)
+                {
+                    // memory of the old allocator can't be reused
+                    deallocate();
+                    reset();
+                }
+                m_allocator = other.m_allocator;
+            }
+            reserve(other.m_count);
+            copy_items(other.m_data_ptr, other.m_count, m_data_ptr);
+            m_count = other.m_count;
+            return *this;
+        }
+
+        /*
+        move assignment operator
+        heap memory of other is taken if the allocator propagates or both allocators are equal,
+        otherwise items are moved one by one
+        */
+        small_vector &operator=(small_vector &&other) noexcept(std::is_nothrow_move_constructible_v<T> &&
+                                                               (alloc_traits::propagate_on_container_move_assignment::value ||
+                                                                alloc_traits::is_always_equal::value))
+        {
+            if (this == &other)
+            {
+                return *this;
+            }
+            if constexpr (alloc_traits::propagate_on_container_move_assignment::value)
+            {
+                destroy();
+                m_allocator = std::move(other.m_allocator);
+                steal(other);
+                return *this;
+            }
+            if (!other.is_inline() && (alloc_traits::is_always_equal::value || m_allocator == other.m_allocator))
+            {
+                destroy();
+                steal(other);
+                return *this;
+            }
+            destroy_items();
+            m_count = 0;
+            reserve(other.m_count);
+            move_items(other.m_data_ptr, other.m_count, m_data_ptr);
+            m_count = other.m_count;
+            other.destroy_items();
+            other.m_count = 0;
+            return *this;
+        }
+
+        ~small_vector() noexcept
+        {
+            destroy();
+        }
+
+        /*
+        converts to asd::vector, heap memory is handed over without moving the items,
+        inline items are relocated to memory allocated by the vector allocator
+        */
+        operator vector_type() &&
+        {
+            vector_type result(m_allocator);
+            if (is_inline())
+            {
+                result.reserve(m_count);
+                T *data_ptr = result.release();
+                relocate_items(m_data_ptr, m_count, data_ptr);
+                result.adopt(data_ptr, m_count, m_count);
+            }
+            else
+            {
+                result.adopt(m_data_ptr, m_count, m_capacity);
+            }
+            reset();
+            return result;
+        }
+
+        /*
+        exchanges the items of two containers, heap memory is exchanged as is and inline items are relocated
+        the allocators are swapped if propagate_on_container_swap is set, otherwise they must be equal
+        */
+        void swap(small_vector &other) noexcept(std::is_nothrow_move_constructible_v<T>)
+        {
+            if (this == &other)
+            {
+                return;
+            }
+            if constexpr (alloc_traits::propagate_on_container_swap::value)
+            {
+                std::swap(m_allocator, other.m_allocator);
+            }
+            if (!is_inline() && !other.is_inline())
+            {
+                std::swap(m_count, other.m_count);
+                std::swap(m_capacity, other.m_capacity);
+                std::swap(m_data_ptr, other.m_data_ptr);
+                return;
+            }
+            small_vector items(m_allocator);
+            items.steal(other);
+            other.steal(*this);
+            steal(items);
+        }
+
+        allocator_type get_allocator() const noexcept
+        {
+            return m_allocator;
+        }
+
+        /*
+        tells whether the items are kept in the inline buffer
+        */
+        bool is_inline() const noexcept
+        {
+            return m_data_ptr == reinterpret_cast<const T *>(m_inline);
+        }
+
+        /*
+        add new item
+        it accepts universal reference which binds to both lvalue and rvalue references, item may be an item of this container
+        it raises the bad_alloc exception
+        */
+        template <class U>
+        void push_back(U &&item)
+        {
+            if (m_count == m_capacity)
+            {
+                grow_emplace_back(std::forward<U>(item));
+                return;
+            }
+            construct(m_data_ptr + m_count, std::forward<U>(item));
+            ++m_count;
+        }
+
+        /*
+        creates new item and from passed arguments and adds it to the container, the arguments may refer to its items
+        it raises the bad_alloc exception
+        */
+        template <typename... Args>
+        void emplace_back(Args &&...args)
+        {
+            if (m_count == m_capacity)
+            {
+                grow_emplace_back(std::forward<Args>(args)...);
+                return;
+            }
+            construct(m_data_ptr + m_count, std::forward<Args>(args)...);
+            ++m_count;
+        }
+
+        /*
+        doesn't provide boundary checks to give faster access, API client should take care 
+        */
+        T &operator[](std::size_t idx)
+        {
+            return m_data_ptr[idx];
+        }
+
+        /*
+        doesn't provide boundary checks to give faster access, API client should take care 
+        */
+        const T &operator[](std::size_t idx) const
+        {
+            return m_data_ptr[idx];
+        }
+
+        std::size_t size() const noexcept
+        {
+            return m_count;
+        }
+
+        std::size_t capacity() const noexcept
+        {
+            return m_capacity;
+        }
+
+        /*
+        bytes the container takes, its header and inline buffer plus what the allocator reserved for the heap memory,
+        which is more than capacity() * sizeof(T) when malloc rounds the size up, see asd::has_usable_size
+        */
+        std::size_t memory_usage() const noexcept
+        {
+            return sizeof(*this) + heap_bytes();
+        }
+
+        /*
+        bytes of the buffer in use, inline or heap, that hold no item
+        */
+        std::size_t slack_bytes() const noexcept
+        {
+            return (is_inline() ? N * sizeof(T) : heap_bytes()) - m_count * sizeof(T);
+        }
+
+        /*
+        the most items the container can hold
+        */
+        static constexpr std::size_t max_size() noexcept
+        {
+            return static_cast<std::size_t>(std::numeric_limits<std::ptrdiff_t>::max()) / sizeof(T);
+        }
+
+        bool empty() const noexcept
+        {
+            return m_count == 0;
+        }
+
+        /*
+        pointer to the first item, the items are contiguous
+        */
+        T *data() noexcept
+        {
+            return m_data_ptr;
+        }
+
+        const T *data() const noexcept
+        {
+            return m_data_ptr;
+        }
+
+        /*
+        iterators are raw pointers, they are contiguous iterators so std algorithms
+        (and their SIMD / parallel implementations) operate on the memory directly
+        they are invalidated by any reallocation
+        */
+        iterator begin() noexcept
+        {
+            return m_data_ptr;
+        }
+
+        const_iterator begin() const noexcept
+        {
+            return m_data_ptr;
+        }
+
+        iterator end() noexcept
+        {
+            return m_data_ptr + m_count;
+        }
+
+        const_iterator end() const noexcept
+        {
+            return m_data_ptr + m_count;
+        }
+
+        const_iterator cbegin() const noexcept
+        {
+            return m_data_ptr;
+        }
+
+        const_iterator cend() const noexcept
+        {
+            return m_data_ptr + m_count;
+        }
+
+        reverse_iterator rbegin() noexcept
+        {
+            return reverse_iterator(end());
+        }
+
+        const_reverse_iterator rbegin() const noexcept
+        {
+            return const_reverse_iterator(end());
+        }
+
+        reverse_iterator rend() noexcept
+        {
+            return reverse_iterator(begin());
+        }
+
+        const_reverse_iterator rend() const noexcept
+        {
+            return const_reverse_iterator(begin());
+        }
+
+        const_reverse_iterator crbegin() const noexcept
+        {
+            return const_reverse_iterator(end());
+        }
+
+        const_reverse_iterator crend() const noexcept
+        {
+            return const_reverse_iterator(begin());
+        }
+
+        /*
+        doesn't check the container is not empty, API client should take care
+        */
+        T &front()
+        {
+            return m_data_ptr[0];
+        }
+
+        const T &front() const
+        {
+            return m_data_ptr[0];
+        }
+
+        /*
+        doesn't check the container is not empty, API client should take care
+        */
+        T &back()
+        {
+            return m_data_ptr[m_count - 1];
+        }
+
+        const T &back() const
+        {
+            return m_data_ptr[m_count - 1];
+        }
+
+        /*
+        adds the items of [first, last) at the end
+        the size of forward ranges is computed first so the container reallocates at most once,
+        pointers to trivially copyable items are copied by a single memcpy
+        the range may refer to items of this container
+        it raises the bad_alloc exception
+        */
+        template <typename InputIt, typename = std::enable_if_t<is_iterator_v<InputIt>>>
+        void append(InputIt first, InputIt last)
+        {
+            if constexpr (is_forward_iterator_v<InputIt>)
+            {
+                std::size_t n = static_cast<std::size_t>(std::distance(first, last));
+                if (m_count + n > m_capacity)
+                {
+                    if constexpr (is_item_pointer_v<InputIt>)
+                    {
+                        if (n != 0 && owns(first))
+                        {
+                            std::size_t offset = static_cast<std::size_t>(first - m_data_ptr);
+                            grow(m_count + n);
+                            first = m_data_ptr + offset;
+                        }
+                        else
+                        {
+                            grow(m_count + n);
+                        }
+                    }
+                    else
+                    {
+                        grow(m_count + n);
+                    }
+                }
+                construct_range(first, n, m_data_ptr + m_count);
+                m_count += n;
+            }
+            else
+            {
+                for (; first != last; ++first)
+                {
+                    emplace_back(*first);
+                }
+            }
+        }
+
+        void append(std::initializer_list<T> items)
+        {
+            append(items.begin(), items.end());
+        }
+
+        /*
+        inserts the items of [first, last) before the item at index pos, pos may be size()
+        forward ranges reallocate at most once and every existing item is moved at most once
+        it raises the bad_alloc exception
+        */
+        template <typename InputIt, typename = std::enable_if_t<is_iterator_v<InputIt>>>
+        void insert(std::size_t pos, InputIt first, InputIt last)
+        {
+            if constexpr (is_forward_iterator_v<InputIt>)
+            {
+                if constexpr (is_item_pointer_v<InputIt>)
+                {
+                    if (first != last && owns(first))
+                    {
+                        // the items of the range move while the gap is opened, insert a copy of them
+                        small_vector items(m_allocator);
+                        items.append(first, last);
+                        insert(pos, std::make_move_iterator(items.m_data_ptr), std::make_move_iterator(items.m_data_ptr + items.m_count));
+                        return;
+                    }
+                }
+                std::size_t n = static_cast<std::size_t>(std::distance(first, last));
+                if (n == 0)
+                {
+                    return;
+                }
+                open_gap(pos, n);
+                construct_range(first, n, m_data_ptr + pos);
+                m_count += n;
+            }
+            else
+            {
+                std::size_t old_count = m_count;
+                append(first, last);
+                std::rotate(m_data_ptr + pos, m_data_ptr + old_count, m_data_ptr + m_count);
+            }
+        }
+
+        void insert(std::size_t pos, std::initializer_list<T> items)
+        {
+            insert(pos, items.begin(), items.end());
+        }
+
+        /*
+        inserts n copies of value before the item at index pos, pos may be size()
+        it reallocates at most once, value may refer to an item of this container
+        it raises the bad_alloc exception
+        */
+        void insert(std::size_t pos, std::size_t n, const T &value)
+        {
+            if (owns(&value))
+            {
+                T value_copy(value);
+                insert(pos, n, value_copy);
+                return;
+            }
+            if (n == 0)
+            {
+                return;
+            }
+            open_gap(pos, n);
+            fill_items(pos, pos + n, value);
+            m_count += n;
+        }
+
+        /*
+        destroys the last item, the container must not be empty
+        */
+        void pop_back() noexcept
+        {
+            --m_count;
+            destroy_items(m_data_ptr + m_count, m_data_ptr + m_count + 1);
+        }
+
+        /*
+        removes the item at index pos, the items after it move one place back
+        */
+        void erase(std::size_t pos)
+        {
+            erase(pos, pos + 1);
+        }
+
+        /*
+        removes the items [first, last) by index, the items after them move last - first places back
+        trivially relocatable items are moved by a single memmove, others are move assigned
+        */
+        void erase(std::size_t first, std::size_t last)
+        {
+            if (first == last)
+            {
+                return;
+            }
+            if constexpr (is_trivially_relocatable_v<T>)
+            {
+                destroy_items(m_data_ptr + first, m_data_ptr + last);
+                close_gap(first, last, m_count);
+            }
+            else
+            {
+                std::move(m_data_ptr + last, m_data_ptr + m_count, m_data_ptr + first);
+                destroy_items(m_count - (last - first));
+            }
+            m_count -= last - first;
+        }
+
+        /*
+        removes the item at index pos in constant time by moving the last item into its place,
+        so the order of the items is not kept
+        */
+        void swap_erase(std::size_t pos)
+        {
+            std::size_t last = m_count - 1;
+            if constexpr (is_trivially_relocatable_v<T>)
+            {
+                destroy_items(m_data_ptr + pos, m_data_ptr + pos + 1);
+                if (pos != last)
+                {
+                    asd::relocate(m_data_ptr + last, 1, m_data_ptr + pos);
+                }
+            }
+            else
+            {
+                if (pos != last)
+                {
+                    m_data_ptr[pos] = std::move(m_data_ptr[last]);
+                }
+                destroy_items(last);
+            }
+            m_count = last;
+        }
+
+        /*
+        removes the items pred is true for in a single pass and keeps the order of the others,
+        pred is called once per item, returns the number of removed items
+        runs of kept trivially relocatable items are moved by memmove, others are move assigned
+        */
+        template <typename Pred>
+        std::size_t erase_if(Pred pred)
+        {
+            std::size_t old_count = m_count;
+            if constexpr (is_trivially_relocatable_v<T>)
+            {
+                std::size_t kept = 0;
+                std::size_t i = 0;
+                try
+                {
+                    while (i < m_count)
+                    {
+                        // [i, run) is a run of kept items, run is removed
+                        std::size_t run = i;
+                        while (run < m_count && !pred(m_data_ptr[run]))
+                        {
+                            ++run;
+                        }
+                        close_gap(kept, i, run);
+                        kept += run - i;
+                        if (run == m_count)
+                        {
+                            break;
+                        }
+                        destroy_items(m_data_ptr + run, m_data_ptr + run + 1);
+                        i = run + 1;
+                    }
+                }
+                catch (...)
+                {
+                    // keep the items pred has not decided about yet
+                    close_gap(kept, i, m_count);
+                    m_count -= i - kept;
+                    throw;
+                }
+                m_count = kept;
+            }
+            else
+            {
+                T *new_end = std::remove_if(m_data_ptr, m_data_ptr + m_count, pred);
+                std::size_t kept = static_cast<std::size_t>(new_end - m_data_ptr);
+                destroy_items(kept);
+                m_count = kept;
+            }
+            return old_count - m_count;
+        }
+
+        /*
+        replaces the items by the items of [first, last)
+        forward ranges allocate at most once and reuse the memory if it is enough
+        it raises the bad_alloc exception
+        */
+        template <typename InputIt, typename = std::enable_if_t<is_iterator_v<InputIt>>>
+        void assign(InputIt first, InputIt last)
+        {
+            if constexpr (is_forward_iterator_v<InputIt>)
+            {
+                if constexpr (is_item_pointer_v<InputIt>)
+                {
+                    if (first != last && owns(first))
+                    {
+                        // the items of the range are destroyed before the new items are copied, assign a copy of them
+                        small_vector items(m_allocator);
+                        items.append(first, last);
+                        assign(std::make_move_iterator(items.m_data_ptr), std::make_move_iterator(items.m_data_ptr + items.m_count));
+                        return;
+                    }
+                }
+                std::size_t n = static_cast<std::size_t>(std::distance(first, last));
+                destroy_items();
+                m_count = 0;
+                if (n > m_capacity)
+                {
+                    deallocate();
+                    reset();
+                    reallocate(n);
+                }
+                construct_range(first, n, m_data_ptr);
+                m_count = n;
+            }
+            else
+            {
+                destroy_items();
+                m_count = 0;
+                append(first, last);
+            }
+        }
+
+        void assign(std::initializer_list<T> items)
+        {
+            assign(items.begin(), items.end());
+        }
+
+        /*
+        replaces the items by n copies of value, it allocates at most once
+        it raises the bad_alloc exception
+        */
+        void assign(std::size_t n, const T &value)
+        {
+            if (owns(&value))
+            {
+                T value_copy(value);
+                assign(n, value_copy);
+                return;
+            }
+            destroy_items();
+            m_count = 0;
+            if (n > m_capacity)
+            {
+                deallocate();
+                reset();
+                reallocate(n);
+            }
+            fill_items(0, n, value);
+            m_count = n;
+        }
+
+        /*
+        makes the capacity at least n items in a single reallocation
+        it does nothing if the capacity is already enough
+        it raises the bad_alloc exception
+        */
+        void reserve(std::size_t n)
+        {
+            if (n > m_capacity)
+            {
+                reallocate(n);
+            }
+        }
+
+        /*
+        changes the number of items to n
+        extra items are destroyed, new items are value initialized
+        it raises the bad_alloc exception
+        */
+        void resize(std::size_t n)
+        {
+            if (n > m_capacity)
+            {
+                grow(n);
+            }
+            for (std::size_t i = m_count; i < n; i++)
+            {
+                construct(m_data_ptr + i);
+            }
+            if (n < m_count)
+            {
+                destroy_items(n);
+            }
+            m_count = n;
+        }
+
+        /*
+        changes the number of items to n
+        extra items are destroyed, new items are copies of value
+        it raises the bad_alloc exception
+        */
+        void resize(std::size_t n, const T &value)
+        {
+            if (n > m_capacity)
+            {
+                // value may refer to an item of this container, keep a copy while reallocating
+                T value_copy(value);
+                grow(n);
+                fill_items(m_count, n, value_copy);
+                m_count = n;
+                return;
+            }
+            if (n > m_count)
+            {
+                fill_items(m_count, n, value);
+            }
+            else
+            {
+                destroy_items(n);
+            }
+            m_count = n;
+        }
+
+        /*
+        changes the number of items to n, new items are left uninitialized (default initialized)
+        so a buffer filled by read() or memcpy right after doesn't pay for zeroing it first
+        only for trivially default constructible and trivially destructible items
+        it raises the bad_alloc exception
+        */
+        void resize_uninitialized(std::size_t n)
+        {
+            static_assert(std::is_trivially_default_constructible_v<T> && std::is_trivially_destructible_v<T>,
+                          "resize_uninitialized needs trivially default constructible and destructible items");
+            if (n > m_capacity)
+            {
+                grow(n);
+            }
+            m_count = n;
+        }
+
+        /*
+        changes the number of items to n, extra items are destroyed and the new items [size(), n)
+        are constructed by init(first, count) in the uninitialized memory at first, not through the allocator,
+        if init throws it must leave none of them constructed
+        it raises the bad_alloc exception
+        */
+        template <typename Init>
+        void resize_with(std::size_t n, Init &&init)
+        {
+            if (n <= m_count)
+            {
+                destroy_items(n);
+                m_count = n;
+                return;
+            }
+            if (n > m_capacity)
+            {
+                grow(n);
+            }
+            init(m_data_ptr + m_count, n - m_count);
+            m_count = n;
+        }
+
+        /*
+        same as resize_uninitialized(n)
+        */
+        void resize(std::size_t n, default_init_t)
+        {
+            resize_uninitialized(n);
+        }
+
+        /*
+        releases the unused heap capacity, the items go back to the inline buffer if they fit in it
+        it raises the bad_alloc exception
+        */
+        void shrink_to_fit()
+        {
+            if (!is_inline() && m_capacity != m_count)
+            {
+                reallocate(m_count);
+            }
+        }
+    };
+}
+#endif //ifndef ASD_SMALL_VECTOR_2023
@@ -0,0 +1,138 @@
+
+#include <iostream>
+#include <string>
+#include <algorithm>
+#include <assert.h>
+#include "small_vector.hpp"
+
+int main()
+{
+    // Test items stay inline up to N
+    asd::small_vector<int, 8> myVec1;
+    for (int i = 0; i < 8; ++i)
+    {
+        myVec1.push_back(i);
+    }
+    assert(myVec1.is_inline() && myVec1.capacity() == 8);
+
+    // Test growth past N spills to the heap
+    for (int i = 8; i < 100; ++i)
+    {
+        myVec1.push_back(i);
+    }
+    assert(!myVec1.is_inline() && myVec1.capacity() >= 100);
+    for (int i = 0; i < 100; ++i)
+    {
+        assert(myVec1[i] == i);
+    }
+    myVec1.resize(4);
+    myVec1.shrink_to_fit();
+    assert(myVec1.is_inline() && myVec1[3] == 3);
+
+    // Test non-trivial items, copy and move while inline and on the heap
+    asd::small_vector<std::string, 4> myVec2;
+    for (int i = 0; i < 3; ++i)
+    {
+        myVec2.emplace_back("small vector string that is too long for sso " + std::to_string(i));
+    }
+    asd::small_vector<std::string, 4> myVec3(myVec2);
+    assert(myVec3.is_inline() && myVec3.size() == 3 && myVec3[2] == myVec2[2]);
+    asd::small_vector<std::string, 4> myVec4(std::move(myVec3));
+    assert(myVec4.is_inline() && myVec4.size() == 3 && myVec3.size() == 0);
+    for (int i = 3; i < 20; ++i)
+    {
+        myVec4.emplace_back(std::to_string(i));
+    }
+    asd::small_vector<std::string, 4> myVec5(myVec4);
+    assert(!myVec5.is_inline() && myVec5.size() == 20 && myVec5[19] == "19");
+    myVec3 = std::move(myVec5);
+    assert(myVec3.size() == 20 && myVec5.size() == 0 && myVec5.is_inline());
+    myVec5 = myVec2;
+    assert(myVec5.size() == 3 && myVec5[0] == myVec2[0]);
+    myVec2 = myVec3;
+    assert(myVec2.size() == 20 && myVec2[19] == "19");
+
+    // Test conversion to asd::vector hands over heap memory
+    const std::string *heapItems = &myVec3[0];
+    asd::vector<std::string> myVec6 = std::move(myVec3);
+    assert(myVec6.size() == 20 && &myVec6[0] == heapItems && myVec3.size() == 0);
+
+    // Test conversion from asd::vector takes its memory
+    asd::small_vector<std::string, 4> myVec7(std::move(myVec6));
+    assert(myVec7.size() == 20 && &myVec7[0] == heapItems && myVec6.size() == 0);
+
+    // Test conversion of inline items
+    asd::vector<std::string> myVec8 = std::move(myVec5);
+    assert(myVec8.size() == 3 && myVec8.capacity() == 3);
+    asd::small_vector<std::string, 4> myVec9(std::move(myVec8));
+    assert(myVec9.is_inline() && myVec9.size() == 3 && myVec9[0] == myVec2[0]);
+
+    // Test contiguous iterators
+    assert(std::count(myVec9.begin(), myVec9.end(), myVec2[0]) == 1);
+    assert(myVec9.front() == myVec2[0] && myVec9.back() == myVec2[2] && myVec9.data() == &myVec9[0]);
+
+    // Test uninitialized resize stays inline until N
+    asd::small_vector<char, 16> myVec10;
+    myVec10.resize_uninitialized(16);
+    assert(myVec10.is_inline() && myVec10.size() == 16);
+    myVec10[15] = 'x';
+    myVec10.resize(100, asd::default_init);
+    assert(!myVec10.is_inline() && myVec10.size() == 100 && myVec10[15] == 'x');
+
+    // Test push_back and emplace_back of an own item when the inline buffer or the heap buffer is full
+    asd::small_vector<std::string, 4> myVec11;
+    for (int i = 0; i < 4; ++i)
+    {
+        myVec11.push_back(std::string(50, static_cast<char>('a' + i)));
+    }
+    assert(myVec11.is_inline() && myVec11.size() == myVec11.capacity());
+    myVec11.push_back(myVec11[0]);
+    assert(!myVec11.is_inline() && myVec11[4] == std::string(50, 'a'));
+    while (myVec11.size() != myVec11.capacity())
+    {
+        myVec11.push_back(myVec11[1]);
+    }
+    myVec11.emplace_back(myVec11[3], 0, 20);
+    assert(myVec11.back() == std::string(20, 'd') && myVec11[myVec11.size() - 2] == std::string(50, 'b'));
+
+    // Test the asd::vector editing API inline and on the heap
+    asd::small_vector<std::string, 4> myVec12;
+    myVec12.append({"b", "d"});
+    myVec12.insert(1, 1, std::string("c"));
+    myVec12.insert(0, {"a"});
+    assert(myVec12.is_inline() && myVec12.size() == 4 && myVec12[0] == "a" && myVec12[3] == "d");
+    myVec12.insert(2, myVec12.begin(), myVec12.end());
+    assert(!myVec12.is_inline() && myVec12.size() == 8 && myVec12[2] == "a" && myVec12[5] == "d" && myVec12[7] == "d");
+    myVec12.erase(2, 6);
+    myVec12.swap_erase(0);
+    assert(myVec12.size() == 3 && myVec12[0] == "d" && myVec12[2] == "c");
+    assert(myVec12.erase_if([](const std::string &item) { return item == "c"; }) == 1 && myVec12.size() == 2);
+    myVec12.pop_back();
+    assert(myVec12.size() == 1 && myVec12[0] == "d");
+    myVec12.assign(6, myVec12[0]);
+    assert(myVec12.size() == 6 && myVec12[5] == "d");
+    myVec12.assign({"x", "y"});
+    asd::small_vector<std::string, 4> myVec13;
+    myVec13.assign(10, "z");
+    myVec12.swap(myVec13);
+    assert(myVec12.size() == 10 && myVec12[9] == "z" && myVec13.size() == 2 && myVec13[1] == "y");
+    myVec13.shrink_to_fit();
+    myVec12.erase(1, 10);
+    myVec12.shrink_to_fit();
+    assert(myVec12.is_inline() && myVec13.is_inline());
+    myVec12.swap(myVec13);
+    assert(myVec12.size() == 2 && myVec12[0] == "x" && myVec13.size() == 1 && myVec13[0] == "z");
+    asd::small_vector<int, 8> myVec14;
+    myVec14.append(myVec1.begin(), myVec1.end());
+    myVec14.resize_with(6, [](int *first, std::size_t count) { std::fill(first, first + count, 7); });
+    myVec14.insert(0, 2, myVec14[5]);
+    assert(myVec14.size() == 8 && myVec14[0] == 7 && myVec14[2] == 0 && myVec14.slack_bytes() == 0);
+    assert(myVec14.memory_usage() == sizeof(myVec14) && myVec14.erase_if([](int item) { return item == 7; }) == 4);
+    myVec14.append({1, 2, 3, 4, 5});
+    assert(!myVec14.is_inline() && myVec14.memory_usage() >= sizeof(myVec14) + myVec14.capacity() * sizeof(int));
+    assert(myVec14.slack_bytes() >= (myVec14.capacity() - myVec14.size()) * sizeof(int));
+
+    std::cout << "small_vector examples done" << std::endl;
+
+    return 0;
+}
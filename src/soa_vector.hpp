@@ -0,0 +1,449 @@
+/*
+ * Copyright (C) 2023 Sofyan Gaber <sofyanhalaby@gmail.com>
+ *
+ * This code is for demonstration and educational purposes. It
+ * implements a structure of arrays vector class.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ASD_SOA_VECTOR_2023
+#define ASD_SOA_VECTOR_2023
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "vector.hpp"
+
+namespace asd
+{
+    /*
+    the contiguous items of one column of asd::soa_vector, it has data() and size()
+    so it can be given to the asd::simd kernels and to std algorithms
+    */
+    template <typename T>
+    class soa_column
+    {
+        T *m_data_ptr;
+        std::size_t m_count;
+
+    public:
+        using value_type = std::remove_const_t<T>;
+        using iterator = T *;
+
+        soa_column(T *data_ptr, std::size_t count) noexcept
+            : m_data_ptr(data_ptr), m_count(count)
+        {
+        }
+
+        T *data() const noexcept
+        {
+            return m_data_ptr;
+        }
+
+        std::size_t size() const noexcept
+        {
+            return m_count;
+        }
+
+        bool empty() const noexcept
+        {
+            return m_count == 0;
+        }
+
+        T &operator[](std::size_t i) const noexcept
+        {
+            return m_data_ptr[i];
+        }
+
+        T *begin() const noexcept
+        {
+            return m_data_ptr;
+        }
+
+        T *end() const noexcept
+        {
+            return m_data_ptr + m_count;
+        }
+    };
+
+    /*
+    class asd::soa_vector<Ts...> stores rows of Ts... as one array per column, all sharing size and capacity,
+    a scan over one field reads only that field's cache lines
+    the columns are carved out of a single allocation, each starting on a 64 bytes boundary
+    (or the largest alignof(Ts)), column<I>() gives the contiguous items of column I
+    push_back / emplace_back scatter a row to the columns, operator[] gathers it as a tuple of references
+    */
+    template <typename... Ts>
+    class soa_vector
+    {
+        static_assert(sizeof...(Ts) > 0, "soa_vector needs at least one column");
+
+    public:
+        static constexpr std::size_t alignment = std::max({std::size_t(64), alignof(Ts)...});
+
+    private:
+        using block_allocator = aligned_allocator<unsigned char, alignment>;
+        using columns_type = std::tuple<Ts *...>;
+        using indices = std::index_sequence_for<Ts...>;
+        static constexpr std::size_t row_size = (sizeof(Ts) + ...);
+
+        template <std::size_t I>
+        using column_type = std::tuple_element_t<I, std::tuple<Ts...>>;
+
+        unsigned char *m_block;
+        std::size_t m_block_bytes;
+        std::size_t m_capacity;
+        std::size_t m_count;
+        columns_type m_columns;
+
+        static constexpr std::size_t round_up(std::size_t bytes) noexcept
+        {
+            return (bytes + alignment - 1) / alignment * alignment;
+        }
+
+        static constexpr std::size_t block_bytes(std::size_t capacity) noexcept
+        {
+            return (round_up(sizeof(Ts) * capacity) + ...);
+        }
+
+        /*
+        the columns of a block holding capacity rows, each column follows the previous one
+        */
+        static columns_type columns_of(unsigned char *block, std::size_t capacity) noexcept
+        {
+            columns_type columns;
+            std::size_t offset = 0;
+            std::apply([&](auto *&...column) {
+                ((column = reinterpret_cast<std::remove_reference_t<decltype(column)>>(block + offset),
+                  offset += round_up(sizeof(*column) * capacity)),
+                 ...);
+            },
+                       columns);
+            return columns;
+        }
+
+        template <typename... Args, std::size_t... I>
+        static void construct_row(const columns_type &columns, std::size_t i, std::index_sequence<I...>, Args &&...args)
+        {
+            std::size_t constructed = 0;
+            try
+            {
+                ((::new (static_cast<void *>(std::get<I>(columns) + i)) Ts(std::forward<Args>(args)), ++constructed), ...);
+            }
+            catch (...)
+            {
+                // undo the columns already constructed for this row
+                ((I < constructed ? std::destroy_at(std::get<I>(columns) + i) : void()), ...);
+                throw;
+            }
+        }
+
+        template <std::size_t... I>
+        void relocate_columns(const columns_type &to, std::index_sequence<I...>)
+        {
+            (asd::relocate(std::get<I>(m_columns), m_count, std::get<I>(to)), ...);
+        }
+
+        template <std::size_t... I>
+        void destroy_rows(std::size_t first, std::index_sequence<I...>) noexcept
+        {
+            (std::destroy(std::get<I>(m_columns) + first, std::get<I>(m_columns) + m_count), ...);
+        }
+
+        void destroy_rows(std::size_t first) noexcept
+        {
+            if constexpr (!(std::is_trivially_destructible_v<Ts> && ...))
+            {
+                destroy_rows(first, indices{});
+            }
+            m_count = first;
+        }
+
+        void release() noexcept
+        {
+            if (m_block != nullptr)
+            {
+                block_allocator().deallocate(m_block, m_block_bytes);
+            }
+            m_block = nullptr;
+            m_block_bytes = 0;
+            m_capacity = 0;
+            m_columns = columns_type();
+        }
+
+        void adopt_block(unsigned char *block, std::size_t bytes, std::size_t capacity, const columns_type &columns) noexcept
+        {
+            release();
+            m_block = block;
+            m_block_bytes = bytes;
+            m_capacity = capacity;
+            m_columns = columns;
+        }
+
+        /*
+        moves every column to a new block in one allocation
+        */
+        void reallocate(std::size_t new_capacity)
+        {
+            std::size_t bytes = block_bytes(new_capacity);
+            unsigned char *block = bytes == 0 ? nullptr : block_allocator().allocate(bytes);
+            columns_type columns = columns_of(block, new_capacity);
+            relocate_columns(columns, indices{});
+            adopt_block(block, bytes, new_capacity, columns);
+        }
+
+        template <std::size_t... I>
+        void append_row_of(const soa_vector &other, std::size_t i, std::index_sequence<I...>)
+        {
+            emplace_back(std::get<I>(other.m_columns)[i]...);
+        }
+
+        template <typename Tuple, std::size_t... I>
+        static auto row_of(const columns_type &columns, std::size_t i, std::index_sequence<I...>) noexcept
+        {
+            return Tuple(std::get<I>(columns)[i]...);
+        }
+
+    public:
+        using value_type = std::tuple<Ts...>;
+        using reference = std::tuple<Ts &...>;
+        using const_reference = std::tuple<const Ts &...>;
+
+        soa_vector() noexcept
+            : m_block(nullptr), m_block_bytes(0), m_capacity(0), m_count(0), m_columns()
+        {
+        }
+
+        soa_vector(const soa_vector &other)
+            : soa_vector()
+        {
+            reserve(other.m_count);
+            try
+            {
+                for (std::size_t i = 0; i < other.m_count; ++i)
+                {
+                    append_row_of(other, i, indices{});
+                }
+            }
+            catch (...)
+            {
+                destroy_rows(0);
+                release();
+                throw;
+            }
+        }
+
+        soa_vector(soa_vector &&other) noexcept
+            : m_block(other.m_block), m_block_bytes(other.m_block_bytes), m_capacity(other.m_capacity),
+              m_count(other.m_count), m_columns(other.m_columns)
+        {
+            other.m_block = nullptr;
+            other.m_block_bytes = 0;
+            other.m_capacity = 0;
+            other.m_count = 0;
+            other.m_columns = columns_type();
+        }
+
+        soa_vector &operator=(const soa_vector &other)
+        {
+            if (this != &other)
+            {
+                soa_vector copy(other);
+                swap(copy);
+            }
+            return *this;
+        }
+
+        soa_vector &operator=(soa_vector &&other) noexcept
+        {
+            if (this != &other)
+            {
+                soa_vector moved(std::move(other));
+                swap(moved);
+            }
+            return *this;
+        }
+
+        ~soa_vector()
+        {
+            destroy_rows(0);
+            release();
+        }
+
+        void swap(soa_vector &other) noexcept
+        {
+            std::swap(m_block, other.m_block);
+            std::swap(m_block_bytes, other.m_block_bytes);
+            std::swap(m_capacity, other.m_capacity);
+            std::swap(m_count, other.m_count);
+            std::swap(m_columns, other.m_columns);
+        }
+
+        /*
+        adds a row, column I is constructed from args I, one argument per column
+        the arguments may refer to rows of this container
+        */
+        template <typename... Args>
+        void emplace_back(Args &&...args)
+        {
+            static_assert(sizeof...(Args) == sizeof...(Ts), "emplace_back takes one argument per column");
+            if (m_count < m_capacity)
+            {
+                construct_row(m_columns, m_count, indices{}, std::forward<Args>(args)...);
+                ++m_count;
+                return;
+            }
+            // the new row is constructed before the old rows move, so args stay valid
+            std::size_t new_capacity = growth::doubling::next_capacity(m_capacity, m_count + 1, row_size);
+            std::size_t bytes = block_bytes(new_capacity);
+            unsigned char *block = block_allocator().allocate(bytes);
+            columns_type columns = columns_of(block, new_capacity);
+            try
+            {
+                construct_row(columns, m_count, indices{}, std::forward<Args>(args)...);
+            }
+            catch (...)
+            {
+                block_allocator().deallocate(block, bytes);
+                throw;
+            }
+            relocate_columns(columns, indices{});
+            adopt_block(block, bytes, new_capacity, columns);
+            ++m_count;
+        }
+
+        void push_back(const std::tuple<Ts...> &row)
+        {
+            std::apply([this](const Ts &...items) { emplace_back(items...); }, row);
+        }
+
+        void push_back(std::tuple<Ts...> &&row)
+        {
+            std::apply([this](Ts &...items) { emplace_back(std::move(items)...); }, row);
+        }
+
+        void pop_back() noexcept
+        {
+            destroy_rows(m_count - 1);
+        }
+
+        void clear() noexcept
+        {
+            destroy_rows(0);
+        }
+
+        /*
+        changes the number of rows to n, new rows are value initialized
+        */
+        void resize(std::size_t n)
+        {
+            if (n > m_capacity)
+            {
+                reallocate(growth::doubling::next_capacity(m_capacity, n, row_size));
+            }
+            while (m_count < n)
+            {
+                emplace_back(Ts()...);
+            }
+            destroy_rows(n < m_count ? n : m_count);
+        }
+
+        /*
+        makes the capacity of every column at least n rows in a single allocation
+        */
+        void reserve(std::size_t n)
+        {
+            if (n > m_capacity)
+            {
+                reallocate(n);
+            }
+        }
+
+        void shrink_to_fit()
+        {
+            if (m_capacity > m_count)
+            {
+                reallocate(m_count);
+            }
+        }
+
+        std::size_t size() const noexcept
+        {
+            return m_count;
+        }
+
+        std::size_t capacity() const noexcept
+        {
+            return m_capacity;
+        }
+
+        bool empty() const noexcept
+        {
+            return m_count == 0;
+        }
+
+        /*
+        the items of column I, aligned to alignment bytes
+        */
+        template <std::size_t I>
+        soa_column<column_type<I>> column() noexcept
+        {
+            return soa_column<column_type<I>>(asd::assume_aligned<alignment>(std::get<I>(m_columns)), m_count);
+        }
+
+        template <std::size_t I>
+        soa_column<const column_type<I>> column() const noexcept
+        {
+            return soa_column<const column_type<I>>(asd::assume_aligned<alignment>(std::get<I>(m_columns)), m_count);
+        }
+
+        /*
+        the item of column I in row i
+        */
+        template <std::size_t I>
+        column_type<I> &get(std::size_t i) noexcept
+        {
+            return std::get<I>(m_columns)[i];
+        }
+
+        template <std::size_t I>
+        const column_type<I> &get(std::size_t i) const noexcept
+        {
+            return std::get<I>(m_columns)[i];
+        }
+
+        /*
+        row i as a tuple of references to its items
+        */
+        reference operator[](std::size_t i) noexcept
+        {
+            return row_of<reference>(m_columns, i, indices{});
+        }
+
+        const_reference operator[](std::size_t i) const noexcept
+        {
+            return row_of<const_reference>(m_columns, i, indices{});
+        }
+    };
+}
+#endif //ifndef ASD_SOA_VECTOR_2023
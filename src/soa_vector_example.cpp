@@ -0,0 +1,95 @@
+
+#include <iostream>
+#include <string>
+#include <cstdint>
+#include <numeric>
+#include <algorithm>
+#include <stdexcept>
+#include <tuple>
+#include <assert.h>
+#include "soa_vector.hpp"
+#include "simd.hpp"
+
+struct fragile
+{
+    int value;
+
+    fragile(int v)
+        : value(v)
+    {
+        if (v < 0)
+        {
+            throw std::invalid_argument("negative");
+        }
+    }
+};
+
+int main()
+{
+    // Test rows scatter to aligned columns
+    enum { x, y, mass, id };
+    asd::soa_vector<float, float, double, std::int32_t> particles;
+    for (int i = 0; i < 1000; ++i)
+    {
+        particles.emplace_back(static_cast<float>(i), static_cast<float>(-i), i * 0.5, i);
+    }
+    particles.push_back(std::make_tuple(1.0f, 2.0f, 3.0, 4));
+    assert(particles.size() == 1001 && particles.capacity() >= 1001);
+    assert(reinterpret_cast<std::uintptr_t>(particles.column<x>().data()) % 64 == 0);
+    assert(reinterpret_cast<std::uintptr_t>(particles.column<mass>().data()) % 64 == 0);
+    assert(reinterpret_cast<std::uintptr_t>(particles.column<id>().data()) % 64 == 0);
+    assert(particles.get<id>(999) == 999 && particles.get<mass>(1000) == 3.0);
+    auto [px, py, pm, pid] = particles[10];
+    assert(px == 10.0f && py == -10.0f && pm == 5.0 && pid == 10);
+    std::get<x>(particles[10]) = 42.0f;
+    assert(particles.get<x>(10) == 42.0f);
+
+    // Test columns compose with the simd kernels and std algorithms
+    asd::soa_column<const std::int32_t> ids = std::as_const(particles).column<id>();
+    assert(asd::simd::sum(ids) == 999 * 1000 / 2 + 4);
+    assert(asd::simd::max(particles.column<mass>()) == 999 * 0.5);
+    auto masses = particles.column<mass>();
+    assert(std::count_if(masses.begin(), masses.end(), [](double m) { return m > 100.0; }) == 799);
+
+    // Test rows referring to the container itself
+    asd::soa_vector<std::string, int> names;
+    names.emplace_back(std::string("soa string that is long enough to go to heap"), 1);
+    for (int i = 0; i < 100; ++i)
+    {
+        names.emplace_back(names.get<0>(0), names.get<1>(i) + 1);
+    }
+    assert(names.size() == 101 && names.get<0>(100) == names.get<0>(0) && names.get<1>(100) == 101);
+
+    // Test copy, move, resize and shrinking
+    asd::soa_vector<std::string, int> names2(names);
+    assert(names2.size() == 101 && names2.get<0>(50) == names.get<0>(50));
+    asd::soa_vector<std::string, int> names3(std::move(names2));
+    assert(names3.size() == 101 && names2.empty());
+    names3.resize(10);
+    names3.shrink_to_fit();
+    assert(names3.capacity() == 10 && names3.get<1>(9) == 10);
+    names3.resize(12);
+    assert(names3.get<0>(11).empty() && names3.get<1>(11) == 0);
+    names2 = names3;
+    names3.pop_back();
+    names3.clear();
+    assert(names2.size() == 12 && names3.empty());
+
+    // Test a throwing column leaves the container as it was
+    asd::soa_vector<std::string, fragile> rows;
+    rows.emplace_back(std::string("a"), 1);
+    bool thrown = false;
+    try
+    {
+        rows.emplace_back(std::string("b"), -1);
+    }
+    catch (const std::invalid_argument &)
+    {
+        thrown = true;
+    }
+    assert(thrown && rows.size() == 1 && rows.get<0>(0) == "a");
+
+    std::cout << "soa_vector examples done" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,665 @@
+/*
+ * Copyright (C) 2023 Sofyan Gaber <sofyanhalaby@gmail.com>
+ *
+ * This code is for demonstration and educational purposes. It
+ * implements a fixed capacity vector class.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ASD_STATIC_VECTOR_2023
+#define ASD_STATIC_VECTOR_2023
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "vector.hpp"
+
+/*
+C++20 can construct and destroy items in constant expressions, so static_vector is constexpr from C++20 on
+*/
+#if __cplusplus >= 202002L && defined(__cpp_lib_constexpr_dynamic_alloc)
+#define ASD_STATIC_VECTOR_CONSTEXPR 1
+#define ASD_CONSTEXPR20 constexpr
+#else
+#define ASD_STATIC_VECTOR_CONSTEXPR 0
+#define ASD_CONSTEXPR20
+#endif
+
+namespace asd
+{
+    /*
+    overflow policies of asd::static_vector, fit(requested, available) returns how many of the
+    requested items are added when only available items fit
+    */
+    namespace overflow
+    {
+        /*
+        overflow is a bug of the caller, it is checked by assert in debug builds and not at all otherwise
+        */
+        struct assertion
+        {
+            static constexpr std::size_t fit(std::size_t requested, std::size_t available) noexcept
+            {
+                assert(requested <= available && "static_vector capacity exceeded");
+                (void)available;
+                return requested;
+            }
+        };
+
+        /*
+        overflow raises the length_error exception, none of the items of that call are added
+        */
+        struct exception
+        {
+            static constexpr std::size_t fit(std::size_t requested, std::size_t available)
+            {
+                if (requested > available)
+                {
+                    throw std::length_error("static_vector capacity exceeded");
+                }
+                return requested;
+            }
+        };
+
+        /*
+        the items that don't fit are dropped
+        */
+        struct truncate
+        {
+            static constexpr std::size_t fit(std::size_t requested, std::size_t available) noexcept
+            {
+                return requested < available ? requested : available;
+            }
+        };
+    }
+
+    namespace detail
+    {
+        // the smallest unsigned type that counts up to N
+        template <std::size_t N>
+        using static_size_t = std::conditional_t<N <= UINT8_MAX, std::uint8_t,
+                                                 std::conditional_t<N <= UINT16_MAX, std::uint16_t,
+                                                                    std::conditional_t<N <= UINT32_MAX, std::uint32_t, std::size_t>>>;
+
+        template <typename T, typename... Args>
+        ASD_CONSTEXPR20 void construct_item(T *ptr, Args &&...args)
+        {
+#if ASD_STATIC_VECTOR_CONSTEXPR
+            std::construct_at(ptr, std::forward<Args>(args)...);
+#else
+            ::new (static_cast<void *>(ptr)) T(std::forward<Args>(args)...);
+#endif
+        }
+
+        template <typename T>
+        ASD_CONSTEXPR20 void destroy_items(T *first, T *last) noexcept
+        {
+            if constexpr (!std::is_trivially_destructible_v<T>)
+            {
+                for (; first != last; ++first)
+                {
+                    std::destroy_at(first);
+                }
+            }
+        }
+
+        /*
+        a constexpr variable needs all its items initialized, so the constant evaluation value initializes
+        the unused items of literal types too, at run time they stay uninitialized
+        */
+        template <typename T, std::size_t N>
+        constexpr void constant_init(T (&items)[N]) noexcept
+        {
+#if ASD_STATIC_VECTOR_CONSTEXPR
+            if constexpr (std::is_nothrow_default_constructible_v<T> && std::is_trivially_destructible_v<T>)
+            {
+                if (std::is_constant_evaluated())
+                {
+                    for (std::size_t i = 0; i < N; ++i)
+                    {
+                        std::construct_at(items + i);
+                    }
+                }
+            }
+#else
+            (void)items;
+#endif
+        }
+
+        /*
+        the inline items of asd::static_vector, a union keeps them uninitialized until they are constructed
+        trivially copyable items keep the implicit copy, move and destructor, so the whole vector
+        stays trivially copyable, the other items are copied and destroyed one by one
+        */
+        template <typename T, std::size_t N, bool = std::is_trivially_copyable_v<T>>
+        struct static_storage
+        {
+            union
+            {
+                char m_unused;
+                T m_items[N];
+            };
+            static_size_t<N> m_count;
+
+            constexpr static_storage() noexcept
+                : m_unused(), m_count(0)
+            {
+                constant_init(m_items);
+            }
+        };
+
+        template <typename T, std::size_t N>
+        struct static_storage<T, N, false>
+        {
+            union
+            {
+                char m_unused;
+                T m_items[N];
+            };
+            static_size_t<N> m_count;
+
+            constexpr static_storage() noexcept
+                : m_unused(), m_count(0)
+            {
+                constant_init(m_items);
+            }
+
+            ASD_CONSTEXPR20 static_storage(const static_storage &other)
+                : m_unused(), m_count(0)
+            {
+                constant_init(m_items);
+                for (; m_count < other.m_count; ++m_count)
+                {
+                    construct_item(m_items + m_count, other.m_items[m_count]);
+                }
+            }
+
+            ASD_CONSTEXPR20 static_storage(static_storage &&other) noexcept(std::is_nothrow_move_constructible_v<T>)
+                : m_unused(), m_count(0)
+            {
+                constant_init(m_items);
+                for (; m_count < other.m_count; ++m_count)
+                {
+                    construct_item(m_items + m_count, std::move(other.m_items[m_count]));
+                }
+            }
+
+            ASD_CONSTEXPR20 static_storage &operator=(const static_storage &other)
+            {
+                if (this != &other)
+                {
+                    assign(other.m_items, other.m_count, [](const T &item) -> const T & { return item; });
+                }
+                return *this;
+            }
+
+            ASD_CONSTEXPR20 static_storage &operator=(static_storage &&other) noexcept(std::is_nothrow_move_assignable_v<T> &&
+                                                                                          std::is_nothrow_move_constructible_v<T>)
+            {
+                if (this != &other)
+                {
+                    assign(other.m_items, other.m_count, [](T &item) -> T && { return std::move(item); });
+                }
+                return *this;
+            }
+
+            ASD_CONSTEXPR20 ~static_storage()
+            {
+                destroy_items(m_items, m_items + m_count);
+            }
+
+        private:
+            /*
+            assigns the common items, then constructs the extra items or destroys the surplus ones
+            */
+            template <typename U, typename Get>
+            ASD_CONSTEXPR20 void assign(U *items, std::size_t count, Get get)
+            {
+                std::size_t common = count < m_count ? count : m_count;
+                for (std::size_t i = 0; i < common; ++i)
+                {
+                    m_items[i] = get(items[i]);
+                }
+                if (count < m_count)
+                {
+                    destroy_items(m_items + count, m_items + m_count);
+                    m_count = static_cast<static_size_t<N>>(count);
+                }
+                for (; m_count < count; ++m_count)
+                {
+                    construct_item(m_items + m_count, get(items[m_count]));
+                }
+            }
+        };
+    }
+
+    /*
+    class asd::static_vector<T, N, Overflow> provides the asd::vector interface over N inline items and never
+    allocates, so it fits bounded buffers such as packet headers or per core scratch space on the stack
+    the items are left unconstructed until they are added, there is no pointer, only the items and a count
+    of the smallest type that holds N, and it is trivially copyable when T is
+    the Overflow policy of asd::overflow decides what happens to the items that don't fit
+    all members are constexpr from C++20 on, so a lookup table can be built at compile time
+    */
+    template <typename T, std::size_t N, typename Overflow = overflow::assertion>
+    class static_vector
+    {
+        static_assert(N > 0, "static_vector needs room for at least one item");
+
+        detail::static_storage<T, N> m_storage;
+
+        ASD_CONSTEXPR20 T *items() noexcept
+        {
+            return m_storage.m_items;
+        }
+
+        ASD_CONSTEXPR20 const T *items() const noexcept
+        {
+            return m_storage.m_items;
+        }
+
+        ASD_CONSTEXPR20 void set_count(std::size_t n) noexcept
+        {
+            m_storage.m_count = static_cast<detail::static_size_t<N>>(n);
+        }
+
+        /*
+        appends up to n items of a forward range, it returns how many were appended
+        */
+        template <typename ForwardIt>
+        ASD_CONSTEXPR20 std::size_t append_n(ForwardIt first, std::size_t n)
+        {
+            n = Overflow::fit(n, N - size());
+            for (std::size_t i = 0; i < n; ++i, ++first)
+            {
+                detail::construct_item(items() + size(), *first);
+                set_count(size() + 1);
+            }
+            return n;
+        }
+
+    public:
+        using value_type = T;
+        using size_type = std::size_t;
+        using iterator = T *;
+        using const_iterator = const T *;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+        using overflow_policy = Overflow;
+
+        constexpr static_vector() noexcept = default;
+
+        /*
+        adds item at the end
+        */
+        template <typename U>
+        ASD_CONSTEXPR20 void push_back(U &&item)
+        {
+            emplace_back(std::forward<U>(item));
+        }
+
+        template <typename... Args>
+        ASD_CONSTEXPR20 void emplace_back(Args &&...args)
+        {
+            if (Overflow::fit(1, N - size()) == 1)
+            {
+                detail::construct_item(items() + size(), std::forward<Args>(args)...);
+                set_count(size() + 1);
+            }
+        }
+
+        ASD_CONSTEXPR20 void pop_back() noexcept
+        {
+            set_count(size() - 1);
+            std::destroy_at(items() + size());
+        }
+
+        constexpr std::size_t size() const noexcept
+        {
+            return m_storage.m_count;
+        }
+
+        static constexpr std::size_t capacity() noexcept
+        {
+            return N;
+        }
+
+        static constexpr std::size_t max_size() noexcept
+        {
+            return N;
+        }
+
+        constexpr bool empty() const noexcept
+        {
+            return m_storage.m_count == 0;
+        }
+
+        constexpr bool full() const noexcept
+        {
+            return m_storage.m_count == N;
+        }
+
+        ASD_CONSTEXPR20 T *data() noexcept
+        {
+            return items();
+        }
+
+        ASD_CONSTEXPR20 const T *data() const noexcept
+        {
+            return items();
+        }
+
+        ASD_CONSTEXPR20 T &operator[](std::size_t i) noexcept
+        {
+            return items()[i];
+        }
+
+        ASD_CONSTEXPR20 const T &operator[](std::size_t i) const noexcept
+        {
+            return items()[i];
+        }
+
+        ASD_CONSTEXPR20 T &front() noexcept
+        {
+            return items()[0];
+        }
+
+        ASD_CONSTEXPR20 const T &front() const noexcept
+        {
+            return items()[0];
+        }
+
+        ASD_CONSTEXPR20 T &back() noexcept
+        {
+            return items()[size() - 1];
+        }
+
+        ASD_CONSTEXPR20 const T &back() const noexcept
+        {
+            return items()[size() - 1];
+        }
+
+        ASD_CONSTEXPR20 iterator begin() noexcept
+        {
+            return items();
+        }
+
+        ASD_CONSTEXPR20 const_iterator begin() const noexcept
+        {
+            return items();
+        }
+
+        ASD_CONSTEXPR20 iterator end() noexcept
+        {
+            return items() + size();
+        }
+
+        ASD_CONSTEXPR20 const_iterator end() const noexcept
+        {
+            return items() + size();
+        }
+
+        ASD_CONSTEXPR20 const_iterator cbegin() const noexcept
+        {
+            return begin();
+        }
+
+        ASD_CONSTEXPR20 const_iterator cend() const noexcept
+        {
+            return end();
+        }
+
+        ASD_CONSTEXPR20 reverse_iterator rbegin() noexcept
+        {
+            return reverse_iterator(end());
+        }
+
+        ASD_CONSTEXPR20 const_reverse_iterator rbegin() const noexcept
+        {
+            return const_reverse_iterator(end());
+        }
+
+        ASD_CONSTEXPR20 reverse_iterator rend() noexcept
+        {
+            return reverse_iterator(begin());
+        }
+
+        ASD_CONSTEXPR20 const_reverse_iterator rend() const noexcept
+        {
+            return const_reverse_iterator(begin());
+        }
+
+        /*
+        appends the items of [first, last)
+        */
+        template <typename InputIt, typename = std::enable_if_t<is_iterator_v<InputIt>>>
+        ASD_CONSTEXPR20 void append(InputIt first, InputIt last)
+        {
+            if constexpr (is_forward_iterator_v<InputIt>)
+            {
+                append_n(first, static_cast<std::size_t>(std::distance(first, last)));
+            }
+            else
+            {
+                std::size_t old_count = size();
+                try
+                {
+                    for (; first != last && Overflow::fit(1, N - size()) == 1; ++first)
+                    {
+                        detail::construct_item(items() + size(), *first);
+                        set_count(size() + 1);
+                    }
+                }
+                catch (...)
+                {
+                    // the length of an input range is known only at its end, undo the items added before
+                    erase(old_count, size());
+                    throw;
+                }
+            }
+        }
+
+        ASD_CONSTEXPR20 void append(std::initializer_list<T> items)
+        {
+            append(items.begin(), items.end());
+        }
+
+        /*
+        inserts the items of [first, last) before the item at index pos, pos may be size()
+        */
+        template <typename InputIt, typename = std::enable_if_t<is_iterator_v<InputIt>>>
+        ASD_CONSTEXPR20 void insert(std::size_t pos, InputIt first, InputIt last)
+        {
+            std::size_t old_count = size();
+            append(first, last);
+            std::rotate(begin() + pos, begin() + old_count, end());
+        }
+
+        ASD_CONSTEXPR20 void insert(std::size_t pos, std::initializer_list<T> items)
+        {
+            insert(pos, items.begin(), items.end());
+        }
+
+        /*
+        inserts n copies of value before the item at index pos, pos may be size()
+        */
+        ASD_CONSTEXPR20 void insert(std::size_t pos, std::size_t n, const T &value)
+        {
+            T value_copy(value);
+            std::size_t old_count = size();
+            n = Overflow::fit(n, N - size());
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                detail::construct_item(items() + size(), value_copy);
+                set_count(size() + 1);
+            }
+            std::rotate(begin() + pos, begin() + old_count, end());
+        }
+
+        /*
+        removes the item at index pos, the items after it move down by one
+        */
+        ASD_CONSTEXPR20 void erase(std::size_t pos)
+        {
+            erase(pos, pos + 1);
+        }
+
+        /*
+        removes the items [first, last), the items after them move down
+        */
+        ASD_CONSTEXPR20 void erase(std::size_t first, std::size_t last)
+        {
+            if (first == last)
+            {
+                return;
+            }
+            T *tail = std::move(begin() + last, end(), begin() + first);
+            detail::destroy_items(tail, end());
+            set_count(static_cast<std::size_t>(tail - begin()));
+        }
+
+        /*
+        removes the item at index pos by moving the last item into its place, the order is not kept
+        */
+        ASD_CONSTEXPR20 void swap_erase(std::size_t pos)
+        {
+            if (pos + 1 != size())
+            {
+                items()[pos] = std::move(back());
+            }
+            pop_back();
+        }
+
+        /*
+        removes the items that pred returns true for, keeping the order of the others
+        it returns the number of removed items
+        */
+        template <typename Pred>
+        ASD_CONSTEXPR20 std::size_t erase_if(Pred pred)
+        {
+            T *tail = std::remove_if(begin(), end(), pred);
+            std::size_t removed = static_cast<std::size_t>(end() - tail);
+            detail::destroy_items(tail, end());
+            set_count(size() - removed);
+            return removed;
+        }
+
+        template <typename InputIt, typename = std::enable_if_t<is_iterator_v<InputIt>>>
+        ASD_CONSTEXPR20 void assign(InputIt first, InputIt last)
+        {
+            erase(0, size());
+            append(first, last);
+        }
+
+        ASD_CONSTEXPR20 void assign(std::initializer_list<T> items)
+        {
+            assign(items.begin(), items.end());
+        }
+
+        ASD_CONSTEXPR20 void assign(std::size_t n, const T &value)
+        {
+            T value_copy(value);
+            erase(0, size());
+            resize(n, value_copy);
+        }
+
+        /*
+        it only checks n against N, the room is there already
+        */
+        ASD_CONSTEXPR20 void reserve(std::size_t n)
+        {
+            Overflow::fit(n, N);
+        }
+
+        ASD_CONSTEXPR20 void resize(std::size_t n)
+        {
+            if (n <= size())
+            {
+                erase(n, size());
+                return;
+            }
+            n = size() + Overflow::fit(n - size(), N - size());
+            for (; size() < n; set_count(size() + 1))
+            {
+                detail::construct_item(items() + size());
+            }
+        }
+
+        ASD_CONSTEXPR20 void resize(std::size_t n, const T &value)
+        {
+            if (n <= size())
+            {
+                erase(n, size());
+                return;
+            }
+            n = size() + Overflow::fit(n - size(), N - size());
+            for (; size() < n; set_count(size() + 1))
+            {
+                detail::construct_item(items() + size(), value);
+            }
+        }
+
+        /*
+        changes the number of items to n, new items are left uninitialized (default initialized)
+        so a buffer filled by read() or memcpy right after doesn't pay for zeroing it first
+        only for trivially default constructible and trivially destructible items
+        */
+        ASD_CONSTEXPR20 void resize_uninitialized(std::size_t n)
+        {
+            static_assert(std::is_trivially_default_constructible_v<T> && std::is_trivially_destructible_v<T>,
+                          "resize_uninitialized needs trivially default constructible and destructible items");
+            set_count(n <= size() ? n : size() + Overflow::fit(n - size(), N - size()));
+        }
+
+        /*
+        same as resize_uninitialized(n)
+        */
+        ASD_CONSTEXPR20 void resize(std::size_t n, default_init_t)
+        {
+            resize_uninitialized(n);
+        }
+
+        /*
+        the capacity is fixed, it does nothing
+        */
+        constexpr void shrink_to_fit() noexcept
+        {
+        }
+
+        ASD_CONSTEXPR20 void swap(static_vector &other) noexcept(std::is_nothrow_swappable_v<T> && std::is_nothrow_move_constructible_v<T>)
+        {
+            static_vector &shorter = size() < other.size() ? *this : other;
+            static_vector &longer = size() < other.size() ? other : *this;
+            std::size_t common = shorter.size();
+            std::swap_ranges(shorter.begin(), shorter.end(), longer.begin());
+            shorter.append(std::make_move_iterator(longer.begin() + common), std::make_move_iterator(longer.end()));
+            longer.erase(common, longer.size());
+        }
+    };
+}
+
+#endif //ifndef ASD_STATIC_VECTOR_2023
@@ -0,0 +1,160 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <iterator>
+#include <algorithm>
+#include <numeric>
+#include <memory>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <assert.h>
+#include "static_vector.hpp"
+
+#if ASD_STATIC_VECTOR_CONSTEXPR
+// the primes below 100, found at compile time
+constexpr asd::static_vector<int, 32> primes_below_100()
+{
+    asd::static_vector<int, 32> primes;
+    for (int n = 2; n < 100; ++n)
+    {
+        if (std::all_of(primes.begin(), primes.end(), [n](int prime) { return n % prime != 0; }))
+        {
+            primes.push_back(n);
+        }
+    }
+    return primes;
+}
+
+constexpr asd::static_vector<int, 32> primes = primes_below_100();
+static_assert(primes.size() == 25 && primes.front() == 2 && primes.back() == 97);
+
+// items that own memory work in constant expressions too, as long as they are gone at the end
+constexpr std::size_t edited_lengths()
+{
+    asd::static_vector<std::string, 4> myVec;
+    myVec.push_back("abc");
+    myVec.emplace_back(3, 'x');
+    asd::static_vector<std::string, 4> copy = myVec;
+    copy.insert(0, 1, std::string("q"));
+    copy.erase(1);
+    copy.swap(myVec);
+    return myVec.size() + myVec[1].size() + copy.size();
+}
+static_assert(edited_lengths() == 7);
+#endif
+
+int main()
+{
+    // Test the layout, the items are inline and trivially copyable items keep the whole vector trivially copyable
+    static_assert(std::is_trivially_copyable_v<asd::static_vector<int, 8>>);
+    static_assert(!std::is_trivially_copyable_v<asd::static_vector<std::string, 8>>);
+    static_assert(sizeof(asd::static_vector<char, 16>) == 17 && sizeof(asd::static_vector<std::uint32_t, 1000>) == 4004);
+    static_assert(asd::static_vector<int, 8>::capacity() == 8 && asd::static_vector<int, 8>::max_size() == 8);
+    asd::static_vector<int, 8> myVec1;
+    assert(myVec1.empty() && myVec1.size() == 0);
+    for (int i = 0; i < 8; ++i)
+    {
+        myVec1.push_back(i);
+    }
+    assert(myVec1.full() && myVec1.back() == 7 && std::accumulate(myVec1.begin(), myVec1.end(), 0) == 28);
+    asd::static_vector<int, 8> myVec2;
+    std::memcpy(static_cast<void *>(&myVec2), &myVec1, sizeof(myVec1));
+    assert(myVec2.size() == 8 && myVec2[5] == 5 && myVec2.data() != myVec1.data());
+
+    // Test the asd::vector interface against std::vector
+    asd::static_vector<std::string, 16> myVec3;
+    std::vector<std::string> stdVec1;
+    myVec3.assign({"a", "b", "c"});
+    stdVec1.assign({"a", "b", "c"});
+    myVec3.insert(1, {"x", "y"});
+    stdVec1.insert(stdVec1.begin() + 1, {"x", "y"});
+    myVec3.insert(0, 2, myVec3[4]);
+    stdVec1.insert(stdVec1.begin(), 2, std::string(stdVec1[4]));
+    myVec3.append({"d", "e"});
+    stdVec1.insert(stdVec1.end(), {"d", "e"});
+    myVec3.erase(2, 4);
+    stdVec1.erase(stdVec1.begin() + 2, stdVec1.begin() + 4);
+    assert(std::equal(myVec3.begin(), myVec3.end(), stdVec1.begin(), stdVec1.end()));
+    assert(myVec3.erase_if([](const std::string &item) { return item == "c"; }) == 3 && myVec3.size() == 4);
+    myVec3.swap_erase(0);
+    assert(myVec3.size() == 3 && myVec3[0] == "e" && myVec3.back() == "d");
+    myVec3.resize(6, "z");
+    assert(myVec3.size() == 6 && myVec3[5] == "z" && *myVec3.rbegin() == "z");
+    myVec3.resize(2);
+    asd::static_vector<std::string, 16> myVec4(myVec3);
+    myVec4.push_back("w");
+    myVec3 = myVec4;
+    assert(myVec3.size() == 3 && myVec3[2] == "w");
+    myVec4.resize(10, "v");
+    myVec3.swap(myVec4);
+    assert(myVec3.size() == 10 && myVec4.size() == 3 && myVec4[2] == "w" && myVec3[9] == "v");
+    asd::static_vector<std::string, 16> myVec5(std::move(myVec3));
+    assert(myVec5.size() == 10 && myVec5[0] == "e");
+    std::istringstream words("one two three");
+    myVec5.insert(1, std::istream_iterator<std::string>(words), std::istream_iterator<std::string>());
+    assert(myVec5.size() == 13 && myVec5[1] == "one" && myVec5[3] == "three" && myVec5[4] == "b");
+    asd::static_vector<std::unique_ptr<int>, 4> myVec6;
+    myVec6.push_back(std::make_unique<int>(1));
+    myVec6.emplace_back(new int(2));
+    myVec6.erase(0);
+    assert(myVec6.size() == 1 && *myVec6[0] == 2);
+    asd::static_vector<std::uint8_t, 1500> packet;
+    packet.resize(40, asd::default_init);
+    assert(packet.size() == 40);
+
+    // Test the overflow policies
+    asd::static_vector<int, 4, asd::overflow::truncate> myVec7;
+    myVec7.assign({1, 2, 3, 4, 5, 6});
+    myVec7.push_back(7);
+    assert(myVec7.size() == 4 && myVec7.back() == 4);
+    myVec7.erase(0, 2);
+    myVec7.insert(0, {8, 9, 10});
+    assert(myVec7.size() == 4 && myVec7[0] == 8 && myVec7[1] == 9 && myVec7[2] == 3 && myVec7[3] == 4);
+    myVec7.resize(100);
+    assert(myVec7.size() == 4);
+    asd::static_vector<std::string, 4, asd::overflow::exception> myVec8;
+    myVec8.assign({"a", "b", "c"});
+    bool thrown = false;
+    try
+    {
+        myVec8.insert(0, {"x", "y"});
+    }
+    catch (const std::length_error &)
+    {
+        thrown = true;
+    }
+    assert(thrown && myVec8.size() == 3 && myVec8[0] == "a");
+    thrown = false;
+    try
+    {
+        std::istringstream more("d e f");
+        myVec8.insert(0, std::istream_iterator<std::string>(more), std::istream_iterator<std::string>());
+    }
+    catch (const std::length_error &)
+    {
+        thrown = true;
+    }
+    assert(thrown && myVec8.size() == 3 && myVec8[0] == "a" && myVec8[2] == "c");
+    myVec8.push_back("d");
+    thrown = false;
+    try
+    {
+        myVec8.push_back("e");
+    }
+    catch (const std::length_error &)
+    {
+        thrown = true;
+    }
+    assert(thrown && myVec8.full() && myVec8.back() == "d");
+
+#if ASD_STATIC_VECTOR_CONSTEXPR
+    assert(std::find(primes.begin(), primes.end(), 89) != primes.end());
+#endif
+
+    std::cout << "static_vector examples done" << std::endl;
+
+    return 0;
+}
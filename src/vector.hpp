@@ -26,48 +26,249 @@
 #ifndef ASD_VECTOR_2023
 #define ASD_VECTOR_2023
 #include <stdlib.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <exception>
 #include <memory>
 #include <new>
 #include <algorithm>
+#include <type_traits>
+#include <iterator>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <initializer_list>
+#if defined(__GLIBC__) || defined(__ANDROID__)
+#include <malloc.h>
+#elif defined(__APPLE__)
+#include <malloc/malloc.h>
+#endif
+#include "instrumentation.hpp"
+
+/*
+stateless allocators are stored with no_unique_address so they take no space inside the containers
+*/
+#if defined(__has_cpp_attribute) && __has_cpp_attribute(no_unique_address)
+#define ASD_NO_UNIQUE_ADDRESS [[no_unique_address]]
+#elif defined(_MSC_VER)
+#define ASD_NO_UNIQUE_ADDRESS [[msvc::no_unique_address]]
+#else
+#define ASD_NO_UNIQUE_ADDRESS
+#endif
 
 namespace asd
 {
     /*
-    asd::move(T *input, int count, T *output)
+    asd::is_trivially_relocatable<T>
+    tells whether moving a T to a new address and ending the lifetime of the source
+    is equivalent to copying its bytes, in this case the container grows by memcpy/realloc
+    instead of moving its items one by one
+    it defaults to std::is_trivially_copyable, specialize it to opt in your own types
+    */
+    template <typename T>
+    struct is_trivially_relocatable : std::is_trivially_copyable<T>
+    {
+    };
+
+    /*
+    std::unique_ptr with the default deleter only holds a pointer, so it can be relocated as raw bytes
+    */
+    template <typename T>
+    struct is_trivially_relocatable<std::unique_ptr<T>> : std::true_type
+    {
+    };
+
+    template <typename T>
+    inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+    /*
+    asd::move(T *input, std::size_t count, T *output)
     initializes count items in output array from input array by moving ownership
+    trivially copyable items are moved in bulk by memcpy
     */
     template <typename T>
-    void move(T *input, int count, T *output)
+    void move(T *input, std::size_t count, T *output)
     {
-        for (size_t i = 0; i < count; i++)
+        if constexpr (std::is_trivially_copyable_v<T>)
         {
-            new (output + i) T(std::move(input[i]));
+            if (count != 0)
+            {
+                std::memcpy(output, input, count * sizeof(T));
+            }
+        }
+        else
+        {
+            for (std::size_t i = 0; i < count; i++)
+            {
+                new (output + i) T(std::move(input[i]));
+            }
         }
     }
 
     /*
-    asd::copy(T *input, int count, T *output)
+    asd::copy(const T *input, std::size_t count, T *output)
     initializes count items in output array from input array by copying
+    trivially copyable items are copied in bulk by memcpy
+    */
+    template <typename T>
+    void copy(const T *input, std::size_t count, T *output)
+    {
+        if constexpr (std::is_trivially_copyable_v<T>)
+        {
+            if (count != 0)
+            {
+                std::memcpy(output, input, count * sizeof(T));
+            }
+        }
+        else
+        {
+            for (std::size_t i = 0; i < count; i++)
+            {
+                new (output + i) T(input[i]);
+            }
+        }
+    }
+
+    /*
+    asd::relocate(T *input, std::size_t count, T *output)
+    initializes count items in output array from input array by moving ownership,
+    then ends the lifetime of the input items, so input memory can be released directly
+    trivially relocatable items are relocated in bulk by memcpy
     */
     template <typename T>
-    void copy(T *input, int count, T *output)
+    void relocate(T *input, std::size_t count, T *output)
     {
-        for (size_t i = 0; i < count; i++)
+        if constexpr (is_trivially_relocatable_v<T>)
+        {
+            if (count != 0)
+            {
+                std::memcpy(static_cast<void *>(output), static_cast<const void *>(input), count * sizeof(T));
+            }
+        }
+        else
         {
-            new (output + i) T(input[i]);
+            asd::move(input, count, output);
+            if constexpr (!std::is_trivially_destructible_v<T>)
+            {
+                std::destroy(input, input + count);
+            }
         }
     }
 
+    /*
+    growth policies decide the new capacity of a container that has no room for required items
+    each policy provides
+        static std::size_t next_capacity(std::size_t capacity, std::size_t required, std::size_t item_size)
+    the returned capacity is never less than required
+    */
+    namespace growth
+    {
+        /*
+        doubles the capacity, fewest reallocations with up to 50% slack
+        */
+        struct doubling
+        {
+            static constexpr std::size_t next_capacity(std::size_t capacity, std::size_t required, std::size_t) noexcept
+            {
+                return std::max(capacity == 0 ? 1 : capacity * 2, required);
+            }
+        };
+
+        /*
+        grows the capacity by 1.5x, less slack and allows the allocator to reuse freed blocks
+        */
+        struct one_and_half
+        {
+            static constexpr std::size_t next_capacity(std::size_t capacity, std::size_t required, std::size_t) noexcept
+            {
+                return std::max(capacity + std::max<std::size_t>(capacity / 2, 1), required);
+            }
+        };
+
+        /*
+        grows the capacity by fixed Step items, bounded slack and bounded size of every reallocation
+        */
+        template <std::size_t Step>
+        struct fixed_step
+        {
+            static_assert(Step > 0, "growth step must be positive");
+
+            static constexpr std::size_t next_capacity(std::size_t capacity, std::size_t required, std::size_t) noexcept
+            {
+                return std::max(capacity + Step, required);
+            }
+        };
+
+        /*
+        grows the capacity by Base policy then rounds the allocation up to the malloc size class
+        (16 bytes quantum, then 4 classes per power of two), so the slack the allocator would waste
+        anyway becomes usable capacity
+        */
+        template <typename Base = doubling>
+        struct size_class
+        {
+            static constexpr std::size_t round_up(std::size_t bytes) noexcept
+            {
+                if (bytes <= 16)
+                {
+                    return 16;
+                }
+                std::size_t power = 16;
+                while (power * 2 < bytes)
+                {
+                    power *= 2;
+                }
+                std::size_t step = std::max<std::size_t>(power / 4, 16);
+                return (bytes + step - 1) / step * step;
+            }
+
+            static constexpr std::size_t next_capacity(std::size_t capacity, std::size_t required, std::size_t item_size) noexcept
+            {
+                std::size_t new_capacity = Base::next_capacity(capacity, required, item_size);
+                return round_up(new_capacity * item_size) / item_size;
+            }
+        };
+    }
+
+    /*
+    asd::assume_aligned<N>(ptr)
+    tells the compiler ptr is aligned to N bytes, so loops over it need no alignment prologue
+    */
+    template <std::size_t N, typename T>
+    T *assume_aligned(T *ptr) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<T *>(__builtin_assume_aligned(ptr, N));
+#else
+        return ptr;
+#endif
+    }
+
     /*
     provides basic allocator functionality allocate/deallocate
+    it meets the standard Allocator requirements, so it can be used by std containers as well,
+    it is stateless so it takes no space inside the containers
+    the memory is aligned to alignof(T) even for over-aligned types, and at least to malloc alignment
     */
     template <typename T>
     class allocator
     {
     public:
+        using value_type = T;
+        using is_always_equal = std::true_type;
+
+        /*
+        alignment of the allocated memory, see asd::allocator_alignment
+        */
+        static constexpr std::size_t alignment = alignof(T) > alignof(std::max_align_t) ? alignof(T) : alignof(std::max_align_t);
+
         allocator() = default;
-        virtual ~allocator() noexcept {}
+
+        template <typename U>
+        allocator(const allocator<U> &) noexcept
+        {
+        }
 
         /*
         allocates raw memory that can hold n T items, 
@@ -78,33 +279,276 @@ namespace asd
         */
         T *allocate(std::size_t n)
         {
-            T* ptr = static_cast<T *>(std::malloc(n * sizeof(T)));
+            T* ptr;
+            if constexpr (alignof(T) > alignof(std::max_align_t))
+            {
+                // aligned_alloc needs the size to be a multiple of the alignment
+                ptr = static_cast<T *>(std::aligned_alloc(alignment, (n * sizeof(T) + alignment - 1) / alignment * alignment));
+            }
+            else
+            {
+                ptr = static_cast<T *>(std::malloc(n * sizeof(T)));
+            }
             if (ptr == nullptr)
             {
                 throw std::bad_alloc();
             }
+            ASD_INSTRUMENT_ALLOCATE(n * sizeof(T));
             return ptr;
         }
 
+        /*
+        resizes the memory pointed by ptr from old_n to n T items, the old content is kept,
+        the memory may be extended in place, otherwise it is moved as raw bytes
+        so it is valid only for trivially relocatable items
+        ptr may be nullptr with old_n 0, then it allocates
+        realloc doesn't keep over-alignment, so over-aligned items are copied to new aligned memory
+        - thows bad_alloc exception in case of allocation failure, ptr stays valid in this case
+        */
+        T *reallocate(T *ptr, std::size_t old_n, std::size_t n)
+        {
+            if constexpr (alignof(T) > alignof(std::max_align_t))
+            {
+                T *new_ptr = allocate(n);
+                if (ptr != nullptr)
+                {
+                    std::memcpy(static_cast<void *>(new_ptr), static_cast<const void *>(ptr), (old_n < n ? old_n : n) * sizeof(T));
+                    deallocate(ptr, old_n);
+                }
+                return new_ptr;
+            }
+            T *new_ptr = static_cast<T *>(std::realloc(static_cast<void *>(ptr), n * sizeof(T)));
+            if (new_ptr == nullptr)
+            {
+                throw std::bad_alloc();
+            }
+            ASD_INSTRUMENT_REALLOCATE(old_n * sizeof(T), n * sizeof(T));
+            return new_ptr;
+        }
+
         /*
         deallocates the memory pointed by ptr
         */
-        void deallocate(T* ptr) noexcept
+        void deallocate(T* ptr, std::size_t n) noexcept
         {
+            (void)n;
+            ASD_INSTRUMENT_DEALLOCATE(n * sizeof(T));
             free(ptr);
         }
+
+        /*
+        the bytes malloc really reserved for the memory of n items at ptr, malloc rounds sizes up to its size classes
+        where the C library can't tell, it is the n * sizeof(T) bytes asked for
+        */
+        std::size_t usable_size(const T *ptr, std::size_t n) const noexcept
+        {
+            if (ptr == nullptr)
+            {
+                return 0;
+            }
+#if defined(__GLIBC__) || defined(__ANDROID__)
+            (void)n;
+            return malloc_usable_size(const_cast<T *>(ptr));
+#elif defined(__APPLE__)
+            (void)n;
+            return malloc_size(ptr);
+#else
+            return n * sizeof(T);
+#endif
+        }
+    };
+
+    template <typename T, typename U>
+    bool operator==(const allocator<T> &, const allocator<U> &) noexcept
+    {
+        return true;
+    }
+
+    template <typename T, typename U>
+    bool operator!=(const allocator<T> &, const allocator<U> &) noexcept
+    {
+        return false;
+    }
+
+    /*
+    allocates memory aligned to Align bytes, e.g. 64 for cache lines and AVX-512 loads
+    Align is raised to alignof(T) if it is smaller, it must be a power of two
+    it is stateless and meets the standard Allocator requirements
+    */
+    template <typename T, std::size_t Align = 64>
+    class aligned_allocator
+    {
+    public:
+        using value_type = T;
+        using is_always_equal = std::true_type;
+
+        static constexpr std::size_t alignment = Align > alignof(T) ? Align : alignof(T);
+        static_assert((alignment & (alignment - 1)) == 0, "alignment must be a power of two");
+
+        template <typename U>
+        struct rebind
+        {
+            using other = aligned_allocator<U, Align>;
+        };
+
+        aligned_allocator() = default;
+
+        template <typename U>
+        aligned_allocator(const aligned_allocator<U, Align> &) noexcept
+        {
+        }
+
+        /*
+        allocates raw memory that can hold n T items aligned to alignment bytes, the memory is not initialized
+        - thows bad_alloc exception in case of allocation failure
+        */
+        T *allocate(std::size_t n)
+        {
+            T *ptr = static_cast<T *>(::operator new(n * sizeof(T), std::align_val_t(alignment)));
+            ASD_INSTRUMENT_ALLOCATE(n * sizeof(T));
+            return ptr;
+        }
+
+        void deallocate(T *ptr, std::size_t n) noexcept
+        {
+            (void)n;
+            ASD_INSTRUMENT_DEALLOCATE(n * sizeof(T));
+            ::operator delete(ptr, std::align_val_t(alignment));
+        }
+    };
+
+    template <typename T, typename U, std::size_t Align>
+    bool operator==(const aligned_allocator<T, Align> &, const aligned_allocator<U, Align> &) noexcept
+    {
+        return true;
+    }
+
+    template <typename T, typename U, std::size_t Align>
+    bool operator!=(const aligned_allocator<T, Align> &, const aligned_allocator<U, Align> &) noexcept
+    {
+        return false;
+    }
+
+    /*
+    asd::allocator_alignment<Alloc>
+    the alignment every pointer allocated by Alloc is known to have,
+    Alloc::alignment if the allocator tells it, otherwise alignof(value_type)
+    */
+    template <typename Alloc, typename = void>
+    struct allocator_alignment : std::integral_constant<std::size_t, alignof(typename std::allocator_traits<Alloc>::value_type)>
+    {
+    };
+
+    template <typename Alloc>
+    struct allocator_alignment<Alloc, std::void_t<decltype(Alloc::alignment)>> : std::integral_constant<std::size_t, Alloc::alignment>
+    {
+    };
+
+    template <typename Alloc>
+    inline constexpr std::size_t allocator_alignment_v = allocator_alignment<Alloc>::value;
+
+    /*
+    asd::has_reallocate<Alloc>
+    tells whether Alloc provides the non standard reallocate(ptr, old_n, n) extension,
+    asd containers use it to grow trivially relocatable items without copying
+    */
+    template <typename Alloc, typename = void>
+    struct has_reallocate : std::false_type
+    {
+    };
+
+    template <typename Alloc>
+    struct has_reallocate<Alloc, std::void_t<decltype(std::declval<Alloc &>().reallocate(
+                                     std::declval<typename std::allocator_traits<Alloc>::pointer>(), std::size_t{}, std::size_t{}))>>
+        : std::true_type
+    {
+    };
+
+    template <typename Alloc>
+    inline constexpr bool has_reallocate_v = has_reallocate<Alloc>::value;
+
+    /*
+    asd::has_usable_size<Alloc>
+    tells whether Alloc provides the non standard usable_size(ptr, n) extension, the bytes it really
+    reserved for n items at ptr, asd containers use it to report their memory usage
+    */
+    template <typename Alloc, typename = void>
+    struct has_usable_size : std::false_type
+    {
+    };
+
+    template <typename Alloc>
+    struct has_usable_size<Alloc, std::void_t<decltype(std::declval<const Alloc &>().usable_size(
+                                      std::declval<typename std::allocator_traits<Alloc>::pointer>(), std::size_t{}))>>
+        : std::true_type
+    {
+    };
+
+    template <typename Alloc>
+    inline constexpr bool has_usable_size_v = has_usable_size<Alloc>::value;
+
+    /*
+    asd::is_iterator<It> / asd::is_forward_iterator<It>
+    used to tell iterator ranges from (count, value) arguments, and to know the size of a range up front
+    */
+    template <typename It, typename = void>
+    struct is_iterator : std::false_type
+    {
+    };
+
+    template <typename It>
+    struct is_iterator<It, std::void_t<typename std::iterator_traits<It>::iterator_category>> : std::true_type
+    {
+    };
+
+    template <typename It>
+    inline constexpr bool is_iterator_v = is_iterator<It>::value;
+
+    template <typename It, typename = void>
+    struct is_forward_iterator : std::false_type
+    {
+    };
+
+    template <typename It>
+    struct is_forward_iterator<It, std::void_t<typename std::iterator_traits<It>::iterator_category>>
+        : std::is_base_of<std::forward_iterator_tag, typename std::iterator_traits<It>::iterator_category>
+    {
+    };
+
+    template <typename It>
+    inline constexpr bool is_forward_iterator_v = is_forward_iterator<It>::value;
+
+    /*
+    tag of resize(n, asd::default_init), new items are default initialized instead of value initialized
+    */
+    struct default_init_t
+    {
+        explicit default_init_t() = default;
     };
 
+    inline constexpr default_init_t default_init{};
+
     /*
     class asd::vector provides basic functionality of a vector, however some other functionality not implemente yet
+    Alloc is any allocator that meets the standard Allocator requirements, it is used through std::allocator_traits
+    stateless allocators take no space, stateful allocators are propagated on copy, move and swap as their traits tell
+    GrowthPolicy decides how much the capacity grows when the container runs out of room, see asd::growth
+    SizeType is the unsigned type the size and capacity are stored in, a narrower type makes the header smaller
+    and limits max_size(), see asd::compact_vector
+    the class is final and has no virtual functions, so the header is just the pointer, size and capacity
     */
-    template <typename T>
-    class vector
+    template <typename T, typename Alloc = allocator<T>, typename GrowthPolicy = growth::doubling, typename SizeType = std::size_t>
+    class vector final
     {
-        std::size_t m_count; // number of items in the container
-        std::size_t m_capacity; // number of items container can have without need to reallocation 
+        using alloc_traits = std::allocator_traits<Alloc>;
+        static_assert(std::is_same_v<typename alloc_traits::value_type, T>, "allocator value_type must be T");
+        static_assert(std::is_same_v<typename alloc_traits::pointer, T *>, "fancy pointers are not supported");
+        static_assert(std::is_unsigned_v<SizeType> && sizeof(SizeType) <= sizeof(std::size_t), "SizeType must be an unsigned integer no wider than size_t");
+
+        SizeType m_count; // number of items in the container
+        SizeType m_capacity; // number of items container can have without need to reallocation 
         T *m_data_ptr; //pointer to the allocated memory
-        allocator<T> m_allocator; 
+        ASD_NO_UNIQUE_ADDRESS Alloc m_allocator; 
 
         void reset() noexcept
         {
@@ -115,132 +559,579 @@ namespace asd
         
         void init(std::size_t capacity, std::size_t count, T *data_ptr) noexcept
         {
-            m_count = count;
-            m_capacity = capacity;
+            m_count = static_cast<SizeType>(count);
+            m_capacity = static_cast<SizeType>(capacity);
             m_data_ptr = data_ptr;
         }
 
         /*
-        allocate bigger memory,
-        move the container elements to the new memory portion
-        release the old memory
-        then updates capacity and data pointer
+        items are created and destroyed through the allocator, so allocators like std::pmr::polymorphic_allocator
+        can pass themselves to the items, trivially copyable items are copied in bulk by memcpy instead
         */
-        void reallocate()
+        template <typename... Args>
+        void construct(T *ptr, Args &&...args)
         {
-            std::size_t new_capacity = m_capacity == 0 ? 1 : m_capacity * 2;
-            T *new_data_ptr = m_allocator.allocate(new_capacity);
-            asd::move(m_data_ptr, m_count, new_data_ptr);
-            m_allocator.deallocate(m_data_ptr);
-            init(new_capacity, m_count, new_data_ptr);
+            alloc_traits::construct(m_allocator, ptr, std::forward<Args>(args)...);
         }
 
-        void destroy() noexcept
+        /*
+        copy_items, move_items and construct_range destroy the items they built when a constructor throws
+        */
+        void copy_items(const T *input, std::size_t count, T *output)
         {
-            if constexpr (!std::is_trivially_destructible_v<T>)
+            if constexpr (std::is_trivially_copyable_v<T>)
+            {
+                asd::copy(input, count, output);
+            }
+            else
             {
-                std::destroy(m_data_ptr, m_data_ptr + m_count);
+                std::size_t i = 0;
+                try
+                {
+                    for (; i < count; i++)
+                    {
+                        construct(output + i, input[i]);
+                    }
+                }
+                catch (...)
+                {
+                    destroy_items(output, output + i);
+                    throw;
+                }
             }
-            m_allocator.deallocate(m_data_ptr);
         }
-    public:
 
-        /*
-        non-prameterized consructor
-        */
-        vector() noexcept
+        void move_items(T *input, std::size_t count, T *output)
         {
-            reset();
+            if constexpr (std::is_trivially_copyable_v<T>)
+            {
+                asd::move(input, count, output);
+            }
+            else
+            {
+                std::size_t i = 0;
+                try
+                {
+                    for (; i < count; i++)
+                    {
+                        construct(output + i, std::move(input[i]));
+                    }
+                }
+                catch (...)
+                {
+                    destroy_items(output, output + i);
+                    throw;
+                }
+            }
         }
 
-        /*
-        copy consructor
-        */
-        vector(const vector &other)
+        void relocate_items(T *input, std::size_t count, T *output)
         {
-            if (other.size() == 0)
+            if constexpr (is_trivially_relocatable_v<T>)
             {
-                reset();
-                return;
+                asd::relocate(input, count, output);
+            }
+            else
+            {
+                move_items(input, count, output);
+                destroy_items(input, input + count);
             }
-            m_data_ptr = m_allocator.allocate(other.size());
-            asd::copy(other.m_data_ptr, other.size(), m_data_ptr);
-            init(other.size(), other.size(), m_data_ptr);
         }
 
         /*
-        move constructor
-        */
-        vector(vector &&other) noexcept
-        {
-            init(other.m_capacity, other.m_count, other.m_data_ptr);
-            other.reset();
-        }
-        
-        /*
-        copy assignment operator
+        pointers to T are copied by copy_items, so trivially copyable items are copied in bulk by memcpy
         */
-        vector& operator= (const vector& other)
+        template <typename It>
+        static constexpr bool is_item_pointer_v = std::is_pointer_v<It> && std::is_same_v<std::remove_cv_t<std::remove_pointer_t<It>>, T>;
+
+        template <typename It>
+        void construct_range(It first, std::size_t count, T *output)
         {
-            if(m_capacity < other.m_count)
+            if constexpr (is_item_pointer_v<It>)
             {
-                T* new_data_ptr = m_allocator.allocate(other.m_count);
-                destroy();
-                m_data_ptr = new_data_ptr;
+                copy_items(first, count, output);
+            }
+            else
+            {
+                std::size_t i = 0;
+                try
+                {
+                    for (; i < count; i++, ++first)
+                    {
+                        construct(output + i, *first);
+                    }
+                }
+                catch (...)
+                {
+                    destroy_items(output, output + i);
+                    throw;
+                }
             }
-            asd::copy(other.m_data_ptr, other.m_count, m_data_ptr);
-            init(other.size(), other.size(), m_data_ptr);
-            return *this;
         }
 
         /*
-        move assignment operator
+        tells whether ptr points to an item of this container, then it may dangle after reallocation
         */
-        vector& operator= (vector&& other) noexcept
+        bool owns(const T *ptr) const noexcept
         {
-            destroy();
-            init(other.m_capacity, other.m_count, other.m_data_ptr);
-            other.reset();
+            return std::less_equal<const T *>()(m_data_ptr, ptr) && std::less<const T *>()(ptr, m_data_ptr + m_count);
         }
 
         /*
-        destructor
+        tells whether any of args is an item of this container or a part of one
         */
-        virtual ~vector() noexcept
+        template <typename... Args>
+        bool owns_any(const Args &...args) const noexcept
         {
-            destroy();
+            const char *first = reinterpret_cast<const char *>(m_data_ptr);
+            const char *last = reinterpret_cast<const char *>(m_data_ptr + m_count);
+            return (... || (std::less_equal<const char *>()(first, reinterpret_cast<const char *>(std::addressof(args))) &&
+                            std::less<const char *>()(reinterpret_cast<const char *>(std::addressof(args)), last)));
         }
 
         /*
-        add new item
-        it accepts universal reference which binds to both lvalue and rvalue references
-        it raises the bad_alloc exception
-        it doesn't provide special handling/cleaning up so that API clien can do handling as per thier preference
+        appends an item made of args when the container is full, args may refer to an item,
+        which the reallocation frees, so then the new item is made before growing
         */
-        template <class U>
-        void push_back(U &&item)
+        template <typename... Args>
+        void grow_emplace_back(Args &&...args)
         {
-            if (m_count == m_capacity)
+            if (owns_any(args...))
+            {
+                T item(std::forward<Args>(args)...);
+                grow(m_count + 1);
+                construct(m_data_ptr + m_count, std::move(item));
+            }
+            else
             {
-                reallocate();
+                grow(m_count + 1);
+                construct(m_data_ptr + m_count, std::forward<Args>(args)...);
             }
-            new (m_data_ptr + m_count) T(std::forward<U>(item));
             ++m_count;
         }
 
         /*
-        creates new item and from passed arguments and adds it to the container
+        moves the items [pos, size()) n places forward to leave room for n items at pos, it reallocates once
+        if the capacity is not enough, the gap is not initialized and size() is not changed
+        */
+        void open_gap(std::size_t pos, std::size_t n)
+        {
+            if (m_count + n > m_capacity)
+            {
+                if constexpr (!(is_trivially_relocatable_v<T> && has_reallocate_v<Alloc>))
+                {
+                    // relocate both sides of the gap straight into the new memory, so the items move only once
+                    std::size_t new_capacity = next_capacity(m_count + n);
+                    ASD_INSTRUMENT_CONTAINER_REALLOCATE(sizeof(T), m_count, m_capacity, new_capacity);
+                    T *new_data_ptr = allocate_storage(new_capacity);
+                    relocate_items(m_data_ptr, pos, new_data_ptr);
+                    relocate_items(m_data_ptr + pos, m_count - pos, new_data_ptr + pos + n);
+                    deallocate();
+                    init(new_capacity, m_count, new_data_ptr);
+                    return;
+                }
+                grow(m_count + n);
+            }
+            if constexpr (is_trivially_relocatable_v<T>)
+            {
+                if (m_count != pos)
+                {
+                    std::memmove(static_cast<void *>(m_data_ptr + pos + n), static_cast<const void *>(m_data_ptr + pos), (m_count - pos) * sizeof(T));
+                }
+            }
+            else
+            {
+                for (std::size_t i = m_count; i-- > pos;)
+                {
+                    construct(m_data_ptr + i + n, std::move(m_data_ptr[i]));
+                    alloc_traits::destroy(m_allocator, m_data_ptr + i);
+                }
+            }
+        }
+
+        /*
+        moves the trivially relocatable items [first, last) back to pos over items that are already destroyed
+        */
+        void close_gap(std::size_t pos, std::size_t first, std::size_t last) noexcept
+        {
+            if (pos != first && first != last)
+            {
+                std::memmove(static_cast<void *>(m_data_ptr + pos), static_cast<const void *>(m_data_ptr + first), (last - first) * sizeof(T));
+            }
+        }
+
+        void fill_items(std::size_t first, std::size_t last, const T &value)
+        {
+            for (std::size_t i = first; i < last; i++)
+            {
+                construct(m_data_ptr + i, value);
+            }
+        }
+
+        void destroy_items(T *first, T *last) noexcept
+        {
+            if constexpr (!std::is_trivially_destructible_v<T>)
+            {
+                for (; first != last; ++first)
+                {
+                    alloc_traits::destroy(m_allocator, first);
+                }
+            }
+        }
+
+        void destroy_items(std::size_t first = 0) noexcept
+        {
+            destroy_items(m_data_ptr + first, m_data_ptr + m_count);
+        }
+
+        /*
+        the bytes the allocator reserved for capacity items at ptr, see asd::has_usable_size
+        */
+        std::size_t storage_bytes(const T *ptr, std::size_t capacity) const noexcept
+        {
+            if constexpr (has_usable_size_v<Alloc>)
+            {
+                return m_allocator.usable_size(ptr, capacity);
+            }
+            else
+            {
+                return ptr == nullptr ? 0 : capacity * sizeof(T);
+            }
+        }
+
+        /*
+        every buffer the container holds is allocated here or by reallocate, so the memory registry sees it
+        */
+        T *allocate_storage(std::size_t n)
+        {
+            T *ptr = alloc_traits::allocate(m_allocator, n);
+            ASD_INSTRUMENT_STORAGE_ALLOCATE(T, ptr, n * sizeof(T), storage_bytes(ptr, n));
+            return ptr;
+        }
+
+        void deallocate_storage(T *ptr, std::size_t n) noexcept
+        {
+            if (ptr != nullptr)
+            {
+                ASD_INSTRUMENT_STORAGE_DEALLOCATE(ptr);
+                alloc_traits::deallocate(m_allocator, ptr, n);
+            }
+        }
+
+        void deallocate() noexcept
+        {
+            deallocate_storage(m_data_ptr, m_capacity);
+        }
+
+        /*
+        allocate memory of new_capacity items,
+        relocate the container elements to the new memory portion
+        release the old memory
+        then updates capacity and data pointer
+        trivially relocatable items are reallocated by the allocator reallocate extension when it exists,
+        which can extend the memory in place
+        new_capacity must not be less than the number of items
+        */
+        void reallocate(std::size_t new_capacity)
+        {
+            if (new_capacity > max_size())
+            {
+                throw std::length_error("asd::vector capacity exceeds max_size()");
+            }
+            ASD_INSTRUMENT_CONTAINER_REALLOCATE(sizeof(T), m_count, m_capacity, new_capacity);
+            T *new_data_ptr;
+            if constexpr (is_trivially_relocatable_v<T> && has_reallocate_v<Alloc>)
+            {
+                // the old buffer leaves the memory registry before it is freed, another thread may get its address next
+                ASD_INSTRUMENT_STORAGE_DEALLOCATE(m_data_ptr);
+                try
+                {
+                    new_data_ptr = m_allocator.reallocate(m_data_ptr, m_capacity, new_capacity);
+                }
+                catch (...)
+                {
+                    ASD_INSTRUMENT_STORAGE_ALLOCATE(T, m_data_ptr, m_capacity * sizeof(T), storage_bytes(m_data_ptr, m_capacity));
+                    throw;
+                }
+                ASD_INSTRUMENT_STORAGE_ALLOCATE(T, new_data_ptr, new_capacity * sizeof(T), storage_bytes(new_data_ptr, new_capacity));
+            }
+            else
+            {
+                new_data_ptr = allocate_storage(new_capacity);
+                relocate_items(m_data_ptr, m_count, new_data_ptr);
+                deallocate();
+            }
+            init(new_capacity, m_count, new_data_ptr);
+        }
+
+        /*
+        the capacity the growth policy picks for required items, clamped to max_size()
+        */
+        std::size_t next_capacity(std::size_t required) const
+        {
+            if (required > max_size())
+            {
+                throw std::length_error("asd::vector size exceeds max_size()");
+            }
+            return std::min(GrowthPolicy::next_capacity(m_capacity, required, sizeof(T)), max_size());
+        }
+
+        /*
+        makes room for required items, the new capacity is decided by the growth policy
+        */
+        void grow(std::size_t required)
+        {
+            reallocate(next_capacity(required));
+        }
+
+        void destroy() noexcept
+        {
+            destroy_items();
+            deallocate();
+        }
+
+        /*
+        takes the memory of other, other becomes empty
+        */
+        void steal(vector &other) noexcept
+        {
+            init(other.m_capacity, other.m_count, other.m_data_ptr);
+            other.reset();
+        }
+    public:
+        using value_type = T;
+        using allocator_type = Alloc;
+        using growth_policy = GrowthPolicy;
+        using size_type = SizeType;
+        using iterator = T *;
+        using const_iterator = const T *;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+        /*
+        data() and begin() are known to be aligned to this many bytes, see asd::allocator_alignment
+        */
+        static constexpr std::size_t alignment = allocator_alignment_v<Alloc>;
+
+        /*
+        non-prameterized consructor
+        */
+        vector() noexcept(noexcept(Alloc()))
+            : m_allocator()
+        {
+            reset();
+        }
+
+        /*
+        creates an empty container that allocates its memory by alloc
+        */
+        explicit vector(const Alloc &alloc) noexcept
+            : m_allocator(alloc)
+        {
+            reset();
+        }
+
+        /*
+        copy consructor
+        the allocator is copied as its select_on_container_copy_construction tells
+        */
+        vector(const vector &other)
+            : m_allocator(alloc_traits::select_on_container_copy_construction(other.m_allocator))
+        {
+            if (other.size() == 0)
+            {
+                reset();
+                return;
+            }
+            T *data_ptr = allocate_storage(other.size());
+            try
+            {
+                copy_items(other.m_data_ptr, other.size(), data_ptr);
+            }
+            catch (...)
+            {
+                deallocate_storage(data_ptr, other.size());
+                throw;
+            }
+            init(other.size(), other.size(), data_ptr);
+        }
+
+        /*
+        move constructor
+        */
+        vector(vector &&other) noexcept
+            : m_allocator(std::move(other.m_allocator))
+        {
+            steal(other);
+        }
+        
+        /*
+        copy assignment operator
+        the allocator is copied if propagate_on_container_copy_assignment is set
+        if an item copy throws, the old items are kept when new memory was needed, otherwise the container is empty
+        */
+        vector& operator= (const vector& other)
+        {
+            if (this == &other)
+            {
+                return *this;
+            }
+            if constexpr (alloc_traits::propagate_on_container_copy_assignment::value)
+            {
+                if (!alloc_traits::is_always_equal::value && m_allocator != other.m_allocator)
+                {
+                    // memory of the old allocator can't be reused
+                    destroy();
+                    reset();
+                }
+                m_allocator = other.m_allocator;
+            }
+            if(m_capacity < other.m_count)
+            {
+                T* new_data_ptr = allocate_storage(other.m_count);
+                try
+                {
+                    copy_items(other.m_data_ptr, other.m_count, new_data_ptr);
+                }
+                catch (...)
+                {
+                    deallocate_storage(new_data_ptr, other.m_count);
+                    throw;
+                }
+                destroy();
+                init(other.m_count, other.m_count, new_data_ptr);
+            }
+            else
+            {
+                destroy_items();
+                m_count = 0;
+                copy_items(other.m_data_ptr, other.m_count, m_data_ptr);
+                m_count = other.m_count;
+            }
+            return *this;
+        }
+
+        /*
+        move assignment operator
+        the memory of other is taken if the allocator propagates or both allocators are equal,
+        otherwise items are moved one by one into memory from this container allocator
+        */
+        vector& operator= (vector&& other) noexcept(alloc_traits::propagate_on_container_move_assignment::value ||
+                                                    alloc_traits::is_always_equal::value)
+        {
+            if (this == &other)
+            {
+                return *this;
+            }
+            if constexpr (alloc_traits::propagate_on_container_move_assignment::value)
+            {
+                destroy();
+                m_allocator = std::move(other.m_allocator);
+                steal(other);
+            }
+            else
+            {
+                if (alloc_traits::is_always_equal::value || m_allocator == other.m_allocator)
+                {
+                    destroy();
+                    steal(other);
+                    return *this;
+                }
+                destroy_items();
+                m_count = 0;
+                reserve(other.m_count);
+                move_items(other.m_data_ptr, other.m_count, m_data_ptr);
+                m_count = other.m_count;
+                other.destroy_items();
+                other.m_count = 0;
+            }
+            return *this;
+        }
+
+        /*
+        destructor
+        */
+        ~vector() noexcept
+        {
+            destroy();
+        }
+
+        /*
+        exchanges the items of two containers without moving them
+        the allocators are swapped if propagate_on_container_swap is set, otherwise they must be equal
+        */
+        void swap(vector &other) noexcept
+        {
+            if constexpr (alloc_traits::propagate_on_container_swap::value)
+            {
+                std::swap(m_allocator, other.m_allocator);
+            }
+            std::swap(m_count, other.m_count);
+            std::swap(m_capacity, other.m_capacity);
+            std::swap(m_data_ptr, other.m_data_ptr);
+        }
+
+        allocator_type get_allocator() const noexcept
+        {
+            return m_allocator;
+        }
+
+        /*
+        gives up the ownership of the memory and returns it, the container becomes empty
+        read size() and capacity() before releasing, the caller becomes responsible to destroy
+        the items and to deallocate the memory of capacity items by the container allocator
+        */
+        T *release() noexcept
+        {
+            T *data_ptr = m_data_ptr;
+            ASD_INSTRUMENT_STORAGE_DEALLOCATE(data_ptr);
+            reset();
+            return data_ptr;
+        }
+
+        /*
+        takes the ownership of memory allocated by the container allocator for capacity items,
+        its first count items must be initialized, the current items and memory are released first
+        */
+        void adopt(T *data_ptr, std::size_t count, std::size_t capacity) noexcept
+        {
+            destroy();
+            init(capacity, count, data_ptr);
+            ASD_INSTRUMENT_STORAGE_ALLOCATE(T, data_ptr, capacity * sizeof(T), storage_bytes(data_ptr, capacity));
+        }
+
+        /*
+        add new item
+        it accepts universal reference which binds to both lvalue and rvalue references, item may be an item of this container
+        it raises the bad_alloc exception
+        it doesn't provide special handling/cleaning up so that API clien can do handling as per thier preference
+        */
+        template <class U>
+        void push_back(U &&item)
+        {
+            if (m_count == m_capacity)
+            {
+                grow_emplace_back(std::forward<U>(item));
+                return;
+            }
+            construct(m_data_ptr + m_count, std::forward<U>(item));
+            ++m_count;
+        }
+
+        /*
+        creates new item and from passed arguments and adds it to the container, the arguments may refer to its items
         it raises the bad_alloc exception
         it doesn't provide special handling/cleaning up so that API clien can do handling as per thier preference
         */
         template <typename... Args>
-        void emplace_back(Args... args)
+        void emplace_back(Args &&...args)
         {
             if (m_count == m_capacity)
             {
-                reallocate();
+                grow_emplace_back(std::forward<Args>(args)...);
+                return;
             }
-            new (m_data_ptr + m_count) T(std::forward<Args>(args)...);
+            construct(m_data_ptr + m_count, std::forward<Args>(args)...);
             ++m_count;
         }
 
@@ -269,7 +1160,596 @@ namespace asd
         {
             return m_capacity;
         }
+
+        /*
+        bytes the container takes, its header plus what the allocator reserved for the capacity,
+        which is more than capacity() * sizeof(T) when malloc rounds the size up, see asd::has_usable_size
+        */
+        std::size_t memory_usage() const noexcept
+        {
+            return sizeof(*this) + storage_bytes(m_data_ptr, m_capacity);
+        }
+
+        /*
+        bytes of the reserved memory that hold no item, shrink_to_fit gives most of them back
+        */
+        std::size_t slack_bytes() const noexcept
+        {
+            return storage_bytes(m_data_ptr, m_capacity) - m_count * sizeof(T);
+        }
+
+        /*
+        the most items the container can hold, limited by SizeType
+        growing past it raises the length_error exception
+        */
+        static constexpr std::size_t max_size() noexcept
+        {
+            return std::min<std::size_t>(std::numeric_limits<SizeType>::max(),
+                                         static_cast<std::size_t>(std::numeric_limits<std::ptrdiff_t>::max()) / sizeof(T));
+        }
+
+        bool empty() const noexcept
+        {
+            return m_count == 0;
+        }
+
+        /*
+        pointer to the first item, the items are contiguous and aligned to alignment bytes
+        */
+        T *data() noexcept
+        {
+            return asd::assume_aligned<alignment>(m_data_ptr);
+        }
+
+        const T *data() const noexcept
+        {
+            return asd::assume_aligned<alignment>(m_data_ptr);
+        }
+
+        /*
+        iterators are raw pointers, they are contiguous iterators so std algorithms
+        (and their SIMD / parallel implementations) operate on the memory directly
+        they are invalidated by any reallocation
+        */
+        iterator begin() noexcept
+        {
+            return data();
+        }
+
+        const_iterator begin() const noexcept
+        {
+            return data();
+        }
+
+        iterator end() noexcept
+        {
+            return m_data_ptr + m_count;
+        }
+
+        const_iterator end() const noexcept
+        {
+            return m_data_ptr + m_count;
+        }
+
+        const_iterator cbegin() const noexcept
+        {
+            return m_data_ptr;
+        }
+
+        const_iterator cend() const noexcept
+        {
+            return m_data_ptr + m_count;
+        }
+
+        reverse_iterator rbegin() noexcept
+        {
+            return reverse_iterator(end());
+        }
+
+        const_reverse_iterator rbegin() const noexcept
+        {
+            return const_reverse_iterator(end());
+        }
+
+        reverse_iterator rend() noexcept
+        {
+            return reverse_iterator(begin());
+        }
+
+        const_reverse_iterator rend() const noexcept
+        {
+            return const_reverse_iterator(begin());
+        }
+
+        const_reverse_iterator crbegin() const noexcept
+        {
+            return const_reverse_iterator(end());
+        }
+
+        const_reverse_iterator crend() const noexcept
+        {
+            return const_reverse_iterator(begin());
+        }
+
+        /*
+        doesn't check the container is not empty, API client should take care
+        */
+        T &front()
+        {
+            return m_data_ptr[0];
+        }
+
+        const T &front() const
+        {
+            return m_data_ptr[0];
+        }
+
+        /*
+        doesn't check the container is not empty, API client should take care
+        */
+        T &back()
+        {
+            return m_data_ptr[m_count - 1];
+        }
+
+        const T &back() const
+        {
+            return m_data_ptr[m_count - 1];
+        }
+
+        /*
+        adds the items of [first, last) at the end
+        the size of forward ranges is computed first so the container reallocates at most once,
+        pointers to trivially copyable items are copied by a single memcpy
+        the range may refer to items of this container
+        it raises the bad_alloc exception
+        */
+        template <typename InputIt, typename = std::enable_if_t<is_iterator_v<InputIt>>>
+        void append(InputIt first, InputIt last)
+        {
+            if constexpr (is_forward_iterator_v<InputIt>)
+            {
+                std::size_t n = static_cast<std::size_t>(std::distance(first, last));
+                if (m_count + n > m_capacity)
+                {
+                    if constexpr (is_item_pointer_v<InputIt>)
+                    {
+                        if (n != 0 && owns(first))
+                        {
+                            std::size_t offset = static_cast<std::size_t>(first - m_data_ptr);
+                            grow(m_count + n);
+                            first = m_data_ptr + offset;
+                        }
+                        else
+                        {
+                            grow(m_count + n);
+                        }
+                    }
+                    else
+                    {
+                        grow(m_count + n);
+                    }
+                }
+                construct_range(first, n, m_data_ptr + m_count);
+                m_count += n;
+            }
+            else
+            {
+                for (; first != last; ++first)
+                {
+                    emplace_back(*first);
+                }
+            }
+        }
+
+        void append(std::initializer_list<T> items)
+        {
+            append(items.begin(), items.end());
+        }
+
+        /*
+        inserts the items of [first, last) before the item at index pos, pos may be size()
+        forward ranges reallocate at most once and every existing item is moved at most once
+        it raises the bad_alloc exception
+        */
+        template <typename InputIt, typename = std::enable_if_t<is_iterator_v<InputIt>>>
+        void insert(std::size_t pos, InputIt first, InputIt last)
+        {
+            if constexpr (is_forward_iterator_v<InputIt>)
+            {
+                if constexpr (is_item_pointer_v<InputIt>)
+                {
+                    if (first != last && owns(first))
+                    {
+                        // the items of the range move while the gap is opened, insert a copy of them
+                        vector items(m_allocator);
+                        items.append(first, last);
+                        insert(pos, std::make_move_iterator(items.m_data_ptr), std::make_move_iterator(items.m_data_ptr + items.m_count));
+                        return;
+                    }
+                }
+                std::size_t n = static_cast<std::size_t>(std::distance(first, last));
+                if (n == 0)
+                {
+                    return;
+                }
+                open_gap(pos, n);
+                construct_range(first, n, m_data_ptr + pos);
+                m_count += n;
+            }
+            else
+            {
+                std::size_t old_count = m_count;
+                append(first, last);
+                std::rotate(m_data_ptr + pos, m_data_ptr + old_count, m_data_ptr + m_count);
+            }
+        }
+
+        void insert(std::size_t pos, std::initializer_list<T> items)
+        {
+            insert(pos, items.begin(), items.end());
+        }
+
+        /*
+        inserts n copies of value before the item at index pos, pos may be size()
+        it reallocates at most once, value may refer to an item of this container
+        it raises the bad_alloc exception
+        */
+        void insert(std::size_t pos, std::size_t n, const T &value)
+        {
+            if (owns(&value))
+            {
+                T value_copy(value);
+                insert(pos, n, value_copy);
+                return;
+            }
+            if (n == 0)
+            {
+                return;
+            }
+            open_gap(pos, n);
+            fill_items(pos, pos + n, value);
+            m_count += n;
+        }
+
+        /*
+        destroys the last item, the container must not be empty
+        */
+        void pop_back() noexcept
+        {
+            --m_count;
+            destroy_items(m_data_ptr + m_count, m_data_ptr + m_count + 1);
+        }
+
+        /*
+        removes the item at index pos, the items after it move one place back
+        */
+        void erase(std::size_t pos)
+        {
+            erase(pos, pos + 1);
+        }
+
+        /*
+        removes the items [first, last) by index, the items after them move last - first places back
+        trivially relocatable items are moved by a single memmove, others are move assigned
+        */
+        void erase(std::size_t first, std::size_t last)
+        {
+            if (first == last)
+            {
+                return;
+            }
+            if constexpr (is_trivially_relocatable_v<T>)
+            {
+                destroy_items(m_data_ptr + first, m_data_ptr + last);
+                close_gap(first, last, m_count);
+            }
+            else
+            {
+                std::move(m_data_ptr + last, m_data_ptr + m_count, m_data_ptr + first);
+                destroy_items(m_count - (last - first));
+            }
+            m_count -= last - first;
+        }
+
+        /*
+        removes the item at index pos in constant time by moving the last item into its place,
+        so the order of the items is not kept
+        */
+        void swap_erase(std::size_t pos)
+        {
+            std::size_t last = m_count - 1;
+            if constexpr (is_trivially_relocatable_v<T>)
+            {
+                destroy_items(m_data_ptr + pos, m_data_ptr + pos + 1);
+                if (pos != last)
+                {
+                    asd::relocate(m_data_ptr + last, 1, m_data_ptr + pos);
+                }
+            }
+            else
+            {
+                if (pos != last)
+                {
+                    m_data_ptr[pos] = std::move(m_data_ptr[last]);
+                }
+                destroy_items(last);
+            }
+            m_count = static_cast<SizeType>(last);
+        }
+
+        /*
+        removes the items pred is true for in a single pass and keeps the order of the others,
+        pred is called once per item, returns the number of removed items
+        runs of kept trivially relocatable items are moved by memmove, others are move assigned
+        */
+        template <typename Pred>
+        std::size_t erase_if(Pred pred)
+        {
+            std::size_t old_count = m_count;
+            if constexpr (is_trivially_relocatable_v<T>)
+            {
+                std::size_t kept = 0;
+                std::size_t i = 0;
+                try
+                {
+                    while (i < m_count)
+                    {
+                        // [i, run) is a run of kept items, run is removed
+                        std::size_t run = i;
+                        while (run < m_count && !pred(m_data_ptr[run]))
+                        {
+                            ++run;
+                        }
+                        close_gap(kept, i, run);
+                        kept += run - i;
+                        if (run == m_count)
+                        {
+                            break;
+                        }
+                        destroy_items(m_data_ptr + run, m_data_ptr + run + 1);
+                        i = run + 1;
+                    }
+                }
+                catch (...)
+                {
+                    // keep the items pred has not decided about yet
+                    close_gap(kept, i, m_count);
+                    m_count -= static_cast<SizeType>(i - kept);
+                    throw;
+                }
+                m_count = static_cast<SizeType>(kept);
+            }
+            else
+            {
+                T *new_end = std::remove_if(m_data_ptr, m_data_ptr + m_count, pred);
+                std::size_t kept = static_cast<std::size_t>(new_end - m_data_ptr);
+                destroy_items(kept);
+                m_count = static_cast<SizeType>(kept);
+            }
+            return old_count - m_count;
+        }
+
+        /*
+        replaces the items by the items of [first, last)
+        forward ranges allocate at most once and reuse the memory if it is enough
+        it raises the bad_alloc exception
+        */
+        template <typename InputIt, typename = std::enable_if_t<is_iterator_v<InputIt>>>
+        void assign(InputIt first, InputIt last)
+        {
+            if constexpr (is_forward_iterator_v<InputIt>)
+            {
+                if constexpr (is_item_pointer_v<InputIt>)
+                {
+                    if (first != last && owns(first))
+                    {
+                        // the items of the range are destroyed before the new items are copied, assign a copy of them
+                        vector items(m_allocator);
+                        items.append(first, last);
+                        assign(std::make_move_iterator(items.m_data_ptr), std::make_move_iterator(items.m_data_ptr + items.m_count));
+                        return;
+                    }
+                }
+                std::size_t n = static_cast<std::size_t>(std::distance(first, last));
+                destroy_items();
+                m_count = 0;
+                if (n > m_capacity)
+                {
+                    deallocate();
+                    reset();
+                    reallocate(n);
+                }
+                construct_range(first, n, m_data_ptr);
+                m_count = n;
+            }
+            else
+            {
+                destroy_items();
+                m_count = 0;
+                append(first, last);
+            }
+        }
+
+        void assign(std::initializer_list<T> items)
+        {
+            assign(items.begin(), items.end());
+        }
+
+        /*
+        replaces the items by n copies of value, it allocates at most once
+        it raises the bad_alloc exception
+        */
+        void assign(std::size_t n, const T &value)
+        {
+            if (owns(&value))
+            {
+                T value_copy(value);
+                assign(n, value_copy);
+                return;
+            }
+            destroy_items();
+            m_count = 0;
+            if (n > m_capacity)
+            {
+                deallocate();
+                reset();
+                reallocate(n);
+            }
+            fill_items(0, n, value);
+            m_count = n;
+        }
+
+        /*
+        makes the capacity at least n items in a single reallocation, so next n - size() insertions don't reallocate
+        it does nothing if the capacity is already enough
+        it raises the bad_alloc exception
+        */
+        void reserve(std::size_t n)
+        {
+            if (n > m_capacity)
+            {
+                reallocate(n);
+            }
+        }
+
+        /*
+        changes the number of items to n
+        extra items are destroyed, new items are value initialized
+        it raises the bad_alloc exception
+        */
+        void resize(std::size_t n)
+        {
+            if (n > m_capacity)
+            {
+                grow(n);
+            }
+            if (n > m_count)
+            {
+                if constexpr (std::is_trivially_default_constructible_v<T>)
+                {
+                    std::uninitialized_value_construct(m_data_ptr + m_count, m_data_ptr + n);
+                }
+                else
+                {
+                    for (std::size_t i = m_count; i < n; i++)
+                    {
+                        construct(m_data_ptr + i);
+                    }
+                }
+            }
+            else
+            {
+                destroy_items(n);
+            }
+            m_count = n;
+        }
+
+        /*
+        changes the number of items to n
+        extra items are destroyed, new items are copies of value
+        it raises the bad_alloc exception
+        */
+        void resize(std::size_t n, const T &value)
+        {
+            if (n > m_capacity)
+            {
+                // value may refer to an item of this container, keep a copy while reallocating
+                T value_copy(value);
+                grow(n);
+                fill_items(m_count, n, value_copy);
+                m_count = n;
+                return;
+            }
+            if (n > m_count)
+            {
+                fill_items(m_count, n, value);
+            }
+            else
+            {
+                destroy_items(n);
+            }
+            m_count = n;
+        }
+
+        /*
+        changes the number of items to n, new items are left uninitialized (default initialized)
+        so a buffer filled by read() or memcpy right after doesn't pay for zeroing it first
+        only for trivially default constructible and trivially destructible items
+        it raises the bad_alloc exception
+        */
+        void resize_uninitialized(std::size_t n)
+        {
+            static_assert(std::is_trivially_default_constructible_v<T> && std::is_trivially_destructible_v<T>,
+                          "resize_uninitialized needs trivially default constructible and destructible items");
+            if (n > m_capacity)
+            {
+                grow(n);
+            }
+            m_count = n;
+        }
+
+        /*
+        changes the number of items to n, extra items are destroyed and the new items [size(), n)
+        are constructed by init(first, count) in the uninitialized memory at first, not through the allocator,
+        if init throws it must leave none of them constructed
+        so the new items can be constructed elsewhere, e.g. by many threads in asd::parallel::resize
+        it raises the bad_alloc exception
+        */
+        template <typename Init>
+        void resize_with(std::size_t n, Init &&init)
+        {
+            if (n <= m_count)
+            {
+                destroy_items(n);
+                m_count = static_cast<SizeType>(n);
+                return;
+            }
+            if (n > m_capacity)
+            {
+                grow(n);
+            }
+            init(m_data_ptr + m_count, n - m_count);
+            m_count = static_cast<SizeType>(n);
+        }
+
+        /*
+        same as resize_uninitialized(n)
+        */
+        void resize(std::size_t n, default_init_t)
+        {
+            resize_uninitialized(n);
+        }
+
+        /*
+        releases the unused capacity, the memory is released completely if the container is empty
+        it raises the bad_alloc exception
+        */
+        void shrink_to_fit()
+        {
+            if (m_capacity == m_count)
+            {
+                return;
+            }
+            if (m_count == 0)
+            {
+                deallocate();
+                reset();
+                return;
+            }
+            reallocate(m_count);
+        }
     };
+
+    /*
+    asd::vector with 32-bit size and capacity, the header is 16 bytes instead of 24 on 64-bit targets
+    it holds at most 2^32 - 1 items, growing past it raises the length_error exception
+    */
+    template <typename T, typename Alloc = allocator<T>, typename GrowthPolicy = growth::doubling>
+    using compact_vector = vector<T, Alloc, GrowthPolicy, std::uint32_t>;
+
+    static_assert(sizeof(vector<int>) == sizeof(int *) + 2 * sizeof(std::size_t), "asd::vector header must be a pointer, size and capacity");
+    static_assert(sizeof(compact_vector<int>) == sizeof(int *) + 2 * sizeof(std::uint32_t), "asd::compact_vector header must be a pointer and two 32-bit counts");
 }
 #endif //ifndef ASD_VECTOR_2023
 
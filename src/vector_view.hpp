@@ -0,0 +1,430 @@
+/*
+ * Copyright (C) 2023 Sofyan Gaber <sofyanhalaby@gmail.com>
+ *
+ * This code is for demonstration and educational purposes. It
+ * implements non owning views over the items of a vector.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ASD_VECTOR_VIEW_2023
+#define ASD_VECTOR_VIEW_2023
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include "vector.hpp"
+
+namespace asd
+{
+    template <typename T>
+    class strided_view;
+
+    /*
+    class asd::vector_view<T> refers to n contiguous items owned by someone else, copying it copies two words
+    it converts implicitly from asd::vector and any container with data() and size() (lvalues only, so a view
+    of a temporary doesn't compile), vector_view<const T> is the read only view
+    it has data() and size() so the asd::simd kernels and asd::parallel algorithms take it like a vector,
+    a view is invalidated by any reallocation of the items it refers to
+    */
+    template <typename T>
+    class vector_view
+    {
+        T *m_data_ptr;
+        std::size_t m_count;
+
+        template <typename Container>
+        using container_data_t = decltype(std::declval<Container &>().data());
+
+        template <typename Container, typename = void>
+        struct is_compatible : std::false_type
+        {
+        };
+
+        template <typename Container>
+        struct is_compatible<Container, std::void_t<container_data_t<Container>, decltype(std::declval<Container &>().size())>>
+            : std::bool_constant<std::is_pointer_v<container_data_t<Container>> &&
+                                 std::is_convertible_v<std::remove_pointer_t<container_data_t<Container>> (*)[], T (*)[]>>
+        {
+        };
+
+    public:
+        using value_type = std::remove_cv_t<T>;
+        using element_type = T;
+        using iterator = T *;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+
+        static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+        constexpr vector_view() noexcept
+            : m_data_ptr(nullptr), m_count(0)
+        {
+        }
+
+        constexpr vector_view(T *data_ptr, std::size_t count) noexcept
+            : m_data_ptr(data_ptr), m_count(count)
+        {
+        }
+
+        /*
+        views all items of items
+        */
+        template <typename Container, typename = std::enable_if_t<!std::is_same_v<std::remove_cv_t<Container>, vector_view> && is_compatible<Container>::value>>
+        constexpr vector_view(Container &items) noexcept
+            : m_data_ptr(items.data()), m_count(static_cast<std::size_t>(items.size()))
+        {
+        }
+
+        /*
+        vector_view<U> converts to vector_view<const U>, temporaries included
+        */
+        template <typename U, typename = std::enable_if_t<std::is_convertible_v<U (*)[], T (*)[]> && !std::is_same_v<U, T>>>
+        constexpr vector_view(const vector_view<U> &other) noexcept
+            : m_data_ptr(other.data()), m_count(other.size())
+        {
+        }
+
+        constexpr T *data() const noexcept
+        {
+            return m_data_ptr;
+        }
+
+        constexpr std::size_t size() const noexcept
+        {
+            return m_count;
+        }
+
+        constexpr std::size_t size_bytes() const noexcept
+        {
+            return m_count * sizeof(T);
+        }
+
+        constexpr bool empty() const noexcept
+        {
+            return m_count == 0;
+        }
+
+        /*
+        doesn't provide boundary checks to give faster access, API client should take care
+        */
+        constexpr T &operator[](std::size_t idx) const
+        {
+            return m_data_ptr[idx];
+        }
+
+        constexpr T &front() const
+        {
+            return m_data_ptr[0];
+        }
+
+        constexpr T &back() const
+        {
+            return m_data_ptr[m_count - 1];
+        }
+
+        constexpr iterator begin() const noexcept
+        {
+            return m_data_ptr;
+        }
+
+        constexpr iterator end() const noexcept
+        {
+            return m_data_ptr + m_count;
+        }
+
+        reverse_iterator rbegin() const noexcept
+        {
+            return reverse_iterator(end());
+        }
+
+        reverse_iterator rend() const noexcept
+        {
+            return reverse_iterator(begin());
+        }
+
+        /*
+        the count items from offset, or the items from offset to the end if count is npos or too large
+        offset must not be larger than size()
+        */
+        constexpr vector_view subview(std::size_t offset, std::size_t count = npos) const noexcept
+        {
+            return vector_view(m_data_ptr + offset, count > m_count - offset ? m_count - offset : count);
+        }
+
+        /*
+        the first count items, count must not be larger than size()
+        */
+        constexpr vector_view first(std::size_t count) const noexcept
+        {
+            return vector_view(m_data_ptr, count);
+        }
+
+        /*
+        the last count items, count must not be larger than size()
+        */
+        constexpr vector_view last(std::size_t count) const noexcept
+        {
+            return vector_view(m_data_ptr + (m_count - count), count);
+        }
+
+        /*
+        every step-th item starting at the first one, e.g. a column of a row major matrix is
+        matrix.subview(column).strided(columns)
+        */
+        constexpr strided_view<T> strided(std::size_t step) const noexcept
+        {
+            return strided_view<T>(m_data_ptr, m_count == 0 ? 0 : (m_count - 1) / step + 1, step);
+        }
+    };
+
+    template <typename Container>
+    vector_view(Container &) -> vector_view<std::remove_pointer_t<decltype(std::declval<Container &>().data())>>;
+
+    /*
+    class asd::strided_view<T> refers to size() items that are stride() items apart in memory, such as
+    a column of a row major matrix or one field of interleaved records
+    the items are not contiguous, so it has no data() and the contiguous asd::simd kernels don't take it,
+    asd::parallel::for_each and asd::parallel::reduce do
+    */
+    template <typename T>
+    class strided_view
+    {
+        T *m_data_ptr;
+        std::size_t m_count;
+        std::size_t m_stride;
+
+    public:
+        using value_type = std::remove_cv_t<T>;
+        using element_type = T;
+
+        /*
+        random access iterator stepping stride items at a time, it keeps an index
+        so end() doesn't point past the memory
+        */
+        class iterator
+        {
+            T *m_data_ptr;
+            std::size_t m_stride;
+            std::ptrdiff_t m_index;
+
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = std::remove_cv_t<T>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = T *;
+            using reference = T &;
+
+            iterator() noexcept
+                : m_data_ptr(nullptr), m_stride(1), m_index(0)
+            {
+            }
+
+            iterator(T *data_ptr, std::size_t stride, std::ptrdiff_t index) noexcept
+                : m_data_ptr(data_ptr), m_stride(stride), m_index(index)
+            {
+            }
+
+            reference operator*() const noexcept
+            {
+                return m_data_ptr[static_cast<std::size_t>(m_index) * m_stride];
+            }
+
+            pointer operator->() const noexcept
+            {
+                return &**this;
+            }
+
+            reference operator[](difference_type n) const noexcept
+            {
+                return *(*this + n);
+            }
+
+            iterator &operator++() noexcept
+            {
+                ++m_index;
+                return *this;
+            }
+
+            iterator operator++(int) noexcept
+            {
+                iterator previous = *this;
+                ++m_index;
+                return previous;
+            }
+
+            iterator &operator--() noexcept
+            {
+                --m_index;
+                return *this;
+            }
+
+            iterator operator--(int) noexcept
+            {
+                iterator previous = *this;
+                --m_index;
+                return previous;
+            }
+
+            iterator &operator+=(difference_type n) noexcept
+            {
+                m_index += n;
+                return *this;
+            }
+
+            iterator &operator-=(difference_type n) noexcept
+            {
+                m_index -= n;
+                return *this;
+            }
+
+            friend iterator operator+(iterator it, difference_type n) noexcept
+            {
+                return it += n;
+            }
+
+            friend iterator operator+(difference_type n, iterator it) noexcept
+            {
+                return it += n;
+            }
+
+            friend iterator operator-(iterator it, difference_type n) noexcept
+            {
+                return it -= n;
+            }
+
+            friend difference_type operator-(const iterator &lhs, const iterator &rhs) noexcept
+            {
+                return lhs.m_index - rhs.m_index;
+            }
+
+            friend bool operator==(const iterator &lhs, const iterator &rhs) noexcept
+            {
+                return lhs.m_index == rhs.m_index;
+            }
+
+            friend bool operator!=(const iterator &lhs, const iterator &rhs) noexcept
+            {
+                return lhs.m_index != rhs.m_index;
+            }
+
+            friend bool operator<(const iterator &lhs, const iterator &rhs) noexcept
+            {
+                return lhs.m_index < rhs.m_index;
+            }
+
+            friend bool operator>(const iterator &lhs, const iterator &rhs) noexcept
+            {
+                return lhs.m_index > rhs.m_index;
+            }
+
+            friend bool operator<=(const iterator &lhs, const iterator &rhs) noexcept
+            {
+                return lhs.m_index <= rhs.m_index;
+            }
+
+            friend bool operator>=(const iterator &lhs, const iterator &rhs) noexcept
+            {
+                return lhs.m_index >= rhs.m_index;
+            }
+        };
+
+        constexpr strided_view() noexcept
+            : m_data_ptr(nullptr), m_count(0), m_stride(1)
+        {
+        }
+
+        /*
+        count items, the first at first and each next one stride items after the previous
+        */
+        constexpr strided_view(T *first, std::size_t count, std::size_t stride) noexcept
+            : m_data_ptr(first), m_count(count), m_stride(stride)
+        {
+        }
+
+        /*
+        strided_view<U> converts to strided_view<const U>
+        */
+        template <typename U, typename = std::enable_if_t<std::is_convertible_v<U (*)[], T (*)[]> && !std::is_same_v<U, T>>>
+        constexpr strided_view(const strided_view<U> &other) noexcept
+            : m_data_ptr(other.size() == 0 ? nullptr : &other.front()), m_count(other.size()), m_stride(other.stride())
+        {
+        }
+
+        constexpr std::size_t size() const noexcept
+        {
+            return m_count;
+        }
+
+        constexpr std::size_t stride() const noexcept
+        {
+            return m_stride;
+        }
+
+        constexpr bool empty() const noexcept
+        {
+            return m_count == 0;
+        }
+
+        /*
+        doesn't provide boundary checks to give faster access, API client should take care
+        */
+        constexpr T &operator[](std::size_t idx) const
+        {
+            return m_data_ptr[idx * m_stride];
+        }
+
+        constexpr T &front() const
+        {
+            return m_data_ptr[0];
+        }
+
+        constexpr T &back() const
+        {
+            return m_data_ptr[(m_count - 1) * m_stride];
+        }
+
+        iterator begin() const noexcept
+        {
+            return iterator(m_data_ptr, m_stride, 0);
+        }
+
+        iterator end() const noexcept
+        {
+            return iterator(m_data_ptr, m_stride, static_cast<std::ptrdiff_t>(m_count));
+        }
+
+        /*
+        the count items from offset, or the items from offset to the end if count is npos or too large
+        offset must not be larger than size()
+        */
+        constexpr strided_view subview(std::size_t offset, std::size_t count = vector_view<T>::npos) const noexcept
+        {
+            return strided_view(m_data_ptr + offset * m_stride, count > m_count - offset ? m_count - offset : count, m_stride);
+        }
+
+        /*
+        every step-th item of this view
+        */
+        constexpr strided_view strided(std::size_t step) const noexcept
+        {
+            return strided_view(m_data_ptr, m_count == 0 ? 0 : (m_count - 1) / step + 1, m_stride * step);
+        }
+    };
+}
+#endif //ifndef ASD_VECTOR_VIEW_2023
@@ -0,0 +1,82 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <type_traits>
+#include <assert.h>
+#include "vector.hpp"
+#include "vector_view.hpp"
+#include "simd.hpp"
+#include "parallel.hpp"
+
+// takes part of a vector without copying it
+float sum_of(asd::vector_view<const float> items)
+{
+    return std::accumulate(items.begin(), items.end(), 0.0f);
+}
+
+int main()
+{
+    // Test views convert from vectors and slice without copying
+    asd::vector<float> myVec1;
+    for (int i = 0; i < 100; ++i)
+    {
+        myVec1.push_back(static_cast<float>(i));
+    }
+    asd::vector_view<float> view1 = myVec1;
+    assert(view1.data() == myVec1.data() && view1.size() == 100 && view1.size_bytes() == 400);
+    assert(sum_of(myVec1) == 4950.0f && sum_of(view1) == 4950.0f);
+    asd::vector_view<float> view2 = view1.subview(10, 20);
+    assert(view2.size() == 20 && view2.front() == 10.0f && view2.back() == 29.0f && sum_of(view2) == 390.0f);
+    assert(view1.subview(90).size() == 10 && view1.subview(90, 1000).back() == 99.0f && view1.subview(100).empty());
+    assert(view1.first(3)[2] == 2.0f && view1.last(3)[0] == 97.0f && *view1.rbegin() == 99.0f);
+    view2[0] = -1.0f;
+    assert(myVec1[10] == -1.0f);
+    const asd::vector<float> &constVec = myVec1;
+    asd::vector_view view3(constVec);
+    static_assert(std::is_same_v<decltype(view3), asd::vector_view<const float>>);
+    static_assert(!std::is_convertible_v<asd::vector_view<const float>, asd::vector_view<float>>);
+    static_assert(!std::is_constructible_v<asd::vector_view<float>, asd::vector<float> &&>);
+    static_assert(!std::is_constructible_v<asd::vector_view<float>, asd::vector<int> &>);
+    std::vector<std::string> stdVec1{"a", "b", "c"};
+    asd::vector_view<std::string> view4 = stdVec1;
+    assert(view4.subview(1)[1] == "c");
+
+    // Test strided views step over the items, e.g. a column of a matrix
+    asd::vector<int> matrix;
+    for (int i = 0; i < 12; ++i)
+    {
+        matrix.push_back(i);
+    }
+    asd::strided_view<int> column1 = asd::vector_view<int>(matrix).subview(1).strided(4);
+    assert(column1.size() == 3 && column1[0] == 1 && column1[1] == 5 && column1.back() == 9 && column1.stride() == 4);
+    assert(std::accumulate(column1.begin(), column1.end(), 0) == 15 && column1.end() - column1.begin() == 3);
+    std::reverse(column1.begin(), column1.end());
+    assert(matrix[1] == 9 && matrix[9] == 1 && matrix[5] == 5);
+    asd::strided_view<const int> every8 = asd::vector_view<int>(matrix).strided(2).strided(4);
+    assert(every8.size() == 2 && every8[1] == 8 && every8.subview(1).front() == 8);
+    assert(asd::vector_view<int>(matrix).strided(5).size() == 3 && asd::vector_view<int>().strided(3).empty());
+
+    // Test the simd and parallel modules work on windows of one buffer
+    asd::vector<float> myVec2;
+    myVec2.resize(1 << 20, 1.0f);
+    asd::vector_view<float> all = myVec2;
+    assert(asd::simd::sum(all.subview(0, 1000)) == 1000.0f);
+    asd::simd::axpy(2.0f, asd::vector_view<const float>(all.first(10)), all.subview(10, 10));
+    assert(myVec2[10] == 3.0f && myVec2[19] == 3.0f && myVec2[20] == 1.0f);
+    asd::simd::clamp(all.subview(10, 5), 0.0f, 2.0f);
+    assert(myVec2[14] == 2.0f && myVec2[15] == 3.0f);
+    asd::parallel::thread_pool pool(4);
+    asd::parallel::for_each(pool, all.subview(1 << 19), [](float &item) { item = 5.0f; });
+    assert(myVec2[(1 << 19) - 1] == 1.0f && myVec2[1 << 19] == 5.0f && myVec2.back() == 5.0f);
+    asd::parallel::sort(pool, all.first(100), std::greater<>());
+    assert(myVec2[0] == 3.0f && myVec2[99] == 1.0f);
+    asd::parallel::for_each(pool, all.strided(2), [](float &item) { item = 0.0f; });
+    assert(myVec2[0] == 0.0f && myVec2[1] == 3.0f && myVec2[(1 << 20) - 2] == 0.0f && myVec2.back() == 5.0f);
+    assert(asd::parallel::reduce(pool, all.subview(1).strided(2), 0.0) == asd::parallel::reduce(pool, all, 0.0));
+
+    std::cout << "vector_view examples done" << std::endl;
+
+    return 0;
+}